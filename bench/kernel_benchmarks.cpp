@@ -0,0 +1,368 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "instance.h"
+#include "util.h"
+#include "rectangle_enumerator.h"
+#include "baserect_graph.h"
+#include "runtime_environment.h"
+#include "greedy_set_cover_algorithm.h"
+#include "cover_trimmer.h"
+#include "cover_joiner_full.h"
+#include "polygon_generator.h"
+
+using namespace cover;
+
+namespace {
+    /**
+     * Exposes the protected cut picking of the rectangle enumerator, so the cuts can be computed once up front.
+     */
+    struct Cut_picker : Rectangle_enumerator {
+        using Rectangle_enumerator::pick_cuts;
+    };
+
+    /**
+     * Exposes the protected trimming kernels of the cover trimmer, so they can be run without the postprocessor
+     * chain around them.
+     */
+    struct Trim_kernels : Cover_trimmer {
+        using Cover_trimmer::trim_top;
+        using Cover_trimmer::trim_left;
+        using Cover_trimmer::trim_bottom;
+        using Cover_trimmer::trim_right;
+        using Cover_postprocessor::get_or_calculate_br_coverage;
+    };
+
+    /**
+     * Algorithm returning a precomputed cover, used as the start of postprocessor chains.
+     */
+    class Fixed_cover : public Algorithm {
+        const Cover &cover;
+
+    protected:
+        [[nodiscard]] Cover calculate_cover(const Polygon_with_holes &polygon, const Problem_instance::Costs &costs,
+                                            Runtime_environment *env) override {
+            return cover;
+        }
+
+    public:
+        explicit Fixed_cover(const Cover &cover) : cover(cover) {}
+    };
+
+    const Problem_instance::Costs COSTS{5, 1};
+
+    /**
+     * A polygon together with everything the kernels take as input, computed once on first use.
+     */
+    struct Polygon_data {
+        Polygon_with_holes polygon;
+        std::vector<Ray> rays;
+        std::vector<Segment> cuts;
+        std::vector<Rectangle> base_rectangles;
+        BaseRectGraph graph;
+        Cover_provider::Cover cover;
+
+        explicit Polygon_data(Polygon_with_holes polygon_to_prepare) : polygon(std::move(polygon_to_prepare)) {
+            const Util::Edge_index edge_index{polygon};
+            for (const auto &entry: Util::find_concave_vertices(polygon)) {
+                for (const auto &direction: entry.second) {
+                    rays.emplace_back(entry.first, direction);
+                }
+                Cut_picker::pick_cuts(edge_index, entry, cuts);
+            }
+            base_rectangles = Util::decompose(polygon, cuts);
+            graph.build(base_rectangles);
+
+            Runtime_environment env;
+            env.base_rectangles = base_rectangles;
+            env.graph = graph;
+            cover = Greedy_set_cover_algorithm{}.get_cover_for(polygon, COSTS, &env);
+        }
+    };
+
+    /**
+     * A named polygon the kernels are run on, either synthetic or read from one of the checked-in instances.
+     */
+    class Polygon_source {
+        std::function<Polygon_with_holes()> load;
+        std::optional<Polygon_data> data;
+
+    public:
+        const std::string name;
+
+        Polygon_source(std::string name, std::function<Polygon_with_holes()> load)
+                : load(std::move(load)), name(std::move(name)) {}
+
+        const Polygon_data &get() {
+            if (!data.has_value()) {
+                data.emplace(load());
+            }
+            return *data;
+        }
+    };
+
+    /**
+     * Returns the polygon with the most vertices.
+     */
+    Polygon_with_holes largest_polygon(const MultiPolygon &multi_polygon) {
+        const auto vertex_count{[](const Polygon_with_holes &polygon) {
+            auto count{polygon.outer_boundary().size()};
+            for (const auto &hole: polygon.holes()) {
+                count += hole.size();
+            }
+            return count;
+        }};
+        return *std::max_element(multi_polygon.begin(), multi_polygon.end(),
+                                 [&](const auto &a, const auto &b) { return vertex_count(a) < vertex_count(b); });
+    }
+
+    std::vector<std::shared_ptr<Polygon_source>> create_sources() {
+        std::vector<std::shared_ptr<Polygon_source>> sources{};
+        // generated polygons of increasing size and hole count, see Polygon_generator::parse for the format
+        const std::vector<std::string> specifications{
+                "comb:size=64", "comb:size=64,holes=16", "comb:size=256", "comb:size=256,holes=64",
+                "comb:size=512,holes=128",
+                "staircase:size=16", "staircase:size=64",
+                "orthogonal:size=1024", "orthogonal:size=4096,holes=64", "orthogonal:size=4096,aspect=4",
+                "raster:size=64", "raster:size=128,density=0.55",
+        };
+        for (const auto &specification: specifications) {
+            const auto parameters{Polygon_generator::parse(specification)};
+            auto name{specification};
+            std::replace(name.begin(), name.end(), ':', '_');
+            std::replace(name.begin(), name.end(), ',', '_');
+            sources.push_back(std::make_shared<Polygon_source>(name, [parameters] {
+                return largest_polygon(Polygon_generator::generate(parameters));
+            }));
+        }
+
+        std::vector<fs::path> instances{};
+        for (const auto &entry: fs::directory_iterator(COVER_BENCHMARK_DATA_DIR)) {
+            if (entry.path().extension() == ".wkt") {
+                instances.push_back(entry.path());
+            }
+        }
+        std::sort(instances.begin(), instances.end());
+        for (const auto &path: instances) {
+            sources.push_back(std::make_shared<Polygon_source>(path.stem().string(), [path] {
+                const Problem_instance instance{path, COSTS.creation_cost, COSTS.area_cost};
+                return largest_polygon(instance.get_multi_polygon());
+            }));
+        }
+        return sources;
+    }
+
+    void closest_intersection_linear(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        for (auto _: state) {
+            for (const auto &ray: data.rays) {
+                benchmark::DoNotOptimize(Util::get_closest_intersection(ray, data.polygon));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.rays.size()));
+    }
+
+    void closest_intersection_index(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        const Util::Edge_index edge_index{data.polygon};
+        for (auto _: state) {
+            for (const auto &ray: data.rays) {
+                benchmark::DoNotOptimize(edge_index.get_closest_intersection(ray));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.rays.size()));
+    }
+
+    void edge_index_build(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        for (auto _: state) {
+            const Util::Edge_index edge_index{data.polygon};
+            benchmark::DoNotOptimize(&edge_index);
+        }
+    }
+
+    void create_arrangement(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        for (auto _: state) {
+            benchmark::DoNotOptimize(Util::create_arrangement(data.polygon, data.cuts));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.cuts.size()));
+    }
+
+    void parse_rectangles(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        const auto arrangement{Util::create_arrangement(data.polygon, data.cuts)};
+        for (auto _: state) {
+            benchmark::DoNotOptimize(Util::parse_rectangles(arrangement, data.polygon));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.base_rectangles.size()));
+    }
+
+    void sweep_rectangles(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        for (auto _: state) {
+            benchmark::DoNotOptimize(Util::sweep_rectangles(data.polygon, data.cuts));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.base_rectangles.size()));
+    }
+
+    void graph_build(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        for (auto _: state) {
+            BaseRectGraph graph;
+            graph.build(data.base_rectangles);
+            benchmark::DoNotOptimize(graph.getNodes().data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.base_rectangles.size()));
+    }
+
+    void get_all_rectangles(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        size_t rectangles{0};
+        for (auto _: state) {
+            const auto all_rectangles{data.graph.get_all_rectangles()};
+            rectangles = all_rectangles.size();
+            benchmark::DoNotOptimize(all_rectangles.data());
+        }
+        state.counters["rectangles"] = static_cast<double>(rectangles);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rectangles));
+    }
+
+    void super_rectangle_traversal(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        size_t visited{0};
+        for (auto _: state) {
+            visited = 0;
+            data.graph.for_each_rectangle([&](BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left) {
+                for (auto it = data.graph.begin(top_right, bottom_left); it != data.graph.end(); ++it) {
+                    visited++;
+                }
+            });
+            benchmark::DoNotOptimize(visited);
+        }
+        state.counters["nodes_visited"] = static_cast<double>(visited);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * visited));
+    }
+
+    void greedy(benchmark::State &state, Polygon_source &source, bool lazy, size_t threads = 1) {
+        const auto &data{source.get()};
+        Runtime_environment env;
+        env.base_rectangles = data.base_rectangles;
+        env.graph = data.graph;
+        Greedy_set_cover_algorithm algorithm{lazy, threads};
+        for (auto _: state) {
+            env.clear_cover_data();
+            benchmark::DoNotOptimize(algorithm.get_cover_for(data.polygon, COSTS, &env));
+        }
+        state.counters["cover_size"] = static_cast<double>(data.cover.size());
+    }
+
+    void trim(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        Runtime_environment env;
+        env.base_rectangles = data.base_rectangles;
+        env.graph = data.graph;
+        const auto coverage{Trim_kernels::get_or_calculate_br_coverage(data.polygon, data.cover, &env)};
+        const auto &nodes{env.graph.getNodes()};
+        for (auto _: state) {
+            state.PauseTiming();
+            auto cover{data.cover};
+            auto br_coverage{coverage};
+            state.ResumeTiming();
+            for (auto &rectangle: cover) {
+                Trim_kernels::trim_top(rectangle, nodes, env.graph, br_coverage);
+                Trim_kernels::trim_bottom(rectangle, nodes, env.graph, br_coverage);
+                Trim_kernels::trim_right(rectangle, nodes, env.graph, br_coverage);
+                Trim_kernels::trim_left(rectangle, nodes, env.graph, br_coverage);
+            }
+            benchmark::DoNotOptimize(cover.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.cover.size()));
+    }
+
+    void join_full(benchmark::State &state, Polygon_source &source) {
+        const auto &data{source.get()};
+        Runtime_environment env;
+        env.base_rectangles = data.base_rectangles;
+        env.graph = data.graph;
+        Cover_joiner_full joiner{std::unique_ptr<Algorithm>(std::make_unique<Fixed_cover>(data.cover))};
+        for (auto _: state) {
+            env.clear_cover_data();
+            benchmark::DoNotOptimize(joiner.get_cover_for(data.polygon, COSTS, &env));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * data.cover.size()));
+    }
+}
+
+int main(int argc, char **argv) {
+    using Kernel = void (*)(benchmark::State &, Polygon_source &);
+    const std::vector<std::pair<std::string, Kernel>> kernels{
+            {"closest_intersection_linear", closest_intersection_linear},
+            {"closest_intersection_index", closest_intersection_index},
+            {"edge_index_build", edge_index_build},
+            {"create_arrangement", create_arrangement},
+            {"parse_rectangles", parse_rectangles},
+            {"sweep_rectangles", sweep_rectangles},
+            {"graph_build", graph_build},
+            {"get_all_rectangles", get_all_rectangles},
+            {"super_rectangle_traversal", super_rectangle_traversal},
+            {"greedy", [](benchmark::State &state, Polygon_source &source) { greedy(state, source, false); }},
+            {"greedy_lazy", [](benchmark::State &state, Polygon_source &source) { greedy(state, source, true); }},
+            {"greedy_parallel", [](benchmark::State &state, Polygon_source &source) {
+                greedy(state, source, false, std::max(1u, std::thread::hardware_concurrency()));
+            }},
+            {"trim", trim},
+            {"join_full", join_full},
+    };
+
+    // the sources are shared by all kernels, so every polygon is only prepared once and only if it is used
+    const auto sources{create_sources()};
+    for (const auto &[kernel_name, kernel]: kernels) {
+        for (const auto &source: sources) {
+            benchmark::RegisterBenchmark((kernel_name + "/" + source->name).c_str(),
+                                         [kernel = kernel, source](benchmark::State &state) {
+                                             kernel(state, *source);
+                                         })->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -26,6 +26,8 @@
 #ifndef COVERING_CGAL_CLASSES_H
 #define COVERING_CGAL_CLASSES_H
 
+#include <cstdint>
+
 #include <CGAL/Cartesian.h>
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_with_holes_2.h>
@@ -39,6 +41,16 @@
 
 namespace cover {
     using NumType = double;
+
+    /**
+     * Type of the coordinates Rectangle stores and compares. Configuring with -DCOVER_INTEGER_COORDINATES=ON stores
+     * them as 64 bit integers, which requires integer input coordinates. CGAL points always use NumType.
+     */
+#ifdef COVER_INTEGER_COORDINATES
+    using Coordinate = int64_t;
+#else
+    using Coordinate = NumType;
+#endif
     using Kernel = CGAL::Exact_predicates_inexact_constructions_kernel;
 
     using Point = CGAL::Point_2<Kernel>;
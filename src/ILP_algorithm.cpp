@@ -26,12 +26,41 @@
 #ifdef GUROBI_AVAILABLE  // do not compile this if gurobi is not available
 
 #include "ILP_algorithm.h"
+#include "candidate_filter.h"
+#include "greedy_set_cover_algorithm.h"
+#include "profile.h"
+#include "strip_algorithm.h"
+
+#include <algorithm>
+#include <climits>
+#include <memory>
 
 namespace cover {
         using clock = std::chrono::high_resolution_clock;
         using nanos = std::chrono::nanoseconds;
         using millis = std::chrono::milliseconds;
 
+    namespace {
+        // columns with a reduced cost above this are not considered improving, which avoids cycling on round-off
+        constexpr double REDUCED_COST_TOLERANCE{1e-6};
+        // lower bound on the number of columns added per pricing round, small polygons have few constraints
+        constexpr size_t MIN_COLUMNS_PER_ROUND{64};
+
+        uint64_t candidate_key(BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left, size_t node_count) {
+            return static_cast<uint64_t>(top_right) * node_count + bottom_left;
+        }
+
+        Set<uint64_t> get_candidate_keys(const BaseRectGraph &graph, const std::vector<Rectangle> &cover) {
+            const auto node_count{graph.getNodes().size()};
+            Set<uint64_t> keys{};
+            for (const auto &rectangle: cover) {
+                keys.insert(candidate_key(graph.find_top_right(rectangle.get_top_right()),
+                                          graph.find_bottom_left(rectangle.get_bottom_left()), node_count));
+            }
+            return keys;
+        }
+    }
+
     void ILP_algorithm::construct_model(const std::vector<Rectangle> &base_rectangles,
                                             const std::vector<Rectangle> &cover_rectangles,
                                             const Problem_instance::Costs &costs,
@@ -91,17 +120,235 @@ namespace cover {
         }
     }
 
+    void ILP_algorithm::construct_graph_model(
+            const BaseRectGraph &graph,
+            const Problem_instance::Costs &costs,
+            GRBModel &model,
+            std::vector<GRBVar> &variables,
+            std::vector<Candidate> &candidates) {
+        LOG(debug) << "Constructing primal ILP model from the base rectangle graph";
+        model.setObjective(GRBLinExpr{}, GRB_MINIMIZE);
+
+        candidates.clear();
+        Candidate_filter{costs}.for_each_candidate(graph, [&candidates](BaseRectNode::PtrType top_right,
+                                                                        BaseRectNode::PtrType bottom_left) {
+            candidates.emplace_back(top_right, bottom_left);
+        });
+
+        LOG(trace) << "Constructing " << candidates.size() << " model variables";
+        std::vector<double> objective(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            objective[i] = static_cast<double>(Problem_instance::calculate_total_cost_of_rectangle(
+                    graph.get_rectangle(candidates[i].first, candidates[i].second), costs));
+        }
+        const std::vector<double> lower_bounds(candidates.size(), 0.0);
+        const std::vector<double> upper_bounds(candidates.size(), 1.0);
+        const std::vector<char> types(candidates.size(), GRB_BINARY);
+        const std::unique_ptr<GRBVar[]> added_variables{
+                model.addVars(lower_bounds.data(), upper_bounds.data(), objective.data(), types.data(), nullptr,
+                              static_cast<int>(candidates.size()))};
+        variables.assign(added_variables.get(), added_variables.get() + candidates.size());
+
+        // the walks yield the nonzeros column by column, they are counted first to store them row by row
+        LOG(trace) << "Collecting the base rectangles contained in each candidate";
+        const auto node_count{graph.getNodes().size()};
+        std::vector<size_t> row_offsets(node_count + 1, 0);
+        for (const auto &[top_right, bottom_left]: candidates) {
+            for (auto it = graph.begin(top_right, bottom_left); it != graph.end(); ++it) {
+                ++row_offsets[*it + 1];
+            }
+        }
+        for (size_t i = 1; i < row_offsets.size(); i++) {
+            row_offsets[i] += row_offsets[i - 1];
+        }
+        std::vector<GRBVar> row_variables(row_offsets.back());
+        auto insert_positions{row_offsets};
+        for (size_t i = 0; i < candidates.size(); i++) {
+            for (auto it = graph.begin(candidates[i].first, candidates[i].second); it != graph.end(); ++it) {
+                row_variables[insert_positions[*it]++] = variables[i];
+            }
+        }
+
+        LOG(trace) << "Constructing " << node_count << " model constraints";
+        const std::vector<double> coefficients(candidates.size(), 1.0);
+        std::vector<GRBLinExpr> rows(node_count);
+        for (size_t node = 0; node < node_count; node++) {
+            rows[node].addTerms(coefficients.data(), &row_variables[row_offsets[node]],
+                                static_cast<int>(row_offsets[node + 1] - row_offsets[node]));
+        }
+        const std::vector<char> senses(node_count, GRB_GREATER_EQUAL);
+        const std::vector<double> right_hand_sides(node_count, 1.0);
+        const std::unique_ptr<GRBConstr[]> added_constraints{
+                model.addConstrs(rows.data(), senses.data(), right_hand_sides.data(), nullptr,
+                                 static_cast<int>(node_count))};
+    }
+
+    void ILP_algorithm::construct_reduced_graph_model(
+            const BaseRectGraph &graph,
+            const Problem_instance::Costs &costs,
+            const std::vector<Rectangle> &start_cover,
+            const Deadline &deadline,
+            GRBModel &model,
+            std::vector<GRBVar> &variables,
+            std::vector<Candidate> &candidates) {
+        LOG(debug) << "Constructing reduced ILP model from the base rectangle graph";
+        model.setObjective(GRBLinExpr{}, GRB_MINIMIZE);
+
+        std::vector<Candidate> all_candidates{};
+        Candidate_filter{costs}.for_each_candidate(graph, [&all_candidates](BaseRectNode::PtrType top_right,
+                                                                            BaseRectNode::PtrType bottom_left) {
+            all_candidates.emplace_back(top_right, bottom_left);
+        });
+        std::vector<double> objective(all_candidates.size());
+        for (size_t i = 0; i < all_candidates.size(); i++) {
+            objective[i] = static_cast<double>(Problem_instance::calculate_total_cost_of_rectangle(
+                    graph.get_rectangle(all_candidates[i].first, all_candidates[i].second), costs));
+        }
+
+        // the rows start out empty, the columns are added to them along with their variables
+        const auto node_count{graph.getNodes().size()};
+        std::vector<GRBLinExpr> rows(node_count);
+        const std::vector<char> senses(node_count, GRB_GREATER_EQUAL);
+        const std::vector<double> right_hand_sides(node_count, 1.0);
+        const std::unique_ptr<GRBConstr[]> constraints{
+                model.addConstrs(rows.data(), senses.data(), right_hand_sides.data(), nullptr,
+                                 static_cast<int>(node_count))};
+
+        variables.clear();
+        candidates.clear();
+        std::vector<bool> in_model(all_candidates.size(), false);
+        std::vector<GRBConstr> column_constraints{};
+        std::vector<double> coefficients{};
+        const auto add_column = [&](size_t index) {
+            const auto &[top_right, bottom_left]{all_candidates[index]};
+            column_constraints.clear();
+            for (auto it = graph.begin(top_right, bottom_left); it != graph.end(); ++it) {
+                column_constraints.push_back(constraints[*it]);
+            }
+            coefficients.resize(column_constraints.size(), 1.0);
+            GRBColumn column{};
+            column.addTerms(coefficients.data(), column_constraints.data(), static_cast<int>(column_constraints.size()));
+            variables.push_back(model.addVar(0.0, 1.0, objective[index], GRB_CONTINUOUS, column));
+            candidates.push_back(all_candidates[index]);
+            in_model[index] = true;
+        };
+
+        auto initial_keys{get_candidate_keys(graph, start_cover)};
+        for (BaseRectNode::PtrType node = 0; node < node_count; node++) {
+            initial_keys.insert(candidate_key(node, node, node_count));
+        }
+        for (size_t i = 0; i < all_candidates.size(); i++) {
+            if (initial_keys.find(candidate_key(all_candidates[i].first, all_candidates[i].second, node_count))
+                != initial_keys.end()) {
+                add_column(i);
+            }
+        }
+        LOG(debug) << "Starting pricing with " << variables.size() << " of " << all_candidates.size()
+                   << " candidates";
+
+        std::vector<std::pair<double, size_t>> improving{};
+        size_t rounds{0};
+        while (!deadline.expired()) {
+            if (deadline.is_set()) {
+                model.set(GRB_DoubleParam_TimeLimit, deadline.remaining_seconds());
+            }
+            {
+                PROFILE_SCOPE("ilp_pricing_lp");
+                model.optimize();
+            }
+            if (model.get(GRB_IntAttr_Status) != GRB_OPTIMAL) {
+                LOG(info) << "LP relaxation finished with status code " << model.get(GRB_IntAttr_Status)
+                          << ", stopping pricing";
+                break;
+            }
+            ++rounds;
+
+            const std::unique_ptr<double[]> duals{
+                    model.get(GRB_DoubleAttr_Pi, constraints.get(), static_cast<int>(node_count))};
+            improving.clear();
+            for (size_t i = 0; i < all_candidates.size(); i++) {
+                if (in_model[i]) {
+                    continue;
+                }
+                auto reduced_cost{objective[i]};
+                for (auto it = graph.begin(all_candidates[i].first, all_candidates[i].second); it != graph.end();
+                     ++it) {
+                    reduced_cost -= duals[*it];
+                }
+                if (reduced_cost < -REDUCED_COST_TOLERANCE) {
+                    improving.emplace_back(reduced_cost, i);
+                }
+            }
+            LOG(debug) << "Pricing round " << rounds << " found " << improving.size() << " improving candidate(s)";
+            if (improving.empty()) {
+                break;
+            }
+
+            // only the most improving columns are added, which keeps the model small
+            const auto count{std::min(improving.size(), std::max(node_count, MIN_COLUMNS_PER_ROUND))};
+            std::partial_sort(improving.begin(), improving.begin() + static_cast<std::ptrdiff_t>(count),
+                              improving.end());
+            for (size_t i = 0; i < count; i++) {
+                add_column(improving[i].second);
+            }
+        }
+        PROFILE_COUNT("pricing_rounds", rounds);
+
+        for (auto &variable: variables) {
+            variable.set(GRB_CharAttr_VType, GRB_BINARY);
+        }
+    }
+
+    std::vector<double> ILP_algorithm::get_start_values(const BaseRectGraph &graph,
+                                                        const std::vector<Rectangle> &cover,
+                                                        const std::vector<Candidate> &candidates) {
+        const auto node_count{graph.getNodes().size()};
+        const auto keys{get_candidate_keys(graph, cover)};
+        std::vector<double> values(candidates.size(), 0.0);
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (keys.find(candidate_key(candidates[i].first, candidates[i].second, node_count)) != keys.end()) {
+                values[i] = 1.0;
+            }
+        }
+        return values;
+    }
+
+    size_t ILP_algorithm::estimate_memory(const BaseRectGraph &graph) const {
+      const auto node_count{graph.getNodes().size()};
+      auto [variables, nonzeros]{graph.count_all_candidates()};
+      // the pricing keeps every candidate, its objective coefficient and whether it is in the model next to the model
+      size_t pricing_bytes{0};
+      if (formulation == Formulation::REDUCED && !use_pixels && variables > 0) {
+        pricing_bytes = variables * (sizeof(Candidate) + sizeof(double)) + (variables + CHAR_BIT - 1) / CHAR_BIT;
+        const auto reduced_variables{std::min(variables, REDUCED_CANDIDATES_PER_NODE * node_count)};
+        nonzeros = static_cast<size_t>(static_cast<double>(nonzeros) / static_cast<double>(variables)
+                                       * static_cast<double>(reduced_variables));
+        variables = reduced_variables;
+      }
+
+      auto bytes{model_memory(variables, nonzeros) + pricing_bytes};
+      if (warm_start && !use_pixels) {
+        bytes += Greedy_set_cover_algorithm{true}.estimate_memory(graph);
+      }
+      return bytes;
+    }
+
     std::vector<Rectangle>
     ILP_algorithm::calculate_cover(const Polygon_with_holes &polygon,
                                    const Problem_instance::Costs &costs,
                                    Runtime_environment *rtenv) {
+      PROFILE_SCOPE("ilp");
       timeout_reached = false;
       LOG(info) << "Running ILP_algorithm";
 
-      if (rtenv->base_rectangles.empty()) {
-        rtenv->base_rectangles = Rectangle_enumerator::get_base_rectangles(polygon);
-      }
-      auto base_rectangles{rtenv->base_rectangles};
+      rtenv->ensure_decomposition(polygon);
+      GRBModel model{env};
+      std::vector<GRBVar> variables;
+      // in pixel mode the candidates are materialized, otherwise they are given by their corner nodes in the graph
+      std::vector<Rectangle> cover_rectangles{};
+      std::vector<Candidate> candidates{};
+      // the cover the solver starts from, if any, it is also the fallback if the solver finds no solution in time
+      std::vector<Rectangle> start_cover{};
 
       if (use_pixels) {
         LOG(warning) << "Using ILP in Pixels mode, do not use this outside of "
@@ -112,39 +359,91 @@ namespace cover {
         // qualitative equivalence of basis rectangle and pixel solution in a
         // test case, not used in actual experiments
         std::vector<Rectangle> pixel_rectangles{};
-        for (const auto &base_rectangle : base_rectangles) {
+        for (const auto &base_rectangle : rtenv->base_rectangles) {
           for (const auto &pixel : base_rectangle.get_covered_points()) {
             pixel_rectangles.emplace_back(Point(pixel.x(), pixel.y() + 1));
           }
         }
-        base_rectangles = pixel_rectangles;
+
+        cover_rectangles = Rectangle_enumerator::enumerate_rectangles(pixel_rectangles);
+        PROFILE_COUNT("candidates", cover_rectangles.size());
+
+        PROFILE_SCOPE("ilp_model");
+        construct_model(pixel_rectangles, cover_rectangles, costs, model,
+                        variables);
+      } else {
+        if (warm_start) {
+          PROFILE_SCOPE("ilp_warm_start");
+          start_cover = Greedy_set_cover_algorithm{true}.get_cover_for(polygon, costs, rtenv);
+        }
+
+        PROFILE_SCOPE("ilp_model");
+        if (formulation == Formulation::REDUCED) {
+          construct_reduced_graph_model(rtenv->graph, costs, start_cover, rtenv->deadline, model, variables,
+                                        candidates);
+        } else {
+          construct_graph_model(rtenv->graph, costs, model, variables, candidates);
+        }
+        PROFILE_COUNT("candidates", candidates.size());
+
+        if (!start_cover.empty()) {
+          const auto start_values{get_start_values(rtenv->graph, start_cover, candidates)};
+          model.set(GRB_DoubleAttr_Start, variables.data(), start_values.data(), static_cast<int>(variables.size()));
+        }
       }
 
-      const auto cover_rectangles{
-          Rectangle_enumerator::enumerate_rectangles(base_rectangles)};
+      const auto candidate_rectangle = [&](size_t i) {
+        return use_pixels ? cover_rectangles[i]
+                          : rtenv->graph.get_rectangle(candidates[i].first, candidates[i].second);
+      };
 
-      GRBModel model{env};
-      std::vector<GRBVar> variables;
-      construct_model(base_rectangles, cover_rectangles, costs, model,
-                      variables);
+      model.update();
+      Memory_account::Charge charge{rtenv->memory};
+      charge.add(model_memory(variables.size(), static_cast<size_t>(model.get(GRB_DoubleAttr_DNumNZs)))
+                 + cover_rectangles.capacity() * sizeof(Rectangle));
+
+      if (rtenv->deadline.is_set()) {
+        model.set(GRB_DoubleParam_TimeLimit,
+                  std::min(model.get(GRB_DoubleParam_TimeLimit), rtenv->deadline.remaining_seconds()));
+      }
 
       LOG(debug) << "Optimizing ILP model with Gurobi";
-      model.optimize();
+      {
+        PROFILE_SCOPE("ilp_solve");
+        model.optimize();
+      }
 
       auto status = model.get(GRB_IntAttr_Status);
       LOG(info) << "ILP finished with status code " << status;
 
       std::vector<Rectangle> cover{};
-      if (status == GRB_OPTIMAL) {
+      const auto add_picked_rectangles = [&]() {
         for (size_t i = 0; i < variables.size(); i++) {
           if (round(variables[i].get(GRB_DoubleAttr_X)) == 1) {
-            LOG(trace) << "Rectangle " << cover_rectangles[i].as_polygon()
+            const auto rectangle{candidate_rectangle(i)};
+            LOG(trace) << "Rectangle " << rectangle.as_polygon()
                        << " was picked by ILP, adding to cover";
-            cover.push_back(cover_rectangles[i]);
+            cover.push_back(rectangle);
           }
         }
+      };
+
+      if (status == GRB_OPTIMAL) {
+        add_picked_rectangles();
       } else if (status == GRB_TIME_LIMIT) {
         timeout_reached = true;
+        rtenv->deadline.report();
+        // every feasible solution is a valid cover, otherwise fall back to a cover which is cheap to compute
+        if (model.get(GRB_IntAttr_SolCount) > 0) {
+          LOG(info) << "Time limit reached, using the best solution found";
+          add_picked_rectangles();
+        } else if (!start_cover.empty()) {
+          LOG(info) << "Time limit reached without a solution, falling back to the warm start cover";
+          cover = std::move(start_cover);
+        } else {
+          LOG(info) << "Time limit reached without a solution, falling back to the strip cover";
+          cover = Strip_algorithm{}.get_cover_for(polygon, costs, rtenv);
+        }
       } else {
         std::cerr << "ILP finished with status code " << status << std::endl;
       }
@@ -34,10 +34,15 @@
 
 #include "logging.h"
 
+#include <utility>
+#include <vector>
+
 #include "CGAL_classes.h"
+#include "baserect_graph.h"
 #include "rectangle_enumerator.h"
 #include "rectangle.h"
 #include "algorithm.h"
+#include "deadline.h"
 
 namespace cover {
 
@@ -45,10 +50,42 @@ namespace cover {
      * @brief Algorithm which provides exact solutions for problem instances via an ILP formulation using Gurobi
      */
     class ILP_algorithm : public Algorithm {
+    public:
+        /**
+         * @brief Which candidates the model is built from
+         *
+         * The full formulation has a variable for every candidate of the base rectangle graph. The reduced one starts
+         * from the single base rectangles and the warm start cover and adds candidates with negative reduced cost of
+         * the LP relaxation in a pricing loop, the integer program is then solved over these candidates only. It is
+         * much smaller, but its solution is not necessarily optimal.
+         */
+        enum class Formulation { FULL, REDUCED };
+
+        using Candidate = std::pair<BaseRectNode::PtrType, BaseRectNode::PtrType>;
+
     private:
         bool use_pixels;
+        bool warm_start;
+        Formulation formulation;
         bool timeout_reached {false};
         GRBEnv env{true};
+
+        // rough sizes of the solver's representation of a variable and of a nonzero of the constraint matrix, which
+        // it keeps both by row and by column, only used to account for the memory of the model
+        static constexpr size_t MODEL_BYTES_PER_VARIABLE{64};
+        static constexpr size_t MODEL_BYTES_PER_NONZERO{24};
+        // the reduced formulation is assumed to end up with at most this many candidates per base rectangle
+        static constexpr size_t REDUCED_CANDIDATES_PER_NODE{4};
+
+        /**
+         * @param variables The number of variables of the model
+         * @param nonzeros The number of nonzeros of the constraint matrix
+         * @return The estimated bytes of the model, its variables and their candidates
+         */
+        [[nodiscard]] static size_t model_memory(size_t variables, size_t nonzeros) {
+            return variables * (MODEL_BYTES_PER_VARIABLE + sizeof(GRBVar) + sizeof(Candidate))
+                   + nonzeros * MODEL_BYTES_PER_NONZERO;
+        }
     protected:
         /**
          * Constructs the model to be solved by Gurobi from the provided base rectangles of the polygon,
@@ -68,6 +105,66 @@ namespace cover {
                                                GRBModel &model,
                                                std::vector<GRBVar> &variables) const;
 
+        /**
+         * Constructs the same model as construct_model() directly from the base rectangle graph of the polygon.
+         *
+         * The candidates are enumerated by the graph and the base rectangles each of them contains are found by
+         * walking it, which yields the constraint matrix column by column in time linear in its number of nonzeros.
+         * Variables and constraints are then added to the model in bulk.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param costs The costs associated with the problem instance
+         * @param model The model to add the variables and constraints to
+         * @param variables Receives one variable per candidate
+         * @param candidates Receives the top right and bottom left node of each candidate, in the order of the
+         * variables
+         */
+        static void construct_graph_model(const BaseRectGraph &graph,
+                                          const Problem_instance::Costs &costs,
+                                          GRBModel &model,
+                                          std::vector<GRBVar> &variables,
+                                          std::vector<Candidate> &candidates);
+
+        /**
+         * Constructs the model of the reduced formulation by column generation over the candidates of the base
+         * rectangle graph.
+         *
+         * The model starts with the single base rectangles, which make it feasible, and the rectangles of the start
+         * cover. Its LP relaxation is solved repeatedly, after each solve the reduced cost of every other candidate
+         * is computed from the duals of the covering constraints and the ones with the most negative reduced cost
+         * are added. Once no candidate has negative reduced cost or the deadline passed, the variables are made
+         * binary.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param costs The costs associated with the problem instance
+         * @param start_cover The cover whose rectangles are added to the model from the start, may be empty
+         * @param deadline The deadline of the run, which bounds the LP solves
+         * @param model The model to add the variables and constraints to
+         * @param variables Receives one variable per candidate in the model
+         * @param candidates Receives the top right and bottom left node of each candidate in the model, in the
+         * order of the variables
+         */
+        static void construct_reduced_graph_model(const BaseRectGraph &graph,
+                                                  const Problem_instance::Costs &costs,
+                                                  const std::vector<Rectangle> &start_cover,
+                                                  const Deadline &deadline,
+                                                  GRBModel &model,
+                                                  std::vector<GRBVar> &variables,
+                                                  std::vector<Candidate> &candidates);
+
+        /**
+         * Calculates the start values of the variables for the given cover, one for the candidates in the cover and
+         * zero for all others.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param cover The cover to start from, every rectangle in it must be made up of base rectangles
+         * @param candidates The candidates of the variables
+         * @return The start value of each variable
+         */
+        [[nodiscard]] static std::vector<double> get_start_values(const BaseRectGraph &graph,
+                                                                  const std::vector<Rectangle> &cover,
+                                                                  const std::vector<Candidate> &candidates);
+
         /**
          * Calculates an exact solution for the polygon and costs using an ILP formulation.
          *
@@ -87,10 +184,18 @@ namespace cover {
          * all possible rectangles with integer coordinates which can fit inside the polygon will be considered. This
          * can severely degrade performance and is only supported for experimental purposes.
          *
+         * A warm start seeds the solver with the cover of the lazy greedy algorithm, which gives it a good incumbent
+         * from the start, so runs stopped by the time limit still return a cover of greedy quality. Both the warm
+         * start and the formulation are ignored in pixel mode.
+         *
          * @param use_pixels Whether to use pixels as base rectangles or not, default is no
+         * @param timeout The time limit of the solver in seconds, none if not positive
+         * @param warm_start Whether to start the solver from the greedy cover, default is no
+         * @param formulation Whether to build the full or the reduced model, default is the full one
          */
-        explicit ILP_algorithm(bool use_pixels = false, double timeout = 0)
-                : use_pixels(use_pixels) {
+        explicit ILP_algorithm(bool use_pixels = false, double timeout = 0, bool warm_start = false,
+                               Formulation formulation = Formulation::FULL)
+                : use_pixels(use_pixels), warm_start(warm_start), formulation(formulation) {
             env.set(GRB_IntParam_LogToConsole, 0);
             env.set(GRB_DoubleParam_MIPGap, 0.0);
             if (timeout > 0) {
@@ -100,6 +205,17 @@ namespace cover {
         }
 
         [[nodiscard]] virtual bool timeouted() const override { return timeout_reached; }
+
+        /**
+         * Estimates the model with one variable per rectangle of the polygon and one nonzero per base rectangle
+         * it contains, plus the warm start cover. The reduced formulation is assumed to keep at most
+         * REDUCED_CANDIDATES_PER_NODE candidates per base rectangle in the model, plus every candidate and its
+         * objective coefficient for the pricing. Pixel mode is estimated like the full one, which underestimates it.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @return The estimated number of bytes
+         */
+        [[nodiscard]] size_t estimate_memory(const BaseRectGraph &graph) const override;
     };
 
 } // cover
@@ -68,6 +68,19 @@ namespace cover {
                     Runtime_environment *env) override {
         return calculate_cover(polygon, costs, env);
       }
+
+        /**
+         * Estimates the bytes of the scratch structures, e.g. candidates or a model, the algorithm builds to cover
+         * the polygon of the given base rectangle graph, on top of the graph itself. Used before running the
+         * algorithm to check whether the polygon fits into a memory budget. The default of 0 is for algorithms
+         * which only need memory linear in the number of base rectangles.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @return The estimated number of bytes
+         */
+      [[nodiscard]] virtual size_t estimate_memory([[maybe_unused]] const BaseRectGraph &graph) const {
+        return 0;
+      }
     };
 
 } // cover
@@ -25,12 +25,31 @@
 
 #include "algorithm_runner.h"
 
+#include <algorithm>
+#include <exception>
+#include <mutex>
 #include <utility>
 #include <iostream>
+#include <numeric>
+#include <string>
 
+#include "bounded_queue.h"
 #include "logging.h"
+#include "rectangle_enumerator.h"
+#include "worker_pool.h"
 
 namespace cover {
+    namespace {
+        uint64_t compact_area(const CompactRectangle &rectangle) {
+            return static_cast<uint64_t>(rectangle.max_x - rectangle.min_x) * (rectangle.max_y - rectangle.min_y);
+        }
+
+        bool compact_contains(const CompactRectangle &outer, const CompactRectangle &inner) {
+            return outer.min_x <= inner.min_x && outer.min_y <= inner.min_y
+                   && inner.max_x <= outer.max_x && inner.max_y <= outer.max_y;
+        }
+    }
+
     bool Algorithm_runner::is_valid_cover(const Cover &rectangles, const Polygon_with_holes &polygon) {
         LOG(debug) << "Verifying cover...";
 
@@ -101,11 +120,225 @@ namespace cover {
         return uncovered_polygons.empty();
     }
 
+    bool Algorithm_runner::is_valid_cover_graph(const Cover &rectangles, const Polygon_with_holes &polygon,
+                                                Runtime_environment &env) {
+        LOG(debug) << "Verifying cover using the base rectangle graph...";
+
+        assert(polygon.outer_boundary().size() > 4 || polygon.has_holes());
+
+        env.ensure_decomposition(polygon);
+        const auto &graph{env.graph};
+
+        std::vector<bool> covered(graph.getNodes().size(), false);
+        for (const auto &rectangle: rectangles) {
+            if (rectangle.get_max_y() <= rectangle.get_min_y() || rectangle.get_max_x() <= rectangle.get_min_x()) {
+                return false;
+            }
+
+            const auto top_right{graph.find_top_right(rectangle.get_top_right())};
+            const auto bottom_left{graph.find_bottom_left(rectangle.get_bottom_left())};
+            if (top_right == BaseRectNode::NO_NEIGHBOR || bottom_left == BaseRectNode::NO_NEIGHBOR) {
+                LOG(info) << "Rectangle " << rectangle << " is not aligned with the base rectangles, "
+                                                         "falling back to boolean operations";
+                return is_valid_cover(rectangles, polygon);
+            }
+
+            const auto compact{graph.get_compact_rectangle(top_right, bottom_left)};
+            auto remaining_area{compact_area(compact)};
+            bool contained{true};
+            for (auto it = graph.begin(top_right, bottom_left); it != graph.end(); ++it) {
+                const auto &node{graph.get_compact_rectangle(*it)};
+                if (!compact_contains(compact, node)) {
+                    contained = false;
+                    break;
+                }
+                covered[*it] = true;
+                remaining_area -= compact_area(node);
+            }
+
+            if (!contained || remaining_area != 0) {
+                // either the rectangle leaves the polygon or the graph cannot enumerate it, let CGAL decide
+                LOG(info) << "Rectangle " << rectangle << " cannot be resolved into base rectangles, "
+                                                         "falling back to boolean operations";
+                return is_valid_cover(rectangles, polygon);
+            }
+        }
+
+        return std::all_of(covered.cbegin(), covered.cend(), [](bool node_covered) { return node_covered; });
+    }
+
+    bool Algorithm_runner::is_trivial(const Polygon_with_holes &polygon) {
+      return polygon.outer_boundary().size() == 4 && !polygon.has_holes();
+    }
+
+    Algorithm_runner::Result
+    Algorithm_runner::run_on_polygon(Cover_provider &algorithm,
+                                     const Polygon_with_holes &polygon,
+                                     const Problem_instance &instance,
+                                     Runtime_environment &env,
+                                     bool verify,
+                                     Verification_method method,
+                                     const Run_options &options) {
+      Result::Validity valid{Result::Validity::UNCHECKED};
+      const Profile::Activation activation{options.profiling ? &env.profile : nullptr};
+      const auto &decomposition_cache{options.decomposition_cache};
+      // environments reused across runs already hold the decomposition, only fresh ones use the cache
+      const bool fresh_environment{env.base_rectangles.empty() && env.graph.empty()};
+      bool cached{false};
+      if (decomposition_cache != nullptr && fresh_environment) {
+        PROFILE_SCOPE("cache_load");
+        cached = decomposition_cache->load(polygon, options.decomposition_engine, env);
+      }
+
+      const size_t measured_runs{std::max<size_t>(1, options.repetitions)};
+      const size_t runs{options.warmup_runs + measured_runs};
+      std::vector<nanos> times{};
+      times.reserve(measured_runs);
+      Perf_counters counters{options.hardware_counters};
+      Perf_counters::Values counter_sum{};
+      Cover partial_cover{};
+      for (size_t run = 0; run < runs; run++) {
+        if (run > 0) {
+          // every run starts from the environment the first one got
+          if (fresh_environment) {
+            env.clear();
+            if (cached) {
+              PROFILE_SCOPE("cache_load");
+              decomposition_cache->load(polygon, options.decomposition_engine, env);
+            }
+          } else {
+            env.clear_cover_data();
+          }
+        }
+        env.options = options;
+        env.deadline = Deadline{options.timeout};
+        counters.start();
+        const auto start_time{clock::now()};
+
+        partial_cover = algorithm.get_cover_for(polygon, instance.get_costs(), &env);
+        const auto end_time{clock::now()};
+        const auto values{counters.stop()};
+
+        if (run >= options.warmup_runs) {
+          times.push_back(std::chrono::duration_cast<nanos>(end_time - start_time));
+          counter_sum += values;
+        }
+      }
+      const auto peak_memory{env.decomposition_memory() + env.index_memory() + env.arena.used()
+                             + env.memory.get_peak()};
+
+      if (algorithm.timeouted() || env.deadline.reached()) {
+        valid = Result::Validity::TIMEOUT;
+      } else if (verify) {
+        valid = check_cover(partial_cover, polygon, env, method);
+      }
+
+      if (decomposition_cache != nullptr && fresh_environment && !cached && !env.base_rectangles.empty()) {
+        if (env.graph.empty()) {
+          env.graph.build(env.base_rectangles);
+        }
+        PROFILE_SCOPE("cache_store");
+        decomposition_cache->store(polygon, options.decomposition_engine, env);
+      }
+
+      const auto timing{calculate_timing(times)};
+      std::optional<Perf_counters::Values> average_counters{};
+      if (counters.available()) {
+        average_counters = Perf_counters::Values{counter_sum.cycles / measured_runs,
+                                                 counter_sum.instructions / measured_runs,
+                                                 counter_sum.cache_misses / measured_runs};
+      }
+      const auto cost = instance.calculate_cost_of_cover(partial_cover);
+      const auto size = partial_cover.size();
+
+      LOG(info) << "Finished within " << timing.median.count() << "ns"
+                << (measured_runs > 1 ? " (median of " + std::to_string(measured_runs) + " runs)" : "")
+                << ", validity status: " << valid;
+
+      return {size, cost, timing.median, valid, std::move(partial_cover), env.profile, timing, average_counters,
+              peak_memory, env.degraded_to, static_cast<size_t>(!env.degraded_to.empty())};
+    }
+
+    Algorithm_runner::Result::Validity
+    Algorithm_runner::check_cover(const Cover &cover,
+                                  const Polygon_with_holes &polygon,
+                                  Runtime_environment &env,
+                                  Verification_method method) {
+      PROFILE_SCOPE("verification");
+      const bool is_valid{method == Verification_method::BASE_RECTANGLE_GRAPH
+                          ? is_valid_cover_graph(cover, polygon, env)
+                          : is_valid_cover(cover, polygon)};
+      return is_valid ? Result::Validity::VALID : Result::Validity::INVALID;
+    }
+
+    void Algorithm_runner::decompose(const Polygon_with_holes &polygon, Runtime_environment &env) {
+      const auto &cache{env.options.decomposition_cache};
+      if (cache != nullptr) {
+        PROFILE_SCOPE("cache_load");
+        if (cache->load(polygon, env.options.decomposition_engine, env)) {
+          return;
+        }
+      }
+      env.ensure_decomposition(polygon);
+      if (cache != nullptr) {
+        PROFILE_SCOPE("cache_store");
+        cache->store(polygon, env.options.decomposition_engine, env);
+      }
+    }
+
+    Algorithm_runner::Timing Algorithm_runner::calculate_timing(std::vector<nanos> &times) {
+      std::sort(times.begin(), times.end());
+      // nearest-rank percentiles, the median of an even number of runs is the lower one
+      const auto percentile{[&times](size_t percent) {
+        const auto rank{(times.size() * percent + 99) / 100};
+        return times[std::max<size_t>(rank, 1) - 1];
+      }};
+      return {times.size(), times.front(), percentile(50), percentile(95)};
+    }
+
+    Runtime_environment &
+    Algorithm_runner::prepare_environment(std::vector<Runtime_environment> *environments,
+                                          size_t polygon_index,
+                                          Runtime_environment &fallback) {
+      if (environments == nullptr) {
+        fallback.clear();
+        return fallback;
+      }
+      auto &env{(*environments)[polygon_index]};
+      env.clear_cover_data();
+      return env;
+    }
+
+    void Algorithm_runner::add_to_total(Result &total, const Result &result) {
+      total.cover_size += result.cover_size;
+      total.cost += result.cost;
+      total.execution_time += result.execution_time;
+      total.timing.repetitions = std::max(total.timing.repetitions, result.timing.repetitions);
+      total.timing.median += result.timing.median;
+      if (result.counters.has_value()) {
+        if (!total.counters.has_value()) {
+          total.counters = Perf_counters::Values{};
+        }
+        *total.counters += *result.counters;
+      }
+      total.profile.merge(result.profile);
+      total.peak_memory_bytes = std::max(total.peak_memory_bytes, result.peak_memory_bytes);
+      total.degraded_polygons += result.degraded_polygons;
+      if (result.is_valid == Result::Validity::TIMEOUT) {
+        total.is_valid = Result::Validity::TIMEOUT;
+      } else if (result.is_valid == Result::Validity::INVALID) {
+        total.is_valid = Result::Validity::INVALID;
+      }
+    }
+
     std::vector<Algorithm_runner::Result>
     Algorithm_runner::run_algorithm(Cover_provider &algorithm,
                                     const Problem_instance &instance,
-                                    bool verify) {
-      Result::Validity valid{Result::Validity::UNCHECKED};
+                                    bool verify,
+                                    Verification_method method,
+                                    const Run_options &options,
+                                    std::vector<Runtime_environment> *environments,
+                                    const Result_listener &listener) {
       std::vector<Algorithm_runner::Result> results;
       results.reserve(instance.get_multi_polygon().size() + 1);
       results.emplace_back(Result()); // use for total
@@ -114,49 +347,215 @@ namespace cover {
       }
 
       const auto &polygons {instance.get_multi_polygon()};
-      Runtime_environment env;
-      for (const auto &polygon : polygons) {
-        if (polygon.outer_boundary().size() == 4 && !polygon.has_holes()) {
+      if (environments != nullptr) {
+        environments->resize(polygons.size());
+      }
+      Runtime_environment local_env;
+      for (size_t i = 0; i < polygons.size(); i++) {
+        const auto &polygon{polygons[i]};
+        if (is_trivial(polygon)) {
           LOG(info) << "Polygon is hole-free rectangle, skipping...";
           continue;
         }
 
-        env.clear();
         LOG(info) << "Computing cover for polygon " << results.size() << " / " << polygons.size();
-        const auto start_time{clock::now()};
+        auto &env{prepare_environment(environments, i, local_env)};
+        results.push_back(run_on_polygon(algorithm, polygon, instance, env, verify, method, options));
+        add_to_total(results[0], results.back());
+        if (listener) {
+          listener(results.size() - 1, results.back());
+        }
+      }
+      LOG(info) << (polygons.size() - results.size() + 1) << " trivial polygons skipped.";
 
-        const auto partial_cover{
-            algorithm.get_cover_for(polygon, instance.get_costs(), &env)};
-        const auto end_time{clock::now()};
+      return results;
+    }
+
+    std::vector<Algorithm_runner::Result>
+    Algorithm_runner::run_algorithm(const Provider_factory &factory,
+                                    const Problem_instance &instance,
+                                    bool verify,
+                                    size_t threads,
+                                    Verification_method method,
+                                    const Run_options &options,
+                                    std::vector<Runtime_environment> *environments,
+                                    const Result_listener &listener) {
+      const auto &polygons {instance.get_multi_polygon()};
 
-        if (algorithm.timeouted()) {
-          valid = Result::Validity::TIMEOUT;
-        } else if (verify) {
-          valid = is_valid_cover(partial_cover, polygon)
-                      ? Result::Validity::VALID
-                      : Result::Validity::INVALID;
+      std::vector<size_t> polygon_indices{};
+      for (size_t i = 0; i < polygons.size(); i++) {
+        if (!is_trivial(polygons[i])) {
+          polygon_indices.push_back(i);
         }
+      }
 
-        const auto duration{
-            std::chrono::duration_cast<nanos>(end_time - start_time)};
-        const auto cost = instance.calculate_cost_of_cover(partial_cover);
-        const auto size = partial_cover.size();
+      threads = std::max<size_t>(1, std::min(threads, polygon_indices.size()));
+      if (threads == 1) {
+        const auto algorithm{factory()};
+        return run_algorithm(*algorithm, instance, verify, method, options, environments, listener);
+      }
+      LOG(info) << (polygons.size() - polygon_indices.size()) << " trivial polygons skipped.";
+
+      // schedule the largest polygons first, ties are broken by input order to keep runs reproducible
+      std::vector<size_t> vertex_counts(polygon_indices.size());
+      for (size_t slot = 0; slot < polygon_indices.size(); slot++) {
+        const auto &polygon{polygons[polygon_indices[slot]]};
+        vertex_counts[slot] = polygon.outer_boundary().size();
+        for (const auto &hole: polygon.holes()) {
+          vertex_counts[slot] += hole.size();
+        }
+      }
+      std::vector<size_t> schedule(polygon_indices.size());
+      std::iota(schedule.begin(), schedule.end(), 0);
+      std::stable_sort(schedule.begin(), schedule.end(), [&](size_t a, size_t b) {
+        return vertex_counts[a] > vertex_counts[b];
+      });
+
+      // providers are created up front, as constructing some of them (e.g. a Gurobi environment) may not be
+      // thread-safe
+      std::vector<std::unique_ptr<Cover_provider>> providers(threads);
+      for (auto &provider: providers) {
+        provider = factory();
+      }
+      // per-worker environments, only used if none are provided per polygon
+      std::vector<Runtime_environment> envs(threads);
+      if (environments != nullptr) {
+        environments->resize(polygons.size());
+      }
 
-        LOG(info) << "Finished within " << duration.count() << "ns, validity status: " << valid;
+      std::vector<Algorithm_runner::Result> results(polygon_indices.size() + 1);
+      LOG(info) << "Computing covers for " << polygon_indices.size() << " polygons using " << threads << " threads";
+      std::mutex listener_mutex{};
+      Worker_pool pool{threads};
+      pool.run(schedule.size(), [&](size_t task, size_t worker) {
+        const auto slot{schedule[task]};
+        LOG(info) << "Computing cover for polygon " << (slot + 1) << " / " << polygons.size();
+        auto &env{prepare_environment(environments, polygon_indices[slot], envs[worker])};
+        results[slot + 1] = run_on_polygon(*providers[worker], polygons[polygon_indices[slot]],
+                                           instance, env, verify, method, options);
+        if (listener) {
+          const std::lock_guard<std::mutex> lock{listener_mutex};
+          listener(slot + 1, results[slot + 1]);
+        }
+      });
 
-        results.push_back(
-            {size, cost, duration, valid, std::move(partial_cover)});
+      if (verify) {
+        results[0].is_valid = Result::Validity::VALID;
+      }
+      for (size_t slot = 1; slot < results.size(); slot++) {
+        add_to_total(results[0], results[slot]);
+      }
+
+      return results;
+    }
 
-        results[0].cover_size += size;
-        results[0].cost += cost;
-        results[0].execution_time += duration;
-        if (algorithm.timeouted()) {
-          results[0].is_valid = Result::Validity::TIMEOUT;
-        } else if (valid == Result::Validity::INVALID) {
-          results[0].is_valid = Result::Validity::INVALID;
+    std::vector<Algorithm_runner::Result>
+    Algorithm_runner::run_pipelined(Cover_provider &algorithm,
+                                    const Problem_instance &instance,
+                                    bool verify,
+                                    Verification_method method,
+                                    const Run_options &options,
+                                    const Result_listener &listener) {
+      const auto &polygons{instance.get_multi_polygon()};
+
+      std::vector<size_t> polygon_indices{};
+      for (size_t i = 0; i < polygons.size(); i++) {
+        if (!is_trivial(polygons[i])) {
+          polygon_indices.push_back(i);
         }
       }
-      LOG(info) << (polygons.size() - results.size() + 1) << " trivial polygons skipped.";
+      LOG(info) << (polygons.size() - polygon_indices.size()) << " trivial polygons skipped.";
+
+      std::vector<Algorithm_runner::Result> results(polygon_indices.size() + 1);
+      if (verify) {
+        results[0].is_valid = Result::Validity::VALID;
+      }
+
+      // a polygon travels through the stages together with its environment, which holds its decomposition
+      struct Job {
+        size_t slot;
+        std::unique_ptr<Runtime_environment> env;
+        Result result;
+      };
+      Bounded_queue<Job> decomposed{PIPELINE_DEPTH};
+      Bounded_queue<Job> solved{PIPELINE_DEPTH};
+
+      // the first failing stage closes both queues, so the others stop as well
+      std::mutex failure_mutex{};
+      std::exception_ptr failure{nullptr};
+      const auto fail{[&](std::exception_ptr exception) {
+        {
+          const std::lock_guard<std::mutex> lock{failure_mutex};
+          if (failure == nullptr) {
+            failure = std::move(exception);
+          }
+        }
+        decomposed.close();
+        solved.close();
+      }};
+
+      boost::thread decomposer{[&]() {
+        try {
+          for (size_t slot = 0; slot < polygon_indices.size(); slot++) {
+            Job job{slot, std::make_unique<Runtime_environment>(), {}};
+            {
+              const Profile::Activation activation{options.profiling ? &job.env->profile : nullptr};
+              job.env->options = options;
+              decompose(polygons[polygon_indices[slot]], *job.env);
+            }
+            if (!decomposed.push(std::move(job))) {
+              break;
+            }
+          }
+        } catch (...) {
+          fail(std::current_exception());
+        }
+        decomposed.close();
+      }};
+
+      boost::thread verifier{[&]() {
+        try {
+          while (auto job{solved.pop()}) {
+            auto &result{job->result};
+            const auto &polygon{polygons[polygon_indices[job->slot]]};
+            if (verify && result.is_valid == Result::Validity::UNCHECKED) {
+              const Profile::Activation activation{options.profiling ? &result.profile : nullptr};
+              result.is_valid = check_cover(result.cover, polygon, *job->env, method);
+            }
+            // the environment is not needed anymore, release it before waiting for the output
+            job->env.reset();
+
+            results[job->slot + 1] = std::move(result);
+            add_to_total(results[0], results[job->slot + 1]);
+            if (listener) {
+              listener(job->slot + 1, results[job->slot + 1]);
+            }
+          }
+        } catch (...) {
+          fail(std::current_exception());
+        }
+      }};
+
+      LOG(info) << "Computing covers for " << polygon_indices.size() << " polygons in a pipeline";
+      try {
+        while (auto job{decomposed.pop()}) {
+          LOG(info) << "Computing cover for polygon " << (job->slot + 1) << " / " << polygon_indices.size();
+          job->result = run_on_polygon(algorithm, polygons[polygon_indices[job->slot]], instance, *job->env,
+                                       false, method, options);
+          if (!solved.push(std::move(*job))) {
+            break;
+          }
+        }
+      } catch (...) {
+        fail(std::current_exception());
+      }
+      solved.close();
+
+      decomposer.join();
+      verifier.join();
+      if (failure != nullptr) {
+        std::rethrow_exception(failure);
+      }
 
       return results;
     }
@@ -184,4 +583,4 @@ operator<<(std::ostream &out,
   return out;
 }
 
-} // namespace std
\ No newline at end of file
+} // namespace std
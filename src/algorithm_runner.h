@@ -28,6 +28,11 @@
 
 #include <map>
 #include <chrono>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
 
 #include <boost/thread/thread.hpp>
 #include <boost/thread/future.hpp>
@@ -40,6 +45,9 @@
 #include "rectangle.h"
 #include "cover_provider.h"
 #include "runtime_environment.h"
+#include "decomposition_cache.h"
+#include "perf_counters.h"
+#include "run_options.h"
 
 namespace cover {
     /**
@@ -55,11 +63,41 @@ namespace cover {
     public:
         using Cover = std::vector<Rectangle>;
 
+        /**
+         * Function creating a fresh Cover_provider, used to give every worker thread its own provider instance.
+         */
+        using Provider_factory = std::function<std::unique_ptr<Cover_provider>()>;
+
+        /**
+         * Method used to verify covers, see is_valid_cover() and is_valid_cover_graph().
+         */
+        enum class Verification_method { BOOLEAN_OPERATIONS, BASE_RECTANGLE_GRAPH };
+
+        /**
+         * @brief Execution time statistics over the measured repetitions of a polygon, see Run_options::repetitions
+         *
+         * The total sums the medians like the execution times, the minimum and the 95th percentile of different
+         * polygons don't add up to anything meaningful, so the total has none.
+         */
+        struct Timing {
+            size_t repetitions{0};
+            std::optional<nanos> min{};
+            nanos median{0};
+            std::optional<nanos> p95{};
+        };
+
         /**
          * @brief Struct representing the result of running an algorithm on a problem instance
          *
          * Contains the calculated cover, total creation cost, total area cost, execution time and whether
-         * the calculated polygon is valid, if verification was turned on.
+         * the calculated polygon is valid, if verification was turned on. The execution time is the median over the
+         * measured repetitions, the hardware counters are averaged over them and only present if they were enabled
+         * and available.
+         *
+         * The peak memory adds up the decomposition of the polygon, its containment and coverage indices, the arena
+         * and the Memory_account of the last run, which bounds the bytes held at once by the major structures. If the chosen algorithm was replaced to
+         * stay within a memory budget, see Memory_budget_algorithm, the replacement is named in degraded_to. The
+         * total holds the largest peak of any polygon and the number of degraded polygons.
          */
         struct Result {
             size_t cover_size;
@@ -68,8 +106,22 @@ namespace cover {
             enum Validity { INVALID = 0, VALID = 1, UNCHECKED = 2, TIMEOUT = 3 }
                 is_valid { UNCHECKED };
             Cover cover;
+            Profile profile;
+            Timing timing;
+            std::optional<Perf_counters::Values> counters;
+            size_t peak_memory_bytes{0};
+            std::string degraded_to{};
+            size_t degraded_polygons{0};
         };
 
+        /**
+         * Function called with the index of a polygon in the result vector and its result as soon as the polygon is
+         * done, e.g. to write the result right away. Calls are serialized, in parallel runs they happen in the order
+         * the polygons finish. The listener may release the cover of the result once it doesn't need it anymore, the
+         * total at index 0 is unaffected by that.
+         */
+        using Result_listener = std::function<void(size_t polygon, Result &result)>;
+
         /**
          * Runs the given Algorithm on a single provided Problem_instance. The results are returned in a
          * tuple containing:
@@ -85,12 +137,78 @@ namespace cover {
          * @param algorithm The algorithm to evaluate on the problem instance
          * @param instance The problem instance to run the algorithm on
          * @param verify Whether to check the correctness of the cover returned by the algorithm, default is true
+         * @param method The method used for the verification, default is the exact CGAL boolean operations
+         * @param options How the algorithm is run on each polygon, by default once without a timeout
+         * @param environments Optional runtime environments, one per polygon of the instance, which are kept across
+         *                     runs, so the decomposition of each polygon is reused if the same environments are passed
+         *                     again for the same instance, by default a fresh environment is used for every polygon
+         * @param listener Optional function called with the result of each polygon as soon as it is done
          * @return The result of running the algorithm on the provided problem instance
          */
         static std::vector<Result>
         run_algorithm(Cover_provider &algorithm,
                       const Problem_instance &instance,
-                      bool verify = true);
+                      bool verify = true,
+                      Verification_method method = Verification_method::BOOLEAN_OPERATIONS,
+                      const Run_options &options = {},
+                      std::vector<Runtime_environment> *environments = nullptr,
+                      const Result_listener &listener = {});
+
+        /**
+         * Runs the Cover_provider created by the given factory on a single provided Problem_instance, using the given
+         * number of threads. The polygons of the instance are processed independently, each worker thread uses its
+         * own provider instance and Runtime_environment. Polygons are scheduled in decreasing order of their number
+         * of vertices, so large polygons do not end up being processed last, but the results are returned in the same
+         * order as by the sequential overload. Execution times are measured per polygon, so the total is the sum of
+         * the per-polygon times and not the wall-clock time.
+         *
+         * @param factory Function creating the provider to evaluate, called at most once per thread
+         * @param instance The problem instance to run the provider on
+         * @param verify Whether to check the correctness of the covers returned by the provider
+         * @param threads The number of threads to use
+         * @param method The method used for the verification, default is the exact CGAL boolean operations
+         * @param options How the provider is run on each polygon, see the sequential overload
+         * @param environments Optional runtime environments, one per polygon of the instance, see the sequential
+         *                     overload
+         * @param listener Optional function called with the result of each polygon as soon as it is done
+         * @return The result of running the provider on the provided problem instance
+         */
+        static std::vector<Result>
+        run_algorithm(const Provider_factory &factory,
+                      const Problem_instance &instance,
+                      bool verify,
+                      size_t threads,
+                      Verification_method method = Verification_method::BOOLEAN_OPERATIONS,
+                      const Run_options &options = {},
+                      std::vector<Runtime_environment> *environments = nullptr,
+                      const Result_listener &listener = {});
+
+        /**
+         * Runs the given provider on a single provided Problem_instance like the sequential overload, but in a
+         * pipeline of three stages on their own threads: the decomposition of the next polygons into base rectangles
+         * (or loading it from the decomposition cache), running the provider and the verification of the covers,
+         * which also calls the listener. The stages are connected by queues holding at most PIPELINE_DEPTH polygons,
+         * so only a few decompositions are kept in memory, but a single provider never waits for the decomposition,
+         * the verification or the output of other polygons.
+         *
+         * As the decomposition happens ahead of time, it is not part of the measured execution times, like for
+         * polygons found in the decomposition cache. Results and listener calls are in the order of the polygons.
+         *
+         * @param algorithm The provider to evaluate, only used by the thread running it
+         * @param instance The problem instance to run the provider on
+         * @param verify Whether to check the correctness of the covers returned by the provider
+         * @param method The method used for the verification, default is the exact CGAL boolean operations
+         * @param options How the provider is run on each polygon, see the sequential overload of run_algorithm()
+         * @param listener Optional function called with the result of each polygon as soon as it is verified
+         * @return The result of running the provider on the provided problem instance
+         */
+        static std::vector<Result>
+        run_pipelined(Cover_provider &algorithm,
+                      const Problem_instance &instance,
+                      bool verify,
+                      Verification_method method = Verification_method::BOOLEAN_OPERATIONS,
+                      const Run_options &options = {},
+                      const Result_listener &listener = {});
 
         /**
          * Returns whether the provided vector of Rectangle objects is a valid cover of the provided MultiPolygon.
@@ -110,6 +228,107 @@ namespace cover {
         static bool is_valid_cover(const Cover &rectangles, const Polygon_with_holes &polygon);
 
         static bool verify_cover(const Cover &rectangles, const Polygon_with_holes &polygon);
+
+        /**
+         * Returns whether the provided vector of Rectangle objects is a valid cover of the provided polygon, using
+         * the base rectangle graph of the polygon instead of boolean operations.
+         *
+         * Every rectangle of the cover has to span from the bottom left corner of one base rectangle to the top right
+         * corner of another one and the base rectangles enumerated in between have to add up to the rectangle
+         * exactly, which means that the rectangle lies within the polygon. The cover is valid if every base rectangle
+         * is covered by at least one such rectangle. Areas are compared in compressed coordinates, so the check is
+         * exact and takes time linear in the number of base rectangles enumerated.
+         *
+         * If a rectangle cannot be resolved into base rectangles like this, is_valid_cover() is used instead.
+         *
+         * @param rectangles The set of rectangles constituting a potential cover
+         * @param polygon The polygon to cover
+         * @param env The runtime environment of the polygon, its graph is reused or built if it's not available yet
+         * @return Whether the rectangles are a valid cover of the polygon or not
+         */
+        static bool is_valid_cover_graph(const Cover &rectangles, const Polygon_with_holes &polygon,
+                                         Runtime_environment &env);
+
+        // the number of polygons each stage of run_pipelined() may run ahead of the next one
+        static constexpr size_t PIPELINE_DEPTH{2};
+
+    private:
+        /**
+         * Runs the provider on a single polygon of the instance and measures its execution time, repeatedly if
+         * requested, see Run_options::repetitions. The options and the deadline are stored in the environment first.
+         *
+         * @param algorithm The provider to run
+         * @param polygon The polygon to cover
+         * @param instance The problem instance the polygon belongs to
+         * @param env The runtime environment to use
+         * @param verify Whether to check the correctness of the returned cover
+         * @param method The method used for the verification
+         * @param options How to run the provider
+         * @return The result for the polygon
+         */
+        static Result run_on_polygon(Cover_provider &algorithm,
+                                     const Polygon_with_holes &polygon,
+                                     const Problem_instance &instance,
+                                     Runtime_environment &env,
+                                     bool verify,
+                                     Verification_method method,
+                                     const Run_options &options);
+
+        /**
+         * Checks the cover of a polygon with the given method, the verification is recorded in the active profile.
+         *
+         * @param cover The cover to check
+         * @param polygon The polygon it should cover
+         * @param env The runtime environment of the polygon, used by the base rectangle graph method
+         * @param method The method used for the verification
+         * @return VALID or INVALID
+         */
+        static Result::Validity check_cover(const Cover &cover,
+                                            const Polygon_with_holes &polygon,
+                                            Runtime_environment &env,
+                                            Verification_method method);
+
+        /**
+         * Fills the base rectangles and graph of a fresh environment, from the decomposition cache if the polygon is
+         * found there, otherwise they are computed and stored in the cache if one is set. The cache and the number of
+         * decomposition threads are taken from the options of the environment.
+         *
+         * @param polygon The polygon to decompose
+         * @param env The environment to fill
+         */
+        static void decompose(const Polygon_with_holes &polygon, Runtime_environment &env);
+
+        /**
+         * Returns the environment to use for the polygon with the given index. If environments are provided, the
+         * cover specific data of the polygon's environment is cleared, otherwise the fallback is cleared entirely.
+         *
+         * @param environments Optional runtime environments, one per polygon
+         * @param polygon_index The index of the polygon in the instance
+         * @param fallback The environment to use if no environments are provided
+         * @return The environment to run the provider with
+         */
+        static Runtime_environment &prepare_environment(std::vector<Runtime_environment> *environments,
+                                                        size_t polygon_index,
+                                                        Runtime_environment &fallback);
+
+        /**
+         * Adds the result of a single polygon to the total.
+         *
+         * @param total The total result, stored at index 0 of the result vector
+         * @param result The result of a single polygon
+         */
+        static void add_to_total(Result &total, const Result &result);
+
+        /**
+         * @param times The execution times of the measured runs, sorted in place
+         * @return Their statistics
+         */
+        static Timing calculate_timing(std::vector<nanos> &times);
+
+        /**
+         * @return Whether the polygon is a hole-free rectangle, which is skipped
+         */
+        static bool is_trivial(const Polygon_with_holes &polygon);
     };
 }
 
@@ -0,0 +1,131 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "area_index.h"
+
+namespace cover {
+
+    namespace {
+        size_t lowest_bit(size_t i) {
+            return i & (~i + 1);
+        }
+
+        size_t fenwick_depth(size_t size) {
+            size_t depth{0};
+            for (; size > 0; size >>= 1) {
+                depth++;
+            }
+            return depth;
+        }
+    }
+
+    bool Area_index::allocate(const BaseRectGraph &graph, size_t max_cells) {
+        clear();
+
+        const auto &x_coordinates{graph.getXCoordinates()};
+        const auto &y_coordinates{graph.getYCoordinates()};
+        if (x_coordinates.size() < 2 || y_coordinates.size() < 2) {
+            return false;
+        }
+        const auto grid_columns{x_coordinates.size() - 1};
+        const auto grid_rows{y_coordinates.size() - 1};
+        if (grid_columns > max_cells / grid_rows) {
+            return false;
+        }
+
+        columns = grid_columns;
+        rows = grid_rows;
+        query_steps = 4 * fenwick_depth(columns) * fenwick_depth(rows);
+        tree.assign(columns * rows, 0);
+        return true;
+    }
+
+    void Area_index::accumulate() {
+        // the standard linear Fenwick construction, pushing every node into its parent, once per dimension
+        for (size_t y = 0; y < rows; y++) {
+            for (size_t x = 1; x <= columns; x++) {
+                const auto parent{x + lowest_bit(x)};
+                if (parent <= columns) {
+                    tree[y * columns + parent - 1] += tree[y * columns + x - 1];
+                }
+            }
+        }
+        for (size_t y = 1; y <= rows; y++) {
+            const auto parent{y + lowest_bit(y)};
+            if (parent > rows) {
+                continue;
+            }
+            for (size_t x = 0; x < columns; x++) {
+                tree[(parent - 1) * columns + x] += tree[(y - 1) * columns + x];
+            }
+        }
+    }
+
+    size_t Area_index::estimate_memory(const BaseRectGraph &graph, size_t max_cells) {
+        const auto &x_coordinates{graph.getXCoordinates()};
+        const auto &y_coordinates{graph.getYCoordinates()};
+        if (x_coordinates.size() < 2 || y_coordinates.size() < 2) {
+            return 0;
+        }
+        const auto grid_columns{x_coordinates.size() - 1};
+        const auto grid_rows{y_coordinates.size() - 1};
+        return grid_columns > max_cells / grid_rows ? 0 : grid_columns * grid_rows * sizeof(WeightType);
+    }
+
+    void Area_index::clear() {
+        columns = 0;
+        rows = 0;
+        query_steps = 0;
+        tree.clear();
+        tree.shrink_to_fit();
+    }
+
+    void Area_index::add(const BaseRectGraph &graph, BaseRectNode::PtrType node, WeightType delta) {
+        assert(!empty());
+        const auto &compact{graph.get_compact_rectangle(node)};
+        for (size_t y = compact.min_y + 1; y <= rows; y += lowest_bit(y)) {
+            for (size_t x = compact.min_x + 1; x <= columns; x += lowest_bit(x)) {
+                tree[(y - 1) * columns + x - 1] += delta;
+            }
+        }
+    }
+
+    Area_index::WeightType Area_index::sum_within(const CompactRectangle &rectangle) const {
+        assert(!empty());
+        return prefix(rectangle.max_x, rectangle.max_y) - prefix(rectangle.min_x, rectangle.max_y) -
+               prefix(rectangle.max_x, rectangle.min_y) + prefix(rectangle.min_x, rectangle.min_y);
+    }
+
+    Area_index::WeightType Area_index::prefix(size_t x, size_t y) const {
+        WeightType sum{0};
+        for (auto row = y; row > 0; row -= lowest_bit(row)) {
+            for (auto column = x; column > 0; column -= lowest_bit(column)) {
+                sum += tree[(row - 1) * columns + column - 1];
+            }
+        }
+        return sum;
+    }
+
+} // cover
@@ -0,0 +1,140 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef AREA_INDEX_H
+#define AREA_INDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "baserect_graph.h"
+
+namespace cover {
+
+    /**
+     * @brief Sums weights of base rectangles over unions of base rectangles in O(log^2 n)
+     *
+     * Every base rectangle of a polygon is assigned a weight, e.g. its area while it is uncovered, which is stored in
+     * the cell of the compressed grid at its bottom left corner. A rectangle which is a union of base rectangles
+     * contains a base rectangle if and only if it contains that cell, so summing the cells within the rectangle sums
+     * the weights of the base rectangles it consists of. The cells are kept in a 2D Fenwick tree, so both changing
+     * the weight of a base rectangle and summing over a rectangle take O(log(columns) * log(rows)) steps, compared to
+     * walking all of the rectangle's base rectangles through the graph.
+     *
+     * Grids with more than max_cells cells are not materialized, the index then stays empty and callers have to walk
+     * the graph instead.
+     */
+    class Area_index {
+    public:
+        using WeightType = int64_t;
+
+        static constexpr size_t DEFAULT_MAX_CELLS{size_t{1} << 24};
+
+        /**
+         * Builds the index for the graph's base rectangles in time linear in the number of grid cells.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param weight_of A callable returning the initial weight of the base rectangle with the given index
+         * @param max_cells The maximum number of grid cells to materialize
+         * @return Whether the index was built, false if the grid has more than max_cells cells
+         */
+        template<class Weight>
+        bool build(const BaseRectGraph &graph, Weight &&weight_of, size_t max_cells = DEFAULT_MAX_CELLS) {
+            if (!allocate(graph, max_cells)) {
+                return false;
+            }
+            const auto &compact_nodes{graph.getCompactNodes()};
+            for (BaseRectNode::PtrType node = 0; node < compact_nodes.size(); node++) {
+                tree[compact_nodes[node].min_y * columns + compact_nodes[node].min_x] +=
+                        static_cast<WeightType>(weight_of(node));
+            }
+            accumulate();
+            return true;
+        }
+
+        [[nodiscard]] bool empty() const { return tree.empty(); }
+
+        void clear();
+
+        /**
+         * @return The bytes held by the cells of the index
+         */
+        [[nodiscard]] size_t memory_usage() const { return tree.capacity() * sizeof(WeightType); }
+
+        /**
+         * Returns the bytes build() would hold for the graph, without building the index.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param max_cells The maximum number of grid cells to materialize
+         * @return The bytes of the cells, 0 if the grid has more than max_cells cells
+         */
+        [[nodiscard]] static size_t estimate_memory(const BaseRectGraph &graph, size_t max_cells = DEFAULT_MAX_CELLS);
+
+        /**
+         * Changes the weight of a base rectangle.
+         *
+         * @param graph The base rectangle graph the index was built for
+         * @param node The index of the base rectangle
+         * @param delta The amount to add to the weight of the base rectangle
+         */
+        void add(const BaseRectGraph &graph, BaseRectNode::PtrType node, WeightType delta);
+
+        /**
+         * @param rectangle A union of base rectangles in compressed coordinates
+         * @return The sum of the weights of the base rectangles within the rectangle
+         */
+        [[nodiscard]] WeightType sum_within(const CompactRectangle &rectangle) const;
+
+        /**
+         * Returns whether summing over the rectangle with the index is expected to be cheaper than walking its base
+         * rectangles, which takes at most one step per grid cell within the rectangle.
+         *
+         * @param rectangle A rectangle in compressed coordinates
+         * @return Whether sum_within should be preferred over walking the graph
+         */
+        [[nodiscard]] bool is_cheaper_than_walk(const CompactRectangle &rectangle) const {
+            return !empty() && static_cast<size_t>(rectangle.max_x - rectangle.min_x) *
+                               (rectangle.max_y - rectangle.min_y) > query_steps;
+        }
+
+    private:
+        size_t columns{0};
+        size_t rows{0};
+        // steps of the four prefix queries making up sum_within
+        size_t query_steps{0};
+        // Fenwick tree over the cells, row by row, entry y * columns + x belongs to the 1-based node (x + 1, y + 1)
+        std::vector<WeightType> tree;
+
+        bool allocate(const BaseRectGraph &graph, size_t max_cells);
+
+        void accumulate();
+
+        // sum over the cells with column below x and row below y
+        [[nodiscard]] WeightType prefix(size_t x, size_t y) const;
+    };
+
+} // cover
+
+#endif //AREA_INDEX_H
@@ -0,0 +1,69 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "arena.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace cover {
+    void Arena::reset() {
+        if (blocks.size() > 1) {
+            const auto total{capacity()};
+            blocks.clear();
+            blocks.push_back({std::make_unique<std::byte[]>(total), total});
+        }
+        current = 0;
+        offset = 0;
+        used_bytes = 0;
+    }
+
+    size_t Arena::capacity() const {
+        return std::accumulate(blocks.begin(), blocks.end(), size_t{0},
+                               [](size_t sum, const Block &block) { return sum + block.size; });
+    }
+
+    void *Arena::do_allocate(size_t bytes, size_t alignment) {
+        while (true) {
+            if (current == blocks.size()) {
+                // blocks grow geometrically, so the number of blocks stays logarithmic in the memory used
+                const auto size{std::max({bytes + alignment, initial_block_size,
+                                          blocks.empty() ? size_t{0} : 2 * blocks.back().size})};
+                blocks.push_back({std::make_unique<std::byte[]>(size), size});
+            }
+
+            auto &block{blocks[current]};
+            void *position{block.data.get() + offset};
+            auto space{block.size - offset};
+            if (std::align(alignment, bytes, position, space) != nullptr) {
+                offset = block.size - space + bytes;
+                used_bytes += bytes;
+                return position;
+            }
+            ++current;
+            offset = 0;
+        }
+    }
+}
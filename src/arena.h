@@ -0,0 +1,100 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace cover {
+
+    /**
+     * @brief Monotonic memory resource for the scratch containers of a single run, which keeps its memory when reset
+     *
+     * Allocations are carved from a list of blocks and never freed individually, reset() makes all blocks available
+     * again at once. Algorithms which run on many small polygons in a row thus stop allocating as soon as the arena
+     * has grown to the size the largest polygon needs. All containers using the arena must be destroyed before it is
+     * reset or moved. The arena is not thread safe.
+     */
+    class Arena : public std::pmr::memory_resource {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE{size_t{1} << 16};
+
+        explicit Arena(size_t initial_block_size = DEFAULT_BLOCK_SIZE) : initial_block_size(initial_block_size) {}
+
+        // copies start out empty, memory handed out by an arena is only ever used by its owner
+        Arena(const Arena &other) : Arena(other.initial_block_size) {}
+        Arena &operator=(const Arena &) { return *this; }
+        Arena(Arena &&) noexcept = default;
+        Arena &operator=(Arena &&) noexcept = default;
+
+        /**
+         * Makes all memory available again. If more than one block was needed since the last reset, the blocks are
+         * replaced by a single block of their total size, so the next run of the same size needs a single block.
+         */
+        void reset();
+
+        /**
+         * @return The total size of all blocks
+         */
+        [[nodiscard]] size_t capacity() const;
+
+        /**
+         * @return The number of bytes handed out since the last reset
+         */
+        [[nodiscard]] size_t used() const { return used_bytes; }
+
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        size_t initial_block_size;
+        std::vector<Block> blocks;
+        size_t current{0};
+        size_t offset{0};
+        size_t used_bytes{0};
+
+        void *do_allocate(size_t bytes, size_t alignment) override;
+
+        void do_deallocate(void *, size_t, size_t) override {}
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    /**
+     * Vector whose memory is drawn from an Arena, for scratch space which only lives during a single run.
+     */
+    template<typename T>
+    using Arena_vector = std::pmr::vector<T>;
+}
+
+#endif //ARENA_H
@@ -0,0 +1,98 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "base_rectangle_coverage.h"
+
+#include <limits>
+#include <stdexcept>
+
+#include "logging.h"
+
+namespace cover {
+    template<class Update>
+    void Base_rectangle_coverage::update(const BaseRectGraph &graph, const Rectangle &rectangle, Update &&visit) {
+        // the point coverage is never maintained incrementally
+        stale |= POINTS;
+        if (!is_valid(BASE_RECTANGLES)) {
+            return;
+        }
+
+        const auto top_right{graph.find_top_right(rectangle.get_top_right())};
+        const auto bottom_left{graph.find_bottom_left(rectangle.get_bottom_left())};
+        if (top_right == BaseRectNode::NO_NEIGHBOR || bottom_left == BaseRectNode::NO_NEIGHBOR) {
+            LOG(debug) << "Rectangle " << rectangle.as_polygon() << " is not a union of base rectangles, "
+                       << "invalidating the base rectangle coverage";
+            invalidate(BASE_RECTANGLES);
+            return;
+        }
+
+        for (auto it{graph.begin(top_right, bottom_left)}; it != graph.end(); ++it) {
+            LOG(trace) << "Base rectangle " << *it << " is covered.\n";
+            assert(rectangle.fully_contains(graph.getNodes()[*it].base_rectangle));
+            visit(*it);
+        }
+    }
+
+    void Base_rectangle_coverage::build(const BaseRectGraph &graph, const std::vector<Rectangle> &cover) {
+        counts.assign(graph.getNodes().size(), 0);
+        stale = POINTS;
+        for (const auto &rectangle: cover) {
+            LOG(debug) << "Computing base rectangles covered by rectangle " << rectangle.as_polygon() << "...\n";
+            update(graph, rectangle, [this](BaseRectNode::PtrType node) {
+                assert(counts[node] < std::numeric_limits<CountType>::max());
+                ++counts[node];
+            });
+            if (!is_valid(BASE_RECTANGLES)) {
+                throw std::runtime_error("Cover contains a rectangle which is not a union of base rectangles");
+            }
+        }
+    }
+
+    void Base_rectangle_coverage::add(const BaseRectGraph &graph, const Rectangle &rectangle) {
+        update(graph, rectangle, [this](BaseRectNode::PtrType node) {
+            assert(counts[node] < std::numeric_limits<CountType>::max());
+            ++counts[node];
+        });
+    }
+
+    void Base_rectangle_coverage::remove(const BaseRectGraph &graph, const Rectangle &rectangle) {
+        update(graph, rectangle, [this](BaseRectNode::PtrType node) {
+            assert(counts[node] > 0);
+            --counts[node];
+        });
+    }
+
+    void Base_rectangle_coverage::invalidate(Kind kinds) {
+        stale |= kinds;
+        if (kinds & BASE_RECTANGLES) {
+            counts.clear();
+        }
+    }
+
+    void Base_rectangle_coverage::clear() {
+        counts.clear();
+        stale = ALL;
+    }
+}
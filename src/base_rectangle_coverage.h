@@ -0,0 +1,137 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BASE_RECTANGLE_COVERAGE_H
+#define BASE_RECTANGLE_COVERAGE_H
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "baserect_graph.h"
+
+namespace cover {
+
+    /**
+     * @brief Counts how many rectangles of a cover contain each base rectangle of the polygon
+     *
+     * The counts are built once from a cover and then kept up to date by the postprocessors through add and remove
+     * deltas, so a chain of postprocessors only pays for the rectangles it actually changes instead of rescanning the
+     * whole cover each time.
+     *
+     * Each kind of coverage data derived from the cover is invalidated separately: the base rectangle counts stay
+     * valid as long as every change to the cover is reported, while the per-point coverage passed along the
+     * postprocessor chain is not maintained and becomes stale with the first change.
+     */
+    class Base_rectangle_coverage {
+    public:
+        using CountType = uint32_t;
+
+        /**
+         * The kinds of coverage data derived from the cover.
+         */
+        enum Kind : uint8_t {
+            // how many cover rectangles contain each base rectangle, i.e. the counts held here
+            BASE_RECTANGLES = 1 << 0,
+            // how many cover rectangles contain each point of the polygon
+            POINTS = 1 << 1,
+            ALL = BASE_RECTANGLES | POINTS
+        };
+
+        /**
+         * Counts the base rectangles contained in the rectangles of the cover and marks the counts as valid.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param cover The cover to count, all rectangles need to be unions of base rectangles
+         */
+        void build(const BaseRectGraph &graph, const std::vector<Rectangle> &cover);
+
+        /**
+         * Records that the rectangle was added to the cover. Invalidates the counts if the rectangle is not a union
+         * of base rectangles.
+         *
+         * @param graph The base rectangle graph the counts were built for
+         * @param rectangle The rectangle added to the cover
+         */
+        void add(const BaseRectGraph &graph, const Rectangle &rectangle);
+
+        /**
+         * Records that the rectangle was removed from the cover. Invalidates the counts if the rectangle is not a
+         * union of base rectangles.
+         *
+         * @param graph The base rectangle graph the counts were built for
+         * @param rectangle The rectangle removed from the cover
+         */
+        void remove(const BaseRectGraph &graph, const Rectangle &rectangle);
+
+        /**
+         * Records that a cover rectangle no longer contains the given base rectangle, e.g. because it was trimmed.
+         *
+         * @param node The base rectangle
+         */
+        void decrement(BaseRectNode::PtrType node) {
+            assert(counts[node] > 0);
+            --counts[node];
+            stale |= POINTS;
+        }
+
+        /**
+         * @param node A base rectangle
+         * @return The number of cover rectangles containing the base rectangle
+         */
+        [[nodiscard]] CountType operator[](BaseRectNode::PtrType node) const { return counts[node]; }
+
+        [[nodiscard]] size_t size() const { return counts.size(); }
+
+        /**
+         * @param kind The kind of coverage data to check
+         * @return Whether the given kind of coverage data still matches the cover
+         */
+        [[nodiscard]] bool is_valid(Kind kind) const { return (stale & kind) == 0; }
+
+        /**
+         * Marks the given kinds of coverage data as no longer matching the cover.
+         *
+         * @param kinds The kinds of coverage data to invalidate
+         */
+        void invalidate(Kind kinds);
+
+        void clear();
+
+        /**
+         * @return The bytes held by the counts
+         */
+        [[nodiscard]] size_t memory_usage() const { return counts.capacity() * sizeof(CountType); }
+
+    private:
+        template<class Update>
+        void update(const BaseRectGraph &graph, const Rectangle &rectangle, Update &&visit);
+
+        std::vector<CountType> counts;
+        uint8_t stale{ALL};
+    };
+
+}
+#endif //BASE_RECTANGLE_COVERAGE_H
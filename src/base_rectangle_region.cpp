@@ -0,0 +1,170 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <numeric>
+#include <optional>
+
+#include <CGAL/Boolean_set_operations_2.h>
+
+#include "base_rectangle_region.h"
+#include "logging.h"
+
+namespace cover {
+    std::vector<Base_rectangle_region>
+    Base_rectangle_region::find_regions(const BaseRectGraph &graph, const std::vector<BaseRectNode::PtrType> &members) {
+        const auto& graph_nodes{ graph.getNodes() };
+        Set<BaseRectNode::PtrType> unvisited(members.begin(), members.end());
+
+        std::vector<Base_rectangle_region> regions{};
+        for (const auto seed : members) {
+            if (unvisited.erase(seed) == 0) {
+                continue;
+            }
+
+            auto& region{ regions.emplace_back() };
+            region.nodes.push_back(seed);
+            region.bounds = graph.get_compact_rectangle(seed);
+
+            // breadth first search, region.nodes doubles as the queue
+            for (size_t i = 0; i < region.nodes.size(); i++) {
+                const auto current{ region.nodes[i] };
+                const auto& compact{ graph.get_compact_rectangle(current) };
+                region.bounds.min_x = std::min(region.bounds.min_x, compact.min_x);
+                region.bounds.min_y = std::min(region.bounds.min_y, compact.min_y);
+                region.bounds.max_x = std::max(region.bounds.max_x, compact.max_x);
+                region.bounds.max_y = std::max(region.bounds.max_y, compact.max_y);
+
+                const auto& node{ graph_nodes[current] };
+                for (const auto neighbor : {node.left, node.right, node.top, node.bottom}) {
+                    if (neighbor != BaseRectNode::NO_NEIGHBOR && unvisited.erase(neighbor) > 0) {
+                        region.nodes.push_back(neighbor);
+                    }
+                }
+            }
+        }
+
+        return regions;
+    }
+
+    Polygon_with_holes Base_rectangle_region::to_polygon(const BaseRectGraph &graph) const {
+        using RankType = CompactRectangle::RankType;
+
+        // a side of a base rectangle on the boundary of the region, directed such that the region lies to its left
+        struct Boundary_edge {
+            RankType from_x, from_y, to_x, to_y;
+        };
+
+        const auto& graph_nodes{ graph.getNodes() };
+        const Set<BaseRectNode::PtrType> in_region(nodes.begin(), nodes.end());
+        const auto is_outside{ [&in_region](BaseRectNode::PtrType node) {
+            return node == BaseRectNode::NO_NEIGHBOR || in_region.count(node) == 0;
+        } };
+
+        std::vector<Boundary_edge> edges{};
+        for (const auto current : nodes) {
+            const auto& node{ graph_nodes[current] };
+            const auto& c{ graph.get_compact_rectangle(current) };
+            if (is_outside(node.bottom)) edges.push_back({c.min_x, c.min_y, c.max_x, c.min_y});
+            if (is_outside(node.right)) edges.push_back({c.max_x, c.min_y, c.max_x, c.max_y});
+            if (is_outside(node.top)) edges.push_back({c.max_x, c.max_y, c.min_x, c.max_y});
+            if (is_outside(node.left)) edges.push_back({c.min_x, c.max_y, c.min_x, c.min_y});
+        }
+
+        const auto key{ [](RankType x, RankType y) { return (static_cast<uint64_t>(x) << 32) | y; } };
+        std::vector<size_t> by_start(edges.size());
+        std::iota(by_start.begin(), by_start.end(), 0);
+        std::sort(by_start.begin(), by_start.end(), [&](size_t lhs, size_t rhs) {
+            return key(edges[lhs].from_x, edges[lhs].from_y) < key(edges[rhs].from_x, edges[rhs].from_y);
+        });
+
+        const auto direction{ [](RankType from, RankType to) { return (from < to) - (to < from); } };
+        const auto& xs{ graph.getXCoordinates() };
+        const auto& ys{ graph.getYCoordinates() };
+
+        std::vector<bool> used(edges.size(), false);
+        std::vector<Polygon> outer_boundaries{};
+        std::vector<Polygon> holes{};
+        for (const auto start : by_start) {
+            if (used[start]) {
+                continue;
+            }
+
+            Polygon ring{};
+            auto current{ start };
+            do {
+                used[current] = true;
+                const auto& edge{ edges[current] };
+                const auto dx{ direction(edge.from_x, edge.to_x) };
+                const auto dy{ direction(edge.from_y, edge.to_y) };
+
+                // two edges only leave a vertex where two parts of the region touch diagonally, which always
+                // separates two parts of its complement; turning right there keeps each ring around one of them
+                const auto end_key{ key(edge.to_x, edge.to_y) };
+                auto it{ std::lower_bound(by_start.begin(), by_start.end(), end_key, [&](size_t e, uint64_t k) {
+                    return key(edges[e].from_x, edges[e].from_y) < k;
+                }) };
+                std::optional<size_t> next{};
+                for (; it != by_start.end() && key(edges[*it].from_x, edges[*it].from_y) == end_key; ++it) {
+                    const auto& candidate{ edges[*it] };
+                    const auto turns_right{ direction(candidate.from_x, candidate.to_x) == dy
+                                            && direction(candidate.from_y, candidate.to_y) == -dx };
+                    if (!next.has_value() || turns_right) {
+                        next = *it;
+                    }
+                }
+                assert(next.has_value());
+
+                const auto& following{ edges[*next] };
+                if (direction(following.from_x, following.to_x) != dx
+                    || direction(following.from_y, following.to_y) != dy) {
+                    ring.push_back(Point(xs[edge.to_x], ys[edge.to_y]));
+                }
+                current = *next;
+            } while (current != start);
+
+            if (ring.is_counterclockwise_oriented()) {
+                outer_boundaries.push_back(std::move(ring));
+            } else {
+                holes.push_back(std::move(ring));
+            }
+        }
+
+        if (outer_boundaries.size() == 1) {
+            return Polygon_with_holes(outer_boundaries.front(), holes.begin(), holes.end());
+        }
+
+        // the boundary of a connected region has a single counterclockwise ring, join the base rectangles otherwise
+        LOG(warning) << "Tracing a region yielded " << outer_boundaries.size() << " outer boundaries, joining instead";
+        std::vector<Polygon> as_polygons{};
+        for (const auto current : nodes) {
+            as_polygons.push_back(graph_nodes[current].base_rectangle.as_polygon());
+        }
+
+        std::vector<Polygon_with_holes> joined{};
+        CGAL::join(as_polygons.begin(), as_polygons.end(), std::back_inserter(joined), CGAL::Tag_false());
+        assert(joined.size() == 1);
+        return joined.front();
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BASE_RECTANGLE_REGION_H
+#define BASE_RECTANGLE_REGION_H
+
+#include <vector>
+
+#include "CGAL_classes.h"
+#include "baserect_graph.h"
+#include "datastructures.h"
+
+namespace cover {
+
+    /**
+     * @brief A set of base rectangles of a polygon which are connected via shared sides
+     *
+     * Holds the base rectangles together with their bounding box in compressed coordinates. Regions are used to
+     * re-cover parts of a polygon, e.g. the base rectangles a rectangle of the cover covers uniquely or the ones no
+     * rectangle of a previous cover covers anymore.
+     */
+    struct Base_rectangle_region {
+        std::vector<BaseRectNode::PtrType> nodes;
+        CompactRectangle bounds;
+
+        /**
+         * Groups the given base rectangles into maximal connected regions by walking the neighbour links of the base
+         * rectangle graph. As base rectangles always share whole sides with their neighbours, two base rectangles
+         * touch along a side iff they are linked.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param members The base rectangles to group
+         * @return The connected regions of the given base rectangles
+         */
+        [[nodiscard]] static std::vector<Base_rectangle_region>
+        find_regions(const BaseRectGraph &graph, const std::vector<BaseRectNode::PtrType> &members);
+
+        /**
+         * Traces the boundary of the region along the sides of its base rectangles which do not border another base
+         * rectangle of the region. Runs in time linear in the size of the region, up to sorting the boundary.
+         *
+         * @param graph The base rectangle graph the region belongs to
+         * @return The region as polygon, with a counterclockwise outer boundary and clockwise holes
+         */
+        [[nodiscard]] Polygon_with_holes to_polygon(const BaseRectGraph &graph) const;
+    };
+}
+
+#endif //BASE_RECTANGLE_REGION_H
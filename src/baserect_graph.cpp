@@ -24,6 +24,7 @@
  */
 
 #include "baserect_graph.h"
+#include "profile.h"
 #include <algorithm>
 #include <iostream>
 #include <limits>
@@ -36,6 +37,7 @@ void BaseRectGraph::build(const Polygon_with_holes &polygon) {
 }
 
 void BaseRectGraph::build(std::vector<Rectangle> base_rectangles) {
+    PROFILE_SCOPE("graph_build");
 
     LOG(info) << "Building base rect graph with " << base_rectangles.size() << " node(s)...";
 
@@ -54,26 +56,99 @@ void BaseRectGraph::build(std::vector<Rectangle> base_rectangles) {
             });
 
     for (const auto &rectangle : base_rectangles) {
-        const auto id = nodes.size();
+        x_coordinates.push_back(rectangle.get_min_x());
+        x_coordinates.push_back(rectangle.get_max_x());
+        y_coordinates.push_back(rectangle.get_min_y());
+        y_coordinates.push_back(rectangle.get_max_y());
+    }
+    for (auto *coordinates : {&x_coordinates, &y_coordinates}) {
+        std::sort(coordinates->begin(), coordinates->end());
+        coordinates->erase(std::unique(coordinates->begin(), coordinates->end()), coordinates->end());
+    }
+    assert(std::max(x_coordinates.size(), y_coordinates.size())
+           <= std::numeric_limits<CompactRectangle::RankType>::max());
+    compact_nodes.reserve(base_rectangles.size());
+    for (const auto &rectangle : base_rectangles) {
+        compact_nodes.push_back(to_compact_rectangle(rectangle));
         nodes.emplace_back(rectangle);
-        auto &node = nodes.back();
-        auto tl = rectangle.get_top_left();
-        auto left = topRight.find(tl);
-        if (left != topRight.end()) {
-            node.left = left->second;
-            nodes[node.left].right = id;
+    }
+    build_corner_tables();
+
+    // the left neighbor has its top right and the top neighbor its bottom left corner in the top left corner
+    for (BaseRectNode::PtrType id = 0; id < nodes.size(); id++) {
+        auto &node = nodes[id];
+        const auto &compact = compact_nodes[id];
+        const auto left = top_right_corners.find(compact.min_x, compact.max_y);
+        if (left != BaseRectNode::NO_NEIGHBOR) {
+            node.left = left;
+            nodes[left].right = id;
         }
-        auto top = bottomLeft.find(tl);
-        if (top != bottomLeft.end()) {
-            node.top = top->second;
-            nodes[node.top].bottom = id;
+        const auto top = bottom_left_corners.find(compact.min_x, compact.max_y);
+        if (top != BaseRectNode::NO_NEIGHBOR) {
+            node.top = top;
+            nodes[top].bottom = id;
         }
-        bottomLeft[rectangle.get_bottom_left()] = id;
-        topRight[rectangle.get_top_right()] = id;
     }
     LOG(info) << "Base rect graph has been built.";
 }
 
+void BaseRectGraph::restore(std::vector<BaseRectNode> restored_nodes,
+                            std::vector<CompactRectangle> restored_compact_nodes,
+                            std::vector<NumType> restored_x_coordinates,
+                            std::vector<NumType> restored_y_coordinates) {
+    assert(restored_nodes.size() == restored_compact_nodes.size());
+    clear();
+    nodes = std::move(restored_nodes);
+    compact_nodes = std::move(restored_compact_nodes);
+    x_coordinates = std::move(restored_x_coordinates);
+    y_coordinates = std::move(restored_y_coordinates);
+    build_corner_tables();
+    LOG(info) << "Base rect graph with " << nodes.size() << " node(s) has been restored.";
+}
+
+void BaseRectGraph::build_corner_tables() {
+    top_right_corners.build(compact_nodes, CornerTable::Corner::TOP_RIGHT,
+                            x_coordinates.size(), y_coordinates.size());
+    bottom_left_corners.build(compact_nodes, CornerTable::Corner::BOTTOM_LEFT,
+                              x_coordinates.size(), y_coordinates.size());
+}
+
+void CornerTable::build(const std::vector<CompactRectangle> &compact_nodes, Corner corner,
+                        size_t x_count, size_t y_count) {
+    assert(compact_nodes.size() < std::numeric_limits<uint32_t>::max());
+    const auto top_right = corner == Corner::TOP_RIGHT;
+    const auto x_of = [top_right](const CompactRectangle &node) { return top_right ? node.max_x : node.min_x; };
+    const auto y_of = [top_right](const CompactRectangle &node) { return top_right ? node.max_y : node.min_y; };
+
+    std::vector<uint32_t> y_offsets(y_count + 1, 0);
+    for (const auto &node : compact_nodes) {
+        ++y_offsets[y_of(node) + 1];
+    }
+    for (size_t y = 1; y < y_offsets.size(); y++) {
+        y_offsets[y] += y_offsets[y - 1];
+    }
+    std::vector<uint32_t> by_y(compact_nodes.size());
+    for (uint32_t id = 0; id < compact_nodes.size(); id++) {
+        by_y[y_offsets[y_of(compact_nodes[id])]++] = id;
+    }
+
+    offsets.assign(x_count + 1, 0);
+    for (const auto &node : compact_nodes) {
+        ++offsets[x_of(node) + 1];
+    }
+    for (size_t x = 1; x < offsets.size(); x++) {
+        offsets[x] += offsets[x - 1];
+    }
+    auto insert_positions {offsets};
+    y_ranks.resize(compact_nodes.size());
+    ids.resize(compact_nodes.size());
+    for (const auto id : by_y) {
+        const auto position = insert_positions[x_of(compact_nodes[id])]++;
+        y_ranks[position] = y_of(compact_nodes[id]);
+        ids[position] = id;
+    }
+}
+
 BaseRectGraph::BaseRectGraph(const Polygon_with_holes &polygon) {
   build(polygon);
 }
@@ -99,43 +174,40 @@ std::vector<size_t> BaseRectGraph::get_node_heights() const {
 
 std::vector<cover::Rectangle> BaseRectGraph::get_all_rectangles() const {
     std::vector<Rectangle> rectangles;
-    const auto &heights {get_node_heights()};
-    for (size_t i = 0; i < nodes.size(); i++) {
-        const auto &node = nodes[i];
-        LOG(trace) << "Enumerating rectangles with top right base rectangle " << node.base_rectangle;
-        const auto tr {node.base_rectangle.get_top_right()};
-        auto max_height = heights[i];
-        auto left {i};
-        while (left != BaseRectNode::NO_NEIGHBOR)  {
-            max_height = std::min(heights[left], max_height);
-            LOG(trace) << "  Going left. Max height is now " << max_height;
-            auto down {left};
-            for (size_t h = 0; h <= max_height; h++) {
-                rectangles.push_back({nodes[down].base_rectangle.get_bottom_left(), tr});
-                LOG(trace) << "  Added rectangle " << rectangles.back();
-                down = nodes[down].bottom;
-            }
-            left = nodes[left].left;
-       }
-    }
+    for_each_rectangle([&](BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left) {
+        rectangles.push_back(get_rectangle(top_right, bottom_left));
+        LOG(trace) << "  Added rectangle " << rectangles.back();
+    });
     return rectangles;
 }
 
 size_t BaseRectGraph::count_all_rectangles() const {
-    size_t rectangle_count {0};
+    return count_all_candidates().rectangles;
+}
+
+BaseRectGraph::Candidate_counts BaseRectGraph::count_all_candidates() const {
+    Candidate_counts counts {};
     const auto &heights {get_node_heights()};
     for (size_t i = 0; i < nodes.size(); i++) {
-        const auto &node = nodes[i];
-        const auto tr {node.base_rectangle.get_top_right()};
         auto max_height = heights[i];
+        size_t columns {1};
         auto left {i};
-        while (left != BaseRectNode::NO_NEIGHBOR)  {
+        while (left != BaseRectNode::NO_NEIGHBOR) {
             max_height = std::min(heights[left], max_height);
-            rectangle_count += max_height + 1;
+            counts.rectangles += max_height + 1;
+            // the rectangles of 1 to max_height + 1 rows spanning these columns
+            counts.incidences += columns * (max_height + 1) * (max_height + 2) / 2;
             left = nodes[left].left;
-       }
+            columns++;
+        }
     }
-    return rectangle_count;
+    return counts;
+}
+
+size_t BaseRectGraph::memory_usage() const {
+    return nodes.capacity() * sizeof(BaseRectNode) + compact_nodes.capacity() * sizeof(CompactRectangle)
+           + (x_coordinates.capacity() + y_coordinates.capacity()) * sizeof(NumType)
+           + bottom_left_corners.memory_usage() + top_right_corners.memory_usage();
 }
 
 
@@ -159,7 +231,7 @@ BaseRectGraph::get_all_rectangles_within(const Point &top_right,
 }
 
 std::vector<cover::Rectangle> BaseRectGraph::get_maximal_rectangles() const {
-  Set<Rectangle> rectangles;
+  Set<CompactRectangle> rectangles;
   const auto &heights{get_node_heights()};
   for (size_t i = 0; i < nodes.size(); i++) {
     if (nodes[i].top != BaseRectNode::NO_NEIGHBOR) {
@@ -192,15 +264,19 @@ std::vector<cover::Rectangle> BaseRectGraph::get_maximal_rectangles() const {
           assert(bottomLeft != BaseRectNode::NO_NEIGHBOR);
           bottomLeft = nodes[bottomLeft].bottom;
         }
-        const Rectangle rect{nodes[bottomLeft].base_rectangle.get_bottom_left(),
-                             nodes[right].base_rectangle.get_top_right()};
+        const auto rect{get_compact_rectangle(right, bottomLeft)};
 
-        LOG(debug) << "Found maximal rectangle " << rect;
+        LOG(debug) << "Found maximal rectangle " << to_rectangle(rect);
         rectangles.insert(rect);
       }
     }
   }
-  return { rectangles.begin(), rectangles.end() };
+  std::vector<Rectangle> maximal_rectangles;
+  maximal_rectangles.reserve(rectangles.size());
+  for (const auto &rect : rectangles) {
+    maximal_rectangles.push_back(to_rectangle(rect));
+  }
+  return maximal_rectangles;
 }
 
 } // cover
\ No newline at end of file
@@ -28,8 +28,12 @@
 
 #include "CGAL_classes.h"
 #include "rectangle.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <limits>
 #include <iterator>
+#include <vector>
 
 namespace cover {
 
@@ -45,9 +49,91 @@ struct BaseRectNode {
     BaseRectNode(const Rectangle &rect) : base_rectangle(rect) {}
 };
 
+/**
+ * A rectangle expressed via the ranks of its coordinates among the distinct x
+ * and y coordinates of the base rectangles of a polygon.
+ */
+struct CompactRectangle {
+    using RankType = uint32_t;
+    RankType min_x;
+    RankType min_y;
+    RankType max_x;
+    RankType max_y;
+
+    bool operator==(const CompactRectangle &other) const {
+        return min_x == other.min_x && min_y == other.min_y
+            && max_x == other.max_x && max_y == other.max_y;
+    }
+};
+
+/**
+ * Maps the top right or the bottom left corners of the base rectangles,
+ * given by the ranks of their coordinates, to the base rectangles.
+ *
+ * The corners are stored sorted by x rank and then by y rank, and an offset
+ * table holds where the corners of each x rank start, so a lookup indexes the
+ * offsets and searches the few corners sharing the x rank, without hashing.
+ */
+class CornerTable {
+public:
+    using RankType = CompactRectangle::RankType;
+    enum class Corner { TOP_RIGHT, BOTTOM_LEFT };
+
+    /**
+     * Sorts the corners with two counting sort passes, by y rank and then
+     * stably by x rank, which takes time linear in the number of base
+     * rectangles and coordinates.
+     *
+     * @param compact_nodes The base rectangles in compressed coordinates
+     * @param corner The corner of the base rectangles to store
+     * @param x_count The number of distinct x coordinates
+     * @param y_count The number of distinct y coordinates
+     */
+    void build(const std::vector<CompactRectangle> &compact_nodes, Corner corner, size_t x_count, size_t y_count);
+
+    /**
+     * @param x The x rank of the corner
+     * @param y The y rank of the corner
+     * @return The base rectangle with its corner at the given ranks, or
+     * BaseRectNode::NO_NEIGHBOR if there is none
+     */
+    [[nodiscard]] BaseRectNode::PtrType find(RankType x, RankType y) const {
+      if (static_cast<size_t>(x) + 1 >= offsets.size()) {
+        return BaseRectNode::NO_NEIGHBOR;
+      }
+      const auto first {y_ranks.cbegin() + offsets[x]};
+      const auto last {y_ranks.cbegin() + offsets[x + 1]};
+      const auto it {std::lower_bound(first, last, y)};
+      if (it == last || *it != y) {
+        return BaseRectNode::NO_NEIGHBOR;
+      }
+      return ids[it - y_ranks.cbegin()];
+    }
+
+    [[nodiscard]] size_t size() const { return ids.size(); }
+
+    /**
+     * @return The number of bytes held by the table
+     */
+    [[nodiscard]] size_t memory_usage() const {
+      return offsets.capacity() * sizeof(uint32_t) + y_ranks.capacity() * sizeof(RankType)
+             + ids.capacity() * sizeof(uint32_t);
+    }
+
+    void clear() {
+      offsets.clear();
+      y_ranks.clear();
+      ids.clear();
+    }
+
+private:
+    std::vector<uint32_t> offsets;
+    std::vector<RankType> y_ranks;
+    std::vector<uint32_t> ids;
+};
+
 class BaseRectGraph {
 public:
-    using PointBaseRectMap = Map<Point, BaseRectNode::PtrType>;
 
   struct SuperRectangleIterator {
     using iterator_category = std::forward_iterator_tag;
@@ -101,11 +187,53 @@ public:
     void build(const Polygon_with_holes &polygon);
     void build(std::vector<Rectangle> base_rectangles);
 
+    /**
+     * Restores a graph from the state of a graph previously created by
+     * build(), e.g. when reading it back from a cache. Only the corner tables
+     * are recomputed.
+     *
+     * @param nodes The nodes including their neighbor links
+     * @param compact_nodes The nodes in compressed coordinates
+     * @param x_coordinates The sorted distinct x coordinates
+     * @param y_coordinates The sorted distinct y coordinates
+     */
+    void restore(std::vector<BaseRectNode> nodes,
+                 std::vector<CompactRectangle> compact_nodes,
+                 std::vector<NumType> x_coordinates,
+                 std::vector<NumType> y_coordinates);
+
     const std::vector<BaseRectNode> &getNodes() const { return nodes; }
-    const PointBaseRectMap &getBottomLeftMap() const { return bottomLeft; }
-    const PointBaseRectMap &getTopRightMap() const { return topRight; }
 
-    void clear() { nodes.clear(); bottomLeft.clear(); topRight.clear(); }
+    /**
+     * @param corner A point
+     * @return The base rectangle whose top right corner is the point, or
+     * BaseRectNode::NO_NEIGHBOR if there is none
+     */
+    [[nodiscard]] BaseRectNode::PtrType find_top_right(const Point &corner) const {
+      return find_corner(top_right_corners, corner);
+    }
+
+    /**
+     * @param corner A point
+     * @return The base rectangle whose bottom left corner is the point, or
+     * BaseRectNode::NO_NEIGHBOR if there is none
+     */
+    [[nodiscard]] BaseRectNode::PtrType find_bottom_left(const Point &corner) const {
+      return find_corner(bottom_left_corners, corner);
+    }
+
+    const std::vector<CompactRectangle> &getCompactNodes() const { return compact_nodes; }
+    const std::vector<NumType> &getXCoordinates() const { return x_coordinates; }
+    const std::vector<NumType> &getYCoordinates() const { return y_coordinates; }
+
+    void clear() {
+        nodes.clear();
+        compact_nodes.clear();
+        bottom_left_corners.clear();
+        top_right_corners.clear();
+        x_coordinates.clear();
+        y_coordinates.clear();
+    }
     [[nodiscard]] bool empty() const { return nodes.empty(); }
 
     /**
@@ -117,8 +245,25 @@ public:
      * @return an iterator over all base rectangles within the larger rectangle
      */
     SuperRectangleIterator begin(const Point &top_right,
-                                 const Point &bottom_left) {
-      return SuperRectangleIterator(topRight[top_right], bottom_left, nodes);
+                                 const Point &bottom_left) const {
+      const auto start {find_top_right(top_right)};
+      assert(start != BaseRectNode::NO_NEIGHBOR);
+      return SuperRectangleIterator(start, bottom_left, nodes);
+    }
+
+    /**
+     * Get an iterator for all base rectangles within the rectangle spanned by
+     * the top right corner of node top_right and the bottom left corner of
+     * node bottom_left.
+     *
+     * @param top_right The node in the top right corner of the rectangle
+     * @param bottom_left The node in the bottom left corner of the rectangle
+     * @return an iterator over all base rectangles within the larger rectangle
+     */
+    SuperRectangleIterator begin(BaseRectNode::PtrType top_right,
+                                 BaseRectNode::PtrType bottom_left) const {
+      return SuperRectangleIterator(
+          top_right, nodes[bottom_left].base_rectangle.get_bottom_left(), nodes);
     }
 
     /**
@@ -126,10 +271,110 @@ public:
      *
      * @return a past-the-end iterator
      */
-    SuperRectangleIterator end() {
+    SuperRectangleIterator end() const {
         return SuperRectangleIterator(nodes);
     }
 
+    /**
+     * Returns the rectangle spanned by the top right corner of node top_right
+     * and the bottom left corner of node bottom_left.
+     *
+     * @param top_right The node in the top right corner of the rectangle
+     * @param bottom_left The node in the bottom left corner of the rectangle
+     * @return The rectangle spanned by both nodes
+     */
+    [[nodiscard]] Rectangle get_rectangle(BaseRectNode::PtrType top_right,
+                                          BaseRectNode::PtrType bottom_left) const {
+      return {nodes[bottom_left].base_rectangle.get_bottom_left(),
+              nodes[top_right].base_rectangle.get_top_right()};
+    }
+
+    /**
+     * @param node The index of a node
+     * @return The rectangle of the node in compressed coordinates
+     */
+    [[nodiscard]] const CompactRectangle &get_compact_rectangle(BaseRectNode::PtrType node) const {
+      return compact_nodes[node];
+    }
+
+    /**
+     * Returns the rectangle spanned by the top right corner of node top_right
+     * and the bottom left corner of node bottom_left in compressed coordinates.
+     *
+     * @param top_right The node in the top right corner of the rectangle
+     * @param bottom_left The node in the bottom left corner of the rectangle
+     * @return The rectangle spanned by both nodes in compressed coordinates
+     */
+    [[nodiscard]] CompactRectangle get_compact_rectangle(BaseRectNode::PtrType top_right,
+                                                         BaseRectNode::PtrType bottom_left) const {
+      return {compact_nodes[bottom_left].min_x, compact_nodes[bottom_left].min_y,
+              compact_nodes[top_right].max_x, compact_nodes[top_right].max_y};
+    }
+
+    /**
+     * @param rectangle A rectangle in compressed coordinates
+     * @return The rectangle in the coordinates of the polygon
+     */
+    [[nodiscard]] Rectangle to_rectangle(const CompactRectangle &rectangle) const {
+      return {x_coordinates[rectangle.min_x], y_coordinates[rectangle.min_y],
+              x_coordinates[rectangle.max_x], y_coordinates[rectangle.max_y]};
+    }
+
+    /**
+     * @param rectangle A rectangle whose corners lie on the coordinates of the
+     * base rectangles
+     * @return The rectangle in compressed coordinates
+     */
+    [[nodiscard]] CompactRectangle to_compact_rectangle(const Rectangle &rectangle) const {
+      return {x_rank(rectangle.get_min_x()), y_rank(rectangle.get_min_y()),
+              x_rank(rectangle.get_max_x()), y_rank(rectangle.get_max_y())};
+    }
+
+    /**
+     * @param x An x coordinate of one of the base rectangles
+     * @return The rank of x among all distinct x coordinates
+     */
+    [[nodiscard]] CompactRectangle::RankType x_rank(const NumType &x) const {
+      return rank_of(x_coordinates, x);
+    }
+
+    /**
+     * @param y A y coordinate of one of the base rectangles
+     * @return The rank of y among all distinct y coordinates
+     */
+    [[nodiscard]] CompactRectangle::RankType y_rank(const NumType &y) const {
+      return rank_of(y_coordinates, y);
+    }
+
+    /**
+     * Calls visitor(top_right, bottom_left) for every possible union of base
+     * rectangles contained in the polygon which is itself a rectangle, without
+     * materializing these rectangles.
+     *
+     * The rectangles are visited in the same order as they are returned by
+     * get_all_rectangles().
+     *
+     * @param visitor A callable which receives the indices of the top right and
+     * the bottom left node of each rectangle
+     */
+    template <class Visitor>
+    void for_each_rectangle(Visitor &&visitor) const {
+        const auto heights {get_node_heights()};
+        for (BaseRectNode::PtrType i = 0; i < nodes.size(); i++) {
+            auto max_height = heights[i];
+            auto left {i};
+            while (left != BaseRectNode::NO_NEIGHBOR) {
+                max_height = std::min(heights[left], max_height);
+                auto down {left};
+                for (size_t h = 0; h <= max_height; h++) {
+                    visitor(i, down);
+                    down = nodes[down].bottom;
+                }
+                left = nodes[left].left;
+            }
+        }
+    }
+
     /**
      * Returns a vector containing at position i the height of node i.
      *
@@ -155,6 +400,36 @@ public:
      */
     size_t count_all_rectangles() const;
 
+    /**
+     * @brief The number of candidate rectangles of the graph and of the base
+     * rectangles they contain, see count_all_candidates()
+     */
+    struct Candidate_counts {
+        size_t rectangles{0};
+        size_t incidences{0};
+    };
+
+    /**
+     * Counts the rectangles like count_all_rectangles() and, in the same
+     * pass, estimates the total number of base rectangles they contain,
+     * i.e. the size of an index from each candidate to its base rectangles
+     * or the number of nonzeros of the covering constraints. The estimate
+     * is exact if the base rectangles to the left of and below each node
+     * form a grid.
+     *
+     * @return The number of rectangles and the estimated number of
+     * (rectangle, base rectangle) pairs
+     */
+    Candidate_counts count_all_candidates() const;
+
+    /**
+     * Returns the number of bytes held by the graph, which stays in memory as
+     * long as the polygon's runtime environment is kept.
+     *
+     * @return The number of bytes held by the graph
+     */
+    size_t memory_usage() const;
+
     /**
      * Returns a vector of all possible unions of base rectangles contained in
      * the rectangle specified by top right and bottom left corner.
@@ -174,9 +449,53 @@ public:
 
 private:
     std::vector<BaseRectNode> nodes;
-    Map<Point, BaseRectNode::PtrType> bottomLeft;
-    Map<Point, BaseRectNode::PtrType> topRight;
+    std::vector<CompactRectangle> compact_nodes;
+    std::vector<NumType> x_coordinates;
+    std::vector<NumType> y_coordinates;
+    CornerTable bottom_left_corners;
+    CornerTable top_right_corners;
+
+    /**
+     * Builds both corner tables from the compressed nodes.
+     */
+    void build_corner_tables();
+
+    /**
+     * @return The rank of the coordinate, or the largest rank if it is not a
+     * coordinate of the base rectangles
+     */
+    static CompactRectangle::RankType find_rank(const std::vector<NumType> &coordinates,
+                                                const NumType &coordinate) {
+      const auto it {std::lower_bound(coordinates.cbegin(), coordinates.cend(), coordinate)};
+      if (it == coordinates.cend() || *it != coordinate) {
+        return std::numeric_limits<CompactRectangle::RankType>::max();
+      }
+      return static_cast<CompactRectangle::RankType>(it - coordinates.cbegin());
+    }
+
+    [[nodiscard]] BaseRectNode::PtrType find_corner(const CornerTable &table, const Point &corner) const {
+      // a missing coordinate maps to a rank without any corners
+      return table.find(find_rank(x_coordinates, corner.x()), find_rank(y_coordinates, corner.y()));
+    }
+
+    static CompactRectangle::RankType rank_of(const std::vector<NumType> &coordinates,
+                                              const NumType &coordinate) {
+      const auto it {std::lower_bound(coordinates.cbegin(), coordinates.cend(), coordinate)};
+      assert(it != coordinates.cend() && *it == coordinate);
+      return static_cast<CompactRectangle::RankType>(it - coordinates.cbegin());
+    }
 };
 }
 
+namespace std {
+    template<>
+    struct hash<cover::CompactRectangle> {
+        size_t operator()(const cover::CompactRectangle &rectangle) const {
+            const uint64_t bottom_left {static_cast<uint64_t>(rectangle.min_x) << 32 | rectangle.min_y};
+            const uint64_t top_right {static_cast<uint64_t>(rectangle.max_x) << 32 | rectangle.max_y};
+            return hash<uint64_t>{}(bottom_left * 0x9e3779b97f4a7c15ULL ^ top_right);
+        }
+    };
+}  // std
+
 #endif // BASERECT_GRAPH_H
\ No newline at end of file
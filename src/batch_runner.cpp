@@ -0,0 +1,186 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "batch_runner.h"
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+#include "logging.h"
+#include "result_writer.h"
+
+using json = nlohmann::json;
+
+namespace cover {
+    namespace {
+        std::string format_time(const std::chrono::time_point<std::chrono::system_clock> &tp) {
+            const auto time_t = std::chrono::system_clock::to_time_t(tp);
+            std::stringstream s;
+            s << std::put_time(std::localtime(&time_t), "%Y-%m-%d %X");
+            return s.str();
+        }
+
+        Problem_instance::Costs parse_costs(const json &costs) {
+            if (!costs.is_array() || costs.size() != 2 || !costs[0].is_number_unsigned()
+                || !costs[1].is_number_unsigned()) {
+                throw std::runtime_error("costs must be pairs of non-negative integers");
+            }
+            return {costs[0].get<CostType>(), costs[1].get<CostType>()};
+        }
+    }
+
+    Batch_runner::Batch_runner(Provider_builder builder, bool verify,
+                               Algorithm_runner::Verification_method method, size_t threads, Run_options options,
+                               Result_writer::Output_options output_options)
+            : builder(std::move(builder)), verify(verify), method(method), threads(threads),
+              options(std::move(options)), output_options(output_options) {}
+
+    std::vector<Batch_runner::Entry> Batch_runner::read_manifest(const fs::path &manifest_path) {
+        std::ifstream manifest{manifest_path.string()};
+        if (!manifest) {
+            throw std::runtime_error("Manifest '" + manifest_path.string() + "' could not be opened");
+        }
+
+        std::vector<Entry> entries{};
+        std::string line{};
+        size_t line_number{0};
+        while (std::getline(manifest, line)) {
+            line_number++;
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+
+            try {
+                const auto record = json::parse(line);
+                Entry entry{};
+                entry.input = record.at("input").get<std::string>();
+                entry.algorithm = record.at("algorithm").get<std::string>();
+
+                const auto &costs{record.at("costs")};
+                if (!costs.empty() && costs[0].is_array()) {
+                    for (const auto &pair: costs) {
+                        entry.costs.push_back(parse_costs(pair));
+                    }
+                } else {
+                    entry.costs.push_back(parse_costs(costs));
+                }
+
+                if (record.contains("postprocessors")) {
+                    entry.postprocessors = record["postprocessors"].get<std::vector<std::string>>();
+                }
+                entries.push_back(std::move(entry));
+            } catch (const std::exception &e) {
+                throw std::runtime_error("Invalid manifest entry in line " + std::to_string(line_number) + " of '"
+                                         + manifest_path.string() + "': " + e.what());
+            }
+        }
+
+        return entries;
+    }
+
+    Batch_runner::Cached_instance &Batch_runner::get_instance(const fs::path &input) {
+        auto &cached{instances[input.string()]};
+        if (cached == nullptr) {
+            LOG(info) << "Reading instance " << input.string();
+            cached = std::make_unique<Cached_instance>(Cached_instance{{input, 0, 0}, {}});
+        }
+        return *cached;
+    }
+
+    int Batch_runner::run(const std::vector<Entry> &entries, const fs::path &output_path) {
+        auto parent_path{output_path.parent_path()};
+        if (!parent_path.empty() && !fs::exists(parent_path)) {
+            fs::create_directories(parent_path);
+        }
+
+        const bool csv{output_path.extension() == ".csv"};
+        Result_writer::check_csv_header(output_path, output_options);
+        const bool write_header{csv && !fs::exists(output_path)};
+        std::ofstream out{output_path.string(), csv ? std::ios_base::app : std::ios_base::trunc};
+        if (write_header) {
+            Result_writer::write_csv_header(out, output_options);
+        }
+
+        int retval{0};
+        size_t runs{0};
+        for (size_t i = 0; i < entries.size(); i++) {
+            const auto &entry{entries[i]};
+            auto &cached{get_instance(entry.input)};
+
+            std::stringstream ss;
+            ss << entry.algorithm;
+            for (const auto &postprocessor: entry.postprocessors) {
+                ss << "+" << postprocessor;
+            }
+            const auto algorithm_full_name{ss.str()};
+
+            const Algorithm_runner::Provider_factory factory{[&] {
+                return builder(entry.algorithm, entry.postprocessors);
+            }};
+            const auto provider{factory()};
+
+            for (const auto &costs: entry.costs) {
+                const Problem_instance instance{cached.instance, costs.creation_cost, costs.area_cost};
+                std::cout << "Entry " << (i + 1) << "/" << entries.size() << ": " << instance.get_name()
+                          << " with " << algorithm_full_name << ", costs (" << costs.creation_cost << ", "
+                          << costs.area_cost << ")" << std::endl;
+
+                const auto start{std::chrono::system_clock::now()};
+                const auto results{threads > 1
+                                   ? Algorithm_runner::run_algorithm(factory, instance, verify, threads, method,
+                                                                     options, &cached.environments)
+                                   : Algorithm_runner::run_algorithm(*provider, instance, verify, method,
+                                                                     options, &cached.environments)};
+                const auto end{std::chrono::system_clock::now()};
+
+                if (results[0].is_valid == Algorithm_runner::Result::Validity::INVALID) {
+                    retval |= 1;
+                    std::cerr << "WARNING: algorithm '" << algorithm_full_name << "' failed to cover instance '"
+                              << instance.get_name() << "' with creation cost " << costs.creation_cost
+                              << " and area cost " << costs.area_cost << std::endl;
+                } else if (results[0].is_valid == Algorithm_runner::Result::Validity::TIMEOUT) {
+                    retval |= 2;
+                    std::cerr << "WARNING: algorithm '" << algorithm_full_name << "' reached timeout on instance '"
+                              << instance.get_name() << "' with creation cost " << costs.creation_cost
+                              << " and area cost " << costs.area_cost << std::endl;
+                }
+
+                Result_writer::write_record(out, instance, results, algorithm_full_name,
+                                            format_time(start), format_time(end), csv, output_options);
+                runs++;
+            }
+        }
+
+        std::cout << "Finished " << runs << " runs on " << instances.size() << " instance(s)" << std::endl;
+        return retval;
+    }
+}
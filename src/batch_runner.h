@@ -0,0 +1,132 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <experimental/filesystem>
+
+#include "algorithm_runner.h"
+#include "cover_provider.h"
+#include "instance.h"
+#include "result_writer.h"
+#include "runtime_environment.h"
+
+namespace fs = std::experimental::filesystem;
+
+namespace cover {
+    /**
+     * @brief Runs many (instance, costs, algorithm) combinations within a single process
+     *
+     * The entries are read from a manifest in JSON lines format, one entry per line:
+     *
+     *     {"input": "data/a.wkt", "costs": [1, 1], "algorithm": "greedy+prune", "postprocessors": ["trim"]}
+     *
+     * "costs" is either a single (creation cost, area cost) pair or a list of such pairs, in which case the entry is
+     * run once per pair, "postprocessors" is optional. Every Problem_instance is only read once and the
+     * Runtime_environment of each of its polygons is kept across entries, so the decomposition into base rectangles
+     * and the BaseRectGraph, which don't depend on the costs, are only computed once per polygon. One result record
+     * is written per run as soon as it finished.
+     */
+    class Batch_runner {
+    public:
+        /**
+         * @brief A single line of the manifest
+         */
+        struct Entry {
+            fs::path input;
+            std::vector<Problem_instance::Costs> costs;
+            std::string algorithm;
+            std::vector<std::string> postprocessors;
+        };
+
+        /**
+         * Function creating the cover provider for an algorithm name, which may contain postprocessors separated by
+         * '+' like the --algorithm option, followed by the given postprocessors.
+         */
+        using Provider_builder = std::function<std::unique_ptr<Cover_provider>(
+                const std::string &algorithm_name, const std::vector<std::string> &postprocessor_names)>;
+
+        /**
+         * @param builder Function used to create the cover provider of each entry
+         * @param verify Whether to verify the covers
+         * @param method The method used for the verification
+         * @param threads The number of threads used per run, see Algorithm_runner::run_algorithm()
+         * @param options How the provider of each entry is run
+         * @param output_options The measurements written to the results
+         */
+        Batch_runner(Provider_builder builder, bool verify, Algorithm_runner::Verification_method method,
+                     size_t threads, Run_options options, Result_writer::Output_options output_options);
+
+        /**
+         * Reads the entries of a manifest file.
+         *
+         * @param manifest_path Path to the manifest in JSON lines format
+         * @return The entries of the manifest in order
+         */
+        static std::vector<Entry> read_manifest(const fs::path &manifest_path);
+
+        /**
+         * Runs all entries in order and streams the results to output_path, as CSV if the path ends with .csv and
+         * as JSON lines otherwise. Existing CSV files are appended to, other files are overwritten. Throws
+         * std::runtime_error before running anything if an existing CSV file has other columns, see
+         * Result_writer::check_csv_header().
+         *
+         * @param entries The entries to run
+         * @param output_path The path to write the results to
+         * @return 0 if all covers were valid, otherwise 1 is set if any cover was invalid and 2 if any run timed out
+         */
+        int run(const std::vector<Entry> &entries, const fs::path &output_path);
+
+    private:
+        struct Cached_instance {
+            Problem_instance instance;
+            std::vector<Runtime_environment> environments;
+        };
+
+        /**
+         * Returns the cached instance for the WKT file, reading it if it wasn't read before.
+         *
+         * @param input Path to the WKT file
+         * @return The cached instance
+         */
+        Cached_instance &get_instance(const fs::path &input);
+
+        const Provider_builder builder;
+        const bool verify;
+        const Algorithm_runner::Verification_method method;
+        const size_t threads;
+        const Run_options options;
+        const Result_writer::Output_options output_options;
+        std::map<std::string, std::unique_ptr<Cached_instance>> instances{};
+    };
+}
+
+#endif //BATCH_RUNNER_H
@@ -32,13 +32,11 @@ std::vector<Rectangle> Bounding_box_cover_splitter::split_rectangle(
     Runtime_environment *env) const {
   LOG(trace) << "Attempting bounding box split on rectangle: "
              << rectangle.as_polygon();
-  const auto polygon_split{split_into_polygons(rectangle, env)};
+  const auto regions{get_uniquely_covered_regions(rectangle, env)};
   std::vector<Rectangle> bounding_box_rectangles{};
 
-  for (const auto &polygon : polygon_split) {
-    const auto bbox{polygon.bbox()};
-    bounding_box_rectangles.emplace_back(bbox.xmin(), bbox.ymin(), bbox.xmax(),
-                                         bbox.ymax());
+  for (const auto &region : regions) {
+    bounding_box_rectangles.push_back(env->graph.to_rectangle(region.bounds));
   }
 
   LOG(trace) << "Split into " << bounding_box_rectangles.size()
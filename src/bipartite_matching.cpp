@@ -0,0 +1,160 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "bipartite_matching.h"
+
+#include <cassert>
+
+namespace cover {
+
+    Bipartite_matching::Bipartite_matching(size_t left_count, size_t right_count,
+                                           const std::vector<std::pair<VertexId, VertexId>> &edges)
+            : left_count(left_count), right_count(right_count), offsets(left_count + 1, 0) {
+        assert(left_count < UNMATCHED && right_count < UNMATCHED);
+        for (const auto &[left, right]: edges) {
+            assert(left < left_count && right < right_count);
+            ++offsets[left + 1];
+        }
+        for (size_t i = 1; i < offsets.size(); i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        adjacency.resize(edges.size());
+        auto insert_positions{offsets};
+        for (const auto &[left, right]: edges) {
+            adjacency[insert_positions[left]++] = right;
+        }
+    }
+
+    size_t Bipartite_matching::compute() {
+        left_match.assign(left_count, UNMATCHED);
+        right_match.assign(right_count, UNMATCHED);
+
+        size_t matching_size{0};
+        while (build_layers()) {
+            next_edge.assign(offsets.begin(), offsets.end() - 1);
+            for (VertexId vertex = 0; vertex < left_count; vertex++) {
+                if (left_match[vertex] == UNMATCHED && augment(vertex)) {
+                    ++matching_size;
+                }
+            }
+        }
+        return matching_size;
+    }
+
+    bool Bipartite_matching::build_layers() {
+        distances.assign(left_count, INFINITE_DISTANCE);
+        std::vector<VertexId> queue{};
+        for (VertexId vertex = 0; vertex < left_count; vertex++) {
+            if (left_match[vertex] == UNMATCHED) {
+                distances[vertex] = 0;
+                queue.push_back(vertex);
+            }
+        }
+
+        bool found_free_vertex{false};
+        for (size_t head = 0; head < queue.size(); head++) {
+            const auto vertex{queue[head]};
+            for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++) {
+                const auto mate{right_match[adjacency[edge]]};
+                if (mate == UNMATCHED) {
+                    found_free_vertex = true;
+                } else if (distances[mate] == INFINITE_DISTANCE) {
+                    distances[mate] = distances[vertex] + 1;
+                    queue.push_back(mate);
+                }
+            }
+        }
+        return found_free_vertex;
+    }
+
+    bool Bipartite_matching::augment(VertexId root) {
+        // iterative depth first search along the layers, path holds the left vertices of the current alternating
+        // path, each of which currently points at the edge continuing the path
+        path.assign(1, root);
+        while (!path.empty()) {
+            const auto vertex{path.back()};
+            if (next_edge[vertex] == offsets[vertex + 1]) {
+                // dead end for the rest of this phase
+                distances[vertex] = INFINITE_DISTANCE;
+                path.pop_back();
+                if (!path.empty()) {
+                    ++next_edge[path.back()];
+                }
+                continue;
+            }
+
+            const auto mate{right_match[adjacency[next_edge[vertex]]]};
+            if (mate == UNMATCHED) {
+                for (const auto left: path) {
+                    const auto right{adjacency[next_edge[left]]};
+                    left_match[left] = right;
+                    right_match[right] = left;
+                }
+                return true;
+            }
+            if (distances[mate] == distances[vertex] + 1) {
+                path.push_back(mate);
+            } else {
+                ++next_edge[vertex];
+            }
+        }
+        return false;
+    }
+
+    void Bipartite_matching::maximum_independent_set(std::vector<bool> &left, std::vector<bool> &right) const {
+        assert(left_match.size() == left_count);
+
+        // left and right collect the vertices reachable by alternating paths from unmatched left vertices, by
+        // König's theorem the unreachable left and the reachable right vertices form a minimum vertex cover
+        left.assign(left_count, false);
+        right.assign(right_count, false);
+        std::vector<VertexId> queue{};
+        for (VertexId vertex = 0; vertex < left_count; vertex++) {
+            if (left_match[vertex] == UNMATCHED) {
+                left[vertex] = true;
+                queue.push_back(vertex);
+            }
+        }
+        for (size_t head = 0; head < queue.size(); head++) {
+            const auto vertex{queue[head]};
+            for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++) {
+                const auto neighbor{adjacency[edge]};
+                if (right[neighbor]) {
+                    continue;
+                }
+                right[neighbor] = true;
+                const auto mate{right_match[neighbor]};
+                assert(mate != UNMATCHED);
+                if (!left[mate]) {
+                    left[mate] = true;
+                    queue.push_back(mate);
+                }
+            }
+        }
+
+        right.flip();
+    }
+
+} // cover
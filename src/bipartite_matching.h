@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BIPARTITE_MATCHING_H
+#define BIPARTITE_MATCHING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace cover {
+
+    /**
+     * @brief Maximum matching and maximum independent set of a bipartite graph via Hopcroft-Karp
+     *
+     * The vertices on either side are identified by consecutive integers, the edges are stored in compressed sparse
+     * row form ordered by their left vertex. The matching is computed in O(E sqrt(V)), afterwards König's theorem
+     * yields a minimum vertex cover, whose complement is a maximum independent set, from the alternating paths
+     * starting at unmatched left vertices.
+     */
+    class Bipartite_matching {
+    public:
+        using VertexId = uint32_t;
+
+        static constexpr VertexId UNMATCHED{std::numeric_limits<VertexId>::max()};
+
+        /**
+         * Creates the graph, duplicate edges are allowed.
+         *
+         * @param left_count The number of vertices on the left side
+         * @param right_count The number of vertices on the right side
+         * @param edges The edges as pairs of a left and a right vertex
+         */
+        Bipartite_matching(size_t left_count, size_t right_count,
+                           const std::vector<std::pair<VertexId, VertexId>> &edges);
+
+        /**
+         * Computes a maximum matching.
+         *
+         * @return The number of edges in the matching
+         */
+        size_t compute();
+
+        /**
+         * Determines which vertices belong to a maximum independent set, compute() has to be called first.
+         *
+         * @param left Receives whether each left vertex is in the independent set
+         * @param right Receives whether each right vertex is in the independent set
+         */
+        void maximum_independent_set(std::vector<bool> &left, std::vector<bool> &right) const;
+
+        /**
+         * @param vertex A left vertex
+         * @return The right vertex it is matched with, UNMATCHED if there is none
+         */
+        [[nodiscard]] VertexId get_match_of_left(VertexId vertex) const { return left_match[vertex]; }
+
+    private:
+        static constexpr uint32_t INFINITE_DISTANCE{std::numeric_limits<uint32_t>::max()};
+
+        size_t left_count;
+        size_t right_count;
+        std::vector<size_t> offsets;
+        std::vector<VertexId> adjacency;
+
+        std::vector<VertexId> left_match;
+        std::vector<VertexId> right_match;
+        // BFS layer of each left vertex in the current phase
+        std::vector<uint32_t> distances;
+        // next edge to try for each left vertex in the current phase
+        std::vector<size_t> next_edge;
+        std::vector<VertexId> path;
+
+        bool build_layers();
+
+        bool augment(VertexId root);
+    };
+
+} // cover
+
+#endif //BIPARTITE_MATCHING_H
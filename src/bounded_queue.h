@@ -0,0 +1,111 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <utility>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace cover {
+    /**
+     * @brief Blocking FIFO queue of bounded capacity connecting the stages of a pipeline
+     *
+     * push() blocks while the queue is full and pop() blocks while it is empty, so a fast stage can only run a fixed
+     * number of items ahead of the next one. Once closed, pushing fails and popping returns the remaining items and
+     * then nothing, which is how a stage signals that it finished or failed.
+     */
+    template<typename T>
+    class Bounded_queue {
+    public:
+        /**
+         * @param capacity The maximum number of items in the queue, values smaller than 1 are treated as 1
+         */
+        explicit Bounded_queue(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {}
+
+        Bounded_queue(const Bounded_queue &) = delete;
+
+        Bounded_queue &operator=(const Bounded_queue &) = delete;
+
+        /**
+         * Appends the item, waiting until there is space for it.
+         *
+         * @param item The item to append
+         * @return Whether the item was appended, false if the queue was closed
+         */
+        bool push(T item) {
+            boost::unique_lock<boost::mutex> lock{mutex};
+            not_full.wait(lock, [this]() { return closed || items.size() < capacity; });
+            if (closed) {
+                return false;
+            }
+            items.push_back(std::move(item));
+            not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * Removes the first item, waiting until there is one.
+         *
+         * @return The first item, or nothing if the queue was closed and is empty
+         */
+        std::optional<T> pop() {
+            boost::unique_lock<boost::mutex> lock{mutex};
+            not_empty.wait(lock, [this]() { return closed || !items.empty(); });
+            if (items.empty()) {
+                return std::nullopt;
+            }
+            std::optional<T> item{std::move(items.front())};
+            items.pop_front();
+            not_full.notify_one();
+            return item;
+        }
+
+        /**
+         * Closes the queue, waking up all waiting stages.
+         */
+        void close() {
+            const boost::lock_guard<boost::mutex> lock{mutex};
+            closed = true;
+            not_full.notify_all();
+            not_empty.notify_all();
+        }
+
+    private:
+        const size_t capacity;
+        std::deque<T> items;
+        bool closed{false};
+        boost::mutex mutex;
+        boost::condition_variable not_full;
+        boost::condition_variable not_empty;
+    };
+}
+
+#endif //BOUNDED_QUEUE_H
@@ -0,0 +1,305 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "branch_and_bound_algorithm.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "candidate_filter.h"
+#include "profile.h"
+
+namespace cover {
+    namespace {
+        /**
+         * A set of base rectangles as a bitset of fixed width.
+         */
+        template<size_t Words>
+        struct Node_set {
+            std::array<uint64_t, Words> words{};
+
+            void set(size_t node) { words[node / 64] |= uint64_t{1} << (node % 64); }
+
+            [[nodiscard]] bool any() const {
+                return std::any_of(words.begin(), words.end(), [](uint64_t word) { return word != 0; });
+            }
+
+            [[nodiscard]] size_t count() const {
+                size_t count{0};
+                for (const auto word: words) {
+                    count += static_cast<size_t>(__builtin_popcountll(word));
+                }
+                return count;
+            }
+
+            [[nodiscard]] bool contains(size_t node) const { return (words[node / 64] >> (node % 64) & 1) != 0; }
+
+            [[nodiscard]] Node_set without(const Node_set &other) const {
+                Node_set result{};
+                for (size_t w = 0; w < Words; w++) {
+                    result.words[w] = words[w] & ~other.words[w];
+                }
+                return result;
+            }
+
+            [[nodiscard]] size_t count_common(const Node_set &other) const {
+                size_t count{0};
+                for (size_t w = 0; w < Words; w++) {
+                    count += static_cast<size_t>(__builtin_popcountll(words[w] & other.words[w]));
+                }
+                return count;
+            }
+
+            template<typename Visitor>
+            void for_each(Visitor &&visitor) const {
+                for (size_t w = 0; w < Words; w++) {
+                    for (auto word{words[w]}; word != 0; word &= word - 1) {
+                        visitor(w * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+                    }
+                }
+            }
+        };
+
+        /**
+         * Depth-first branch-and-bound over the candidates of a polygon with at most Words * 64 base rectangles.
+         */
+        template<size_t Words>
+        class Bitset_solver {
+        public:
+            using Set = Node_set<Words>;
+
+            Bitset_solver(const BaseRectGraph &graph, const Problem_instance::Costs &costs, const Deadline &deadline)
+                    : deadline(deadline), containing(graph.getNodes().size()),
+                      shares(graph.getNodes().size(), std::numeric_limits<double>::infinity()) {
+                Candidate_filter{costs}.for_each_candidate(graph, [&](BaseRectNode::PtrType top_right,
+                                                                      BaseRectNode::PtrType bottom_left) {
+                    Set mask{};
+                    for (auto it = graph.begin(top_right, bottom_left); it != graph.end(); ++it) {
+                        mask.set(*it);
+                    }
+                    const auto cost{Problem_instance::calculate_total_cost_of_rectangle(
+                            graph.get_rectangle(top_right, bottom_left), costs)};
+                    const auto index{static_cast<uint32_t>(masks.size())};
+                    const auto share{static_cast<double>(cost) / static_cast<double>(mask.count())};
+                    mask.for_each([&](size_t node) {
+                        containing[node].push_back(index);
+                        shares[node] = std::min(shares[node], share);
+                    });
+                    masks.push_back(mask);
+                    candidate_costs.push_back(cost);
+                    corners.emplace_back(top_right, bottom_left);
+                });
+                for (size_t node = 0; node < graph.getNodes().size(); node++) {
+                    all.set(node);
+                }
+            }
+
+            /**
+             * @return The corners of the candidates of the best cover found
+             */
+            std::vector<std::pair<BaseRectNode::PtrType, BaseRectNode::PtrType>> solve() {
+                best = greedy_cover();
+                best_cost = cost_of(best);
+                const auto greedy_cost{best_cost};
+
+                std::vector<uint32_t> chosen{};
+                branches.resize(containing.size() + 1);
+                search(all, 0, chosen);
+
+                LOG(info) << "Branch-and-bound visited " << visited << " node(s), improving the greedy cost of "
+                          << greedy_cost << " to " << best_cost << (aborted ? "" : " (optimal)")
+                          << (aborted && !timed_out ? ", stopped at the node limit" : "");
+                PROFILE_COUNT("branch_nodes", visited);
+                if (aborted && !timed_out) {
+                    PROFILE_COUNT("branch_node_limit", 1);
+                }
+
+                std::vector<std::pair<BaseRectNode::PtrType, BaseRectNode::PtrType>> cover{};
+                for (const auto candidate: best) {
+                    cover.push_back(corners[candidate]);
+                }
+                return cover;
+            }
+
+            /**
+             * @return Whether the search stopped at the deadline, stopping at MAX_BRANCH_NODES doesn't count
+             */
+            [[nodiscard]] bool reached_deadline() const { return timed_out; }
+
+        private:
+            std::vector<uint32_t> greedy_cover() const {
+                std::vector<uint32_t> cover{};
+                auto uncovered{all};
+                while (uncovered.any()) {
+                    uint32_t best_candidate{0};
+                    double best_ratio{std::numeric_limits<double>::infinity()};
+                    for (uint32_t candidate = 0; candidate < masks.size(); candidate++) {
+                        const auto gain{masks[candidate].count_common(uncovered)};
+                        if (gain > 0) {
+                            const auto ratio{static_cast<double>(candidate_costs[candidate])
+                                             / static_cast<double>(gain)};
+                            if (ratio < best_ratio) {
+                                best_ratio = ratio;
+                                best_candidate = candidate;
+                            }
+                        }
+                    }
+                    cover.push_back(best_candidate);
+                    uncovered = uncovered.without(masks[best_candidate]);
+                }
+                return cover;
+            }
+
+            CostType cost_of(const std::vector<uint32_t> &cover) const {
+                CostType cost{0};
+                for (const auto candidate: cover) {
+                    cost += candidate_costs[candidate];
+                }
+                return cost;
+            }
+
+            void search(const Set &uncovered, CostType cost, std::vector<uint32_t> &chosen) {
+                if (!uncovered.any()) {
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best = chosen;
+                    }
+                    return;
+                }
+                if (aborted) {
+                    return;
+                }
+                if (++visited > Branch_and_bound_algorithm::MAX_BRANCH_NODES) {
+                    // the best cover so far is returned as is, it is only not proven optimal
+                    aborted = true;
+                    return;
+                }
+                if (visited % DEADLINE_CHECK_INTERVAL == 0 && deadline.expired()) {
+                    aborted = true;
+                    timed_out = true;
+                    return;
+                }
+
+                // every uncovered base rectangle costs at least its cheapest share of any candidate, and as costs
+                // are integral, only covers at least 1 cheaper than the best one are of interest
+                double bound{static_cast<double>(cost)};
+                size_t branch_node{0};
+                size_t fewest_candidates{std::numeric_limits<size_t>::max()};
+                uncovered.for_each([&](size_t node) {
+                    bound += shares[node];
+                    if (containing[node].size() < fewest_candidates) {
+                        fewest_candidates = containing[node].size();
+                        branch_node = node;
+                    }
+                });
+                if (bound > static_cast<double>(best_cost) - 1 + BOUND_TOLERANCE) {
+                    return;
+                }
+
+                // the candidates covering the most per cost first, to find good covers early
+                auto &branch{branches[chosen.size()]};
+                branch.clear();
+                for (const auto candidate: containing[branch_node]) {
+                    branch.emplace_back(static_cast<double>(candidate_costs[candidate])
+                                        / static_cast<double>(masks[candidate].count_common(uncovered)), candidate);
+                }
+                std::sort(branch.begin(), branch.end());
+                for (size_t i = 0; i < branch.size() && !aborted; i++) {
+                    const auto candidate{branch[i].second};
+                    chosen.push_back(candidate);
+                    search(uncovered.without(masks[candidate]), cost + candidate_costs[candidate], chosen);
+                    chosen.pop_back();
+                }
+            }
+
+            static constexpr size_t DEADLINE_CHECK_INTERVAL{1024};
+            static constexpr double BOUND_TOLERANCE{1e-9};
+
+            const Deadline &deadline;
+            Set all{};
+            std::vector<Set> masks;
+            std::vector<CostType> candidate_costs;
+            std::vector<std::pair<BaseRectNode::PtrType, BaseRectNode::PtrType>> corners;
+            std::vector<std::vector<uint32_t>> containing;
+            std::vector<double> shares;
+
+            // the candidates of each depth of the search, reused to avoid allocations
+            std::vector<std::vector<std::pair<double, uint32_t>>> branches;
+            std::vector<uint32_t> best;
+            CostType best_cost{std::numeric_limits<CostType>::max()};
+            size_t visited{0};
+            // whether the search stopped early, at the node limit or the deadline
+            bool aborted{false};
+            // whether it stopped at the deadline
+            bool timed_out{false};
+        };
+
+        template<size_t Words>
+        std::vector<Rectangle> solve(const BaseRectGraph &graph, const Problem_instance::Costs &costs,
+                                     const Deadline &deadline, bool &timed_out) {
+            Bitset_solver<Words> solver{graph, costs, deadline};
+            std::vector<Rectangle> cover{};
+            for (const auto &[top_right, bottom_left]: solver.solve()) {
+                cover.push_back(graph.get_rectangle(top_right, bottom_left));
+            }
+            timed_out = solver.reached_deadline();
+            return cover;
+        }
+    }
+
+    Branch_and_bound_algorithm::Branch_and_bound_algorithm(std::unique_ptr<Algorithm> fallback,
+                                                           size_t max_base_rectangles)
+            : fallback(std::move(fallback)),
+              max_base_rectangles(std::min(max_base_rectangles, MAX_BASE_RECTANGLES)) {
+        if (this->fallback == nullptr) {
+            throw std::invalid_argument("Branch-and-bound needs a fallback algorithm for large polygons");
+        }
+    }
+
+    std::vector<Rectangle> Branch_and_bound_algorithm::calculate_cover(
+            const Polygon_with_holes &polygon, const Problem_instance::Costs &costs,
+            Runtime_environment *env) {
+        timed_out = false;
+        used_fallback = false;
+        env->ensure_decomposition(polygon);
+        if (env->base_rectangles.size() > max_base_rectangles) {
+            used_fallback = true;
+            return fallback->get_cover_for(polygon, costs, env);
+        }
+
+        PROFILE_SCOPE("branch_and_bound");
+        PROFILE_COUNT("exact_polygons", 1);
+        const auto node_count{env->graph.getNodes().size()};
+        if (node_count <= 64) {
+            return solve<1>(env->graph, costs, env->deadline, timed_out);
+        } else if (node_count <= 128) {
+            return solve<2>(env->graph, costs, env->deadline, timed_out);
+        }
+        return solve<4>(env->graph, costs, env->deadline, timed_out);
+    }
+} // cover
@@ -0,0 +1,102 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BRANCH_AND_BOUND_ALGORITHM_H
+#define BRANCH_AND_BOUND_ALGORITHM_H
+
+#include <cstddef>
+#include <memory>
+
+#include "algorithm.h"
+
+namespace cover {
+
+    /**
+     * @brief Algorithm which covers small polygons optimally by branch-and-bound over bitsets of base rectangles
+     *
+     * The candidates are turned into masks over the base rectangles of a fixed width of 64, 128 or 256 bits, picked
+     * per polygon, so all coverage checks are a few word operations. The search starts from the greedy cover,
+     * always branches on the uncovered base rectangle contained in the fewest candidates and bounds by the cost
+     * each uncovered base rectangle has to contribute at least. Polygons with more base rectangles than the limit
+     * are handed to the fallback algorithm instead, which makes this a drop-in for the long tail of small polygons.
+     *
+     * The search visits at most MAX_BRANCH_NODES nodes and stops at the deadline, the best cover found so far is
+     * returned then. Only stopping at the deadline is a timeout, a search stopped at the node limit still returns a
+     * valid cover, which is verified as usual and counted as "branch_node_limit" in the profile.
+     */
+    class Branch_and_bound_algorithm : public Algorithm {
+    public:
+        static constexpr size_t MAX_BASE_RECTANGLES{256};
+        static constexpr size_t MAX_BRANCH_NODES{1'000'000};
+
+        /**
+         * @param fallback The algorithm covering polygons with more than max_base_rectangles base rectangles
+         * @param max_base_rectangles The largest number of base rectangles covered optimally, at most
+         * MAX_BASE_RECTANGLES
+         */
+        explicit Branch_and_bound_algorithm(std::unique_ptr<Algorithm> fallback,
+                                            size_t max_base_rectangles = MAX_BASE_RECTANGLES);
+
+        [[nodiscard]] bool timeouted() const override {
+            return used_fallback ? fallback->timeouted() : timed_out;
+        }
+
+        /**
+         * The search over at most max_base_rectangles base rectangles needs little memory, larger polygons are
+         * estimated by the fallback algorithm.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @return The estimated number of bytes
+         */
+        [[nodiscard]] size_t estimate_memory(const BaseRectGraph &graph) const override {
+            return graph.getNodes().size() > max_base_rectangles ? fallback->estimate_memory(graph) : 0;
+        }
+
+    protected:
+        /**
+         * Calculates an optimal cover if the polygon has at most max_base_rectangles base rectangles, otherwise
+         * returns the cover of the fallback algorithm.
+         *
+         * @param polygon The polygon to cover
+         * @param costs The costs associated with the problem instance
+         * @return A cover of the polygon
+         */
+        [[nodiscard]] std::vector<Rectangle>
+        calculate_cover(const Polygon_with_holes &polygon,
+                        const Problem_instance::Costs &costs,
+                        Runtime_environment *env) override;
+
+    private:
+        std::unique_ptr<Algorithm> fallback;
+        const size_t max_base_rectangles;
+        // whether the last polygon was handed to the fallback, its flag may stem from an earlier polygon otherwise
+        bool used_fallback{false};
+        // whether the search of the last polygon covered exactly was stopped by the deadline
+        bool timed_out{false};
+    };
+
+} // cover
+
+#endif //BRANCH_AND_BOUND_ALGORITHM_H
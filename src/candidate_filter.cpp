@@ -0,0 +1,66 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "candidate_filter.h"
+
+namespace cover {
+    namespace {
+        using Link = BaseRectNode::PtrType BaseRectNode::*;
+
+        /**
+         * Walks along a side of a rectangle from start in the direction of step until the node at which done
+         * returns true, and checks whether every node on the way has a neighbor in the direction of outward.
+         */
+        template<typename Done>
+        bool is_extendable(const std::vector<BaseRectNode> &nodes, BaseRectNode::PtrType start, Link step,
+                           Link outward, Done &&done) {
+            for (auto node{start};; node = nodes[node].*step) {
+                if (nodes[node].*outward == BaseRectNode::NO_NEIGHBOR) {
+                    return false;
+                }
+                if (done(node)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    bool Candidate_filter::is_maximal(const BaseRectGraph &graph, BaseRectNode::PtrType top_right,
+                                      BaseRectNode::PtrType bottom_left) {
+        const auto &nodes{graph.getNodes()};
+        const auto &compact{graph.getCompactNodes()};
+        const auto bounds{graph.get_compact_rectangle(top_right, bottom_left)};
+
+        const auto reached_left = [&](BaseRectNode::PtrType node) { return compact[node].min_x == bounds.min_x; };
+        const auto reached_bottom = [&](BaseRectNode::PtrType node) { return compact[node].min_y == bounds.min_y; };
+        const auto reached_right = [&](BaseRectNode::PtrType node) { return compact[node].max_x == bounds.max_x; };
+        const auto reached_top = [&](BaseRectNode::PtrType node) { return compact[node].max_y == bounds.max_y; };
+
+        return !is_extendable(nodes, top_right, &BaseRectNode::left, &BaseRectNode::top, reached_left)
+               && !is_extendable(nodes, top_right, &BaseRectNode::bottom, &BaseRectNode::right, reached_bottom)
+               && !is_extendable(nodes, bottom_left, &BaseRectNode::right, &BaseRectNode::bottom, reached_right)
+               && !is_extendable(nodes, bottom_left, &BaseRectNode::top, &BaseRectNode::left, reached_top);
+    }
+}
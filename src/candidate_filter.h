@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CANDIDATE_FILTER_H
+#define CANDIDATE_FILTER_H
+
+#include <cstddef>
+
+#include "baserect_graph.h"
+#include "instance.h"
+#include "logging.h"
+#include "profile.h"
+
+namespace cover {
+
+    /**
+     * @brief Removes candidate rectangles which are not needed for an optimal cover under the given costs
+     *
+     * The cost of a rectangle is its creation cost plus its area times the area cost. Since the area is additive and
+     * every rectangle costs the creation cost, splitting a candidate or enlarging it never pays off in general, so
+     * candidates can only be discarded safely for the following cost ratios:
+     *
+     * - Without an area cost, every candidate costs the same, so each candidate can be replaced by a maximal one
+     *   containing it. Only maximal candidates are kept, along with the single base rectangles, which stages rely on
+     *   to complete covers.
+     * - Without a creation cost, the cost of a cover is its area times the area cost, which the single base
+     *   rectangles attain with the least possible area, so only they are kept.
+     *
+     * Either way the optimum is preserved, and the best candidate of every greedy step is among the ones kept.
+     */
+    class Candidate_filter {
+    public:
+        enum class Rule { NONE, MAXIMAL, SINGLE };
+
+        explicit Candidate_filter(const Problem_instance::Costs &costs)
+                : rule(costs.creation_cost == 0 ? Rule::SINGLE
+                                                : (costs.area_cost == 0 ? Rule::MAXIMAL : Rule::NONE)) {}
+
+        [[nodiscard]] Rule get_rule() const { return rule; }
+
+        /**
+         * Calls the visitor with the top right and bottom left node of every candidate of the graph which is kept,
+         * in the order of BaseRectGraph::for_each_rectangle().
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param visitor Called with the top right and bottom left node of each kept candidate
+         * @return The number of candidates which were removed
+         */
+        template<typename Visitor>
+        size_t for_each_candidate(const BaseRectGraph &graph, Visitor &&visitor) const {
+            size_t removed{0};
+            switch (rule) {
+                case Rule::NONE:
+                    graph.for_each_rectangle(visitor);
+                    break;
+                case Rule::SINGLE:
+                    for (BaseRectNode::PtrType node = 0; node < graph.getNodes().size(); node++) {
+                        visitor(node, node);
+                    }
+                    removed = graph.count_all_rectangles() - graph.getNodes().size();
+                    break;
+                case Rule::MAXIMAL:
+                    graph.for_each_rectangle([&](BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left) {
+                        if (top_right == bottom_left || is_maximal(graph, top_right, bottom_left)) {
+                            visitor(top_right, bottom_left);
+                        } else {
+                            ++removed;
+                        }
+                    });
+                    break;
+            }
+            LOG(debug) << "Candidate filter removed " << removed << " candidate(s)";
+            PROFILE_COUNT("candidates_removed", removed);
+            return removed;
+        }
+
+        /**
+         * Checks whether the rectangle spanned by the given nodes cannot be extended by a row or column of base
+         * rectangles on any side without leaving the polygon. As base rectangles share whole sides with their
+         * neighbors, this is the case if on every side some base rectangle has no neighbor.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param top_right The top right node of the rectangle
+         * @param bottom_left The bottom left node of the rectangle
+         * @return Whether the rectangle is maximal
+         */
+        [[nodiscard]] static bool is_maximal(const BaseRectGraph &graph, BaseRectNode::PtrType top_right,
+                                             BaseRectNode::PtrType bottom_left);
+
+    private:
+        Rule rule;
+    };
+}
+
+#endif //CANDIDATE_FILTER_H
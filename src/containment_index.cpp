@@ -0,0 +1,138 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "containment_index.h"
+
+#include <algorithm>
+
+namespace cover {
+
+    void Containment_index::build(const BaseRectGraph &graph, size_t max_cells) {
+        clear();
+        built = true;
+
+        const auto &x_coordinates{graph.getXCoordinates()};
+        const auto &y_coordinates{graph.getYCoordinates()};
+        if (x_coordinates.size() < 2 || y_coordinates.size() < 2) {
+            return;
+        }
+        const auto columns{x_coordinates.size() - 1};
+        const auto rows{y_coordinates.size() - 1};
+        if (columns > max_cells / rows) {
+            return;
+        }
+
+        // marking the corners of every base rectangle, integrating once yields the inside cells, integrating again
+        // the prefix sums, both times shifted by one so row and column 0 stay 0
+        stride = columns + 1;
+        std::vector<int32_t> marks(stride * (rows + 1), 0);
+        for (const auto &compact: graph.getCompactNodes()) {
+            marks[compact.min_y * stride + compact.min_x]++;
+            marks[compact.min_y * stride + compact.max_x]--;
+            marks[compact.max_y * stride + compact.min_x]--;
+            marks[compact.max_y * stride + compact.max_x]++;
+        }
+        for (size_t y = 0; y < rows; y++) {
+            for (size_t x = 0; x < columns; x++) {
+                marks[y * stride + x] += (x > 0 ? marks[y * stride + x - 1] : 0) +
+                                         (y > 0 ? marks[(y - 1) * stride + x] : 0) -
+                                         (x > 0 && y > 0 ? marks[(y - 1) * stride + x - 1] : 0);
+            }
+        }
+
+        prefix_sums.assign(stride * (rows + 1), 0);
+        for (size_t y = 0; y < rows; y++) {
+            for (size_t x = 0; x < columns; x++) {
+                prefix_sums[(y + 1) * stride + x + 1] = static_cast<uint32_t>(marks[y * stride + x] > 0) +
+                                                        prefix_sums[y * stride + x + 1] +
+                                                        prefix_sums[(y + 1) * stride + x] -
+                                                        prefix_sums[y * stride + x];
+            }
+        }
+    }
+
+    void Containment_index::clear() {
+        built = false;
+        stride = 0;
+        prefix_sums.clear();
+        prefix_sums.shrink_to_fit();
+    }
+
+    std::optional<bool> Containment_index::contains(const BaseRectGraph &graph, const Rectangle &rectangle) const {
+        const auto min_x{find_rank(graph.getXCoordinates(), rectangle.get_min_x())};
+        const auto min_y{find_rank(graph.getYCoordinates(), rectangle.get_min_y())};
+        const auto max_x{find_rank(graph.getXCoordinates(), rectangle.get_max_x())};
+        const auto max_y{find_rank(graph.getYCoordinates(), rectangle.get_max_y())};
+        if (!min_x.has_value() || !min_y.has_value() || !max_x.has_value() || !max_y.has_value()) {
+            return std::nullopt;
+        }
+        const CompactRectangle compact{*min_x, *min_y, *max_x, *max_y};
+
+        if (stride == 0) {
+            return resolve_in_graph(graph, rectangle, compact);
+        }
+
+        const auto inside{prefix_sums[compact.max_y * stride + compact.max_x] -
+                          prefix_sums[compact.min_y * stride + compact.max_x] -
+                          prefix_sums[compact.max_y * stride + compact.min_x] +
+                          prefix_sums[compact.min_y * stride + compact.min_x]};
+        return static_cast<uint64_t>(inside) ==
+               static_cast<uint64_t>(compact.max_x - compact.min_x) * (compact.max_y - compact.min_y);
+    }
+
+    std::optional<CompactRectangle::RankType> Containment_index::find_rank(const std::vector<NumType> &coordinates,
+                                                                          const NumType &coordinate) {
+        const auto it{std::lower_bound(coordinates.cbegin(), coordinates.cend(), coordinate)};
+        if (it == coordinates.cend() || *it != coordinate) {
+            return std::nullopt;
+        }
+        return static_cast<CompactRectangle::RankType>(it - coordinates.cbegin());
+    }
+
+    std::optional<bool> Containment_index::resolve_in_graph(const BaseRectGraph &graph, const Rectangle &rectangle,
+                                                            const CompactRectangle &compact) {
+        const auto top_right{graph.find_top_right(rectangle.get_top_right())};
+        const auto bottom_left{graph.find_bottom_left(rectangle.get_bottom_left())};
+        if (top_right == BaseRectNode::NO_NEIGHBOR || bottom_left == BaseRectNode::NO_NEIGHBOR) {
+            return std::nullopt;
+        }
+
+        // the walk only enumerates the rectangle if it is a union of base rectangles, which their areas then add up to
+        auto remaining_area{static_cast<uint64_t>(compact.max_x - compact.min_x) * (compact.max_y - compact.min_y)};
+        for (auto it = graph.begin(top_right, bottom_left); it != graph.end(); ++it) {
+            const auto &node{graph.get_compact_rectangle(*it)};
+            if (node.min_x < compact.min_x || node.min_y < compact.min_y ||
+                node.max_x > compact.max_x || node.max_y > compact.max_y) {
+                return std::nullopt;
+            }
+            remaining_area -= static_cast<uint64_t>(node.max_x - node.min_x) * (node.max_y - node.min_y);
+        }
+        if (remaining_area != 0) {
+            return std::nullopt;
+        }
+        return true;
+    }
+
+} // cover
@@ -0,0 +1,97 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CONTAINMENT_INDEX_H
+#define CONTAINMENT_INDEX_H
+
+#include <optional>
+#include <vector>
+
+#include "baserect_graph.h"
+
+namespace cover {
+
+    /**
+     * @brief Answers whether rectangles aligned with the base rectangles of a polygon lie inside the polygon
+     *
+     * The distinct x and y coordinates of the base rectangles split the polygon's bounding box into a compressed grid
+     * in which every cell either lies inside exactly one base rectangle or outside the polygon. A rectangle whose
+     * coordinates are all grid coordinates lies inside the polygon if and only if all cells it spans are inside, the
+     * index counts these cells in O(1) using 2D prefix sums over the grid.
+     *
+     * Grids with more than max_cells cells are not materialized, rectangles are then resolved through the base
+     * rectangle graph instead, which only confirms rectangles which are unions of base rectangles.
+     */
+    class Containment_index {
+    public:
+        static constexpr size_t DEFAULT_MAX_CELLS{size_t{1} << 24};
+
+        /**
+         * Builds the index for the graph's base rectangles.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @param max_cells The maximum number of grid cells to compute prefix sums for
+         */
+        void build(const BaseRectGraph &graph, size_t max_cells = DEFAULT_MAX_CELLS);
+
+        [[nodiscard]] bool empty() const { return !built; }
+
+        void clear();
+
+        /**
+         * @return The bytes held by the prefix sums of the index
+         */
+        [[nodiscard]] size_t memory_usage() const { return prefix_sums.capacity() * sizeof(uint32_t); }
+
+        /**
+         * Returns whether the rectangle lies inside the polygon the graph was built for, the graph must be the one
+         * the index was built for.
+         *
+         * @param graph The base rectangle graph the index was built for
+         * @param rectangle The rectangle to check
+         * @return Whether the rectangle lies inside the polygon, nullopt if the index cannot tell, either because the
+         * rectangle is not aligned with the base rectangles or because the grid is too large and the rectangle is not
+         * a union of base rectangles
+         */
+        [[nodiscard]] std::optional<bool> contains(const BaseRectGraph &graph, const Rectangle &rectangle) const;
+
+    private:
+        bool built{false};
+        // number of cells in x direction plus one, zero if the prefix sums were not computed
+        size_t stride{0};
+        // prefix_sums[y * stride + x] is the number of inside cells with ranks below x and y
+        std::vector<uint32_t> prefix_sums;
+
+        [[nodiscard]] static std::optional<CompactRectangle::RankType> find_rank(
+                const std::vector<NumType> &coordinates, const NumType &coordinate);
+
+        [[nodiscard]] static std::optional<bool> resolve_in_graph(const BaseRectGraph &graph,
+                                                                  const Rectangle &rectangle,
+                                                                  const CompactRectangle &compact);
+    };
+
+} // cover
+
+#endif //CONTAINMENT_INDEX_H
@@ -24,6 +24,7 @@
  */
 
 #include "cover_joiner.h"
+#include "profile.h"
 
 namespace cover {
     Cover_joiner::AlignmentMap Cover_joiner::calculate_x_alignments(const std::vector<Rectangle> &cover) {
@@ -82,6 +83,7 @@ namespace cover {
                                                         std::vector<Rectangle> &cover,
                                                         const std::vector<size_t> &aligned_indices,
                                                         const Problem_instance::Costs &costs,
+                                                        Runtime_environment *env,
                                                         bool vertically_aligned) {
         // joins vertically/horizontally aligned rectangles if their combined cost is lower than the total of their
         // individual costs, if multiple rectangles are aligned in a line, an attempt to join is only made between
@@ -113,11 +115,15 @@ namespace cover {
             LOG(debug) << "Proposed new cost is " << std::to_string(proposed_cost);
 
             LOG(trace) << "Checking whether rectangle: " << proposed_join.as_polygon() << " is valid";
-            if (proposed_cost < current_cost && is_valid(polygon, proposed_join, vertically_aligned)) {
+            if (proposed_cost < current_cost && is_valid(polygon, proposed_join, env, vertically_aligned)) {
                 LOG(debug) << "Proposed join valid and cheaper than current cost, added to cover";
                 to_be_deleted.insert(prev_index);
                 to_be_deleted.insert(*index);
 
+                env->coverage.remove(env->graph, *prev_rectangle_it);
+                env->coverage.remove(env->graph, *curr_rectangle_it);
+                env->coverage.add(env->graph, proposed_join);
+
                 cover.push_back(proposed_join);
 
                 prev_index = cover.size() - 1;
@@ -142,6 +148,16 @@ namespace cover {
         });
     }
 
+    bool Cover_joiner::is_valid(const Polygon_with_holes &polygon, const Rectangle &rectangle,
+                                Runtime_environment *env, bool is_vertical_join) {
+        const auto contained{is_contained(polygon, rectangle, env)};
+        if (contained.has_value()) {
+            return contained.value();
+        }
+
+        return is_valid(polygon, rectangle, is_vertical_join);
+    }
+
     bool Cover_joiner::is_valid(const Polygon &polygon, const Rectangle &rectangle, bool is_vertical_join) {
         auto edge_it{polygon.edges_begin()};
         if ((is_vertical_join && edge_it->is_vertical()) || (!is_vertical_join && edge_it->is_horizontal())) {
@@ -170,7 +186,9 @@ namespace cover {
         const cover::Polygon_with_holes &polygon,
         const Problem_instance::Costs &costs, Runtime_environment *env,
         std::optional<Map<Point, size_t>> &covered_points) const {
+      PROFILE_SCOPE("join");
       LOG(info) << "Running Cover_joiner on returned cover";
+      const auto original_size{cover.size()};
 
       auto x_aligned{calculate_x_alignments(cover)};
 
@@ -179,8 +197,11 @@ namespace cover {
       LOG(debug) << "Joining horizontally aligned rectangles";
       // join horizontally aligned rectangles
       for (auto &[_, aligned_indices] : x_aligned) {
+        if (env->deadline.expired()) {
+          break;
+        }
         const auto newly_joined{join_aligned_entries(
-            polygon, cover, aligned_indices, costs, false)};
+            polygon, cover, aligned_indices, costs, env, false)};
         joined_indices.insert(newly_joined.begin(), newly_joined.end());
       }
 
@@ -196,8 +217,11 @@ namespace cover {
       LOG(debug) << "Joining vertically aligned rectangles";
       // join vertically aligned rectangles
       for (auto &[_, aligned_indices] : y_aligned) {
+        if (env->deadline.expired()) {
+          break;
+        }
         const auto newly_joined{
-            join_aligned_entries(polygon, cover, aligned_indices, costs, true)};
+            join_aligned_entries(polygon, cover, aligned_indices, costs, env, true)};
         joined_indices.insert(newly_joined.begin(), newly_joined.end());
       }
 
@@ -206,6 +230,7 @@ namespace cover {
         cover.erase(cover.begin() + *index);
       }
 
+      PROFILE_COUNT("joined", original_size - cover.size());
       LOG(info) << "Cover joiner finished";
     }
 } // cover
@@ -101,6 +101,20 @@ namespace cover {
          */
         static bool is_valid(const Polygon &polygon, const Rectangle &rectangle, bool is_vertical_join);
 
+        /**
+         * Same as the other is_valid functions, but answers from the containment index over the base rectangle
+         * graph in the environment whenever the rectangle is aligned with the base rectangles, only falling back to
+         * checking the polygon's edges otherwise.
+         *
+         * @param polygon The polygon the rectangle should be contained in
+         * @param rectangle The rectangle that should be checked for validity
+         * @param env The environment holding the base rectangle graph of the polygon
+         * @param is_vertical_join Whether the rectangle is the result of a vertical join or not
+         * @return Whether the rectangle is fully contained in the polygon
+         */
+        static bool is_valid(const Polygon_with_holes &polygon, const Rectangle &rectangle, Runtime_environment *env,
+                             bool is_vertical_join);
+
         /**
          * Function which attempts to join a given vector of aligned rectangles.
          *
@@ -112,6 +126,7 @@ namespace cover {
          * @param cover The calculated cover for the polygon
          * @param aligned_indices The indices of the vertically or horizontally aligned rectangles
          * @param costs The costs associated with the problem instance
+         * @param env The environment holding the base rectangle graph of the polygon
          * @param vertically_aligned Whether the rectangles are vertically or horizontally aligned
          * @return The set of indices of rectangles which were joined
          */
@@ -119,6 +134,7 @@ namespace cover {
                                                      std::vector<Rectangle> &cover,
                                                      const std::vector<size_t> &aligned_indices,
                                                      const Problem_instance::Costs &costs,
+                                                     Runtime_environment *env,
                                                      bool vertically_aligned);
 
         /**
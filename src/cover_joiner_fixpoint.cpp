@@ -0,0 +1,192 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cover_joiner_fixpoint.h"
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+
+#include "profile.h"
+
+namespace cover {
+    namespace {
+        // the rectangles of one alignment, ordered by their minimum coordinate along it, ties broken by index
+        using Alignment_bucket = OrderedSet<std::pair<NumType, size_t>>;
+
+        struct Join {
+            CostType saving;
+            size_t partner;
+            bool vertical;
+        };
+
+        /**
+         * The horizontal or vertical alignments of the live rectangles of a cover.
+         */
+        class Alignments {
+        public:
+            explicit Alignments(bool vertical) : vertical(vertical) {}
+
+            void insert(const std::vector<Rectangle> &cover, size_t index) {
+                buckets[key(cover[index])].emplace(position(cover[index]), index);
+            }
+
+            /**
+             * Removes the rectangle and hands its neighbors, which become neighbors of each other, to the visitor.
+             */
+            template<typename Visitor>
+            void erase(const std::vector<Rectangle> &cover, size_t index, Visitor &&visitor) {
+                const auto bucket_it{buckets.find(key(cover[index]))};
+                auto &bucket{bucket_it->second};
+                const auto it{bucket.find({position(cover[index]), index})};
+                if (it != bucket.begin()) {
+                    visitor(std::prev(it)->second);
+                }
+                if (std::next(it) != bucket.end()) {
+                    visitor(std::next(it)->second);
+                }
+                bucket.erase(it);
+                if (bucket.empty()) {
+                    buckets.erase(bucket_it);
+                }
+            }
+
+            /**
+             * Hands the neighbors of the rectangle in its alignment to the visitor.
+             */
+            template<typename Visitor>
+            void for_each_neighbor(const std::vector<Rectangle> &cover, size_t index, Visitor &&visitor) const {
+                const auto &bucket{buckets.at(key(cover[index]))};
+                const auto it{bucket.find({position(cover[index]), index})};
+                if (it != bucket.begin()) {
+                    visitor(std::prev(it)->second);
+                }
+                if (std::next(it) != bucket.end()) {
+                    visitor(std::next(it)->second);
+                }
+            }
+
+        private:
+            [[nodiscard]] Point key(const Rectangle &rectangle) const {
+                return vertical ? Point{rectangle.get_min_x(), rectangle.get_max_x()}
+                                : Point{rectangle.get_min_y(), rectangle.get_max_y()};
+            }
+
+            [[nodiscard]] NumType position(const Rectangle &rectangle) const {
+                return vertical ? rectangle.get_min_y() : rectangle.get_min_x();
+            }
+
+            const bool vertical;
+            Map<Point, Alignment_bucket> buckets;
+        };
+    }
+
+    void Cover_joiner_fixpoint::postprocess_cover(
+        cover::Cover_provider::Cover &cover,
+        const cover::Polygon_with_holes &polygon,
+        const Problem_instance::Costs &costs, Runtime_environment *env,
+        std::optional<Map<Point, size_t>> &covered_points) const {
+      PROFILE_SCOPE("join_fixpoint");
+      LOG(info) << "Running Cover_joiner_fixpoint on returned cover";
+      const auto original_size{cover.size()};
+
+      Alignments x_aligned{false};
+      Alignments y_aligned{true};
+      std::vector<bool> removed(cover.size(), false);
+      std::deque<size_t> queue(cover.size());
+      std::iota(queue.begin(), queue.end(), 0);
+      for (size_t index = 0; index < cover.size(); index++) {
+        x_aligned.insert(cover, index);
+        y_aligned.insert(cover, index);
+      }
+
+      const auto enqueue{[&queue](size_t index) { queue.push_back(index); }};
+      const auto remove{[&](size_t index) {
+        x_aligned.erase(cover, index, enqueue);
+        y_aligned.erase(cover, index, enqueue);
+        removed[index] = true;
+      }};
+
+      std::vector<Join> joins{};
+      size_t attempts{0};
+      while (!queue.empty() && !env->deadline.expired()) {
+        const auto index{queue.front()};
+        queue.pop_front();
+        if (removed[index]) {
+          continue;
+        }
+
+        joins.clear();
+        const auto consider{[&](size_t partner, bool vertical) {
+          const auto current_cost{
+              Problem_instance::calculate_total_cost_of_cover({cover[index], cover[partner]}, costs)};
+          const auto proposed_cost{
+              Problem_instance::calculate_total_cost_of_rectangle(cover[index].join(cover[partner]), costs)};
+          if (proposed_cost < current_cost) {
+            joins.push_back({current_cost - proposed_cost, partner, vertical});
+          }
+        }};
+        x_aligned.for_each_neighbor(cover, index, [&](size_t partner) { consider(partner, false); });
+        y_aligned.for_each_neighbor(cover, index, [&](size_t partner) { consider(partner, true); });
+        std::stable_sort(joins.begin(), joins.end(), [](const Join &lhs, const Join &rhs) {
+          return lhs.saving > rhs.saving;
+        });
+
+        for (const auto &join: joins) {
+          ++attempts;
+          auto joined{cover[index].join(cover[join.partner])};
+          if (!is_valid(polygon, joined, env, join.vertical)) {
+            continue;
+          }
+
+          env->coverage.remove(env->graph, cover[index]);
+          env->coverage.remove(env->graph, cover[join.partner]);
+          env->coverage.add(env->graph, joined);
+          remove(index);
+          remove(join.partner);
+
+          cover.push_back(std::move(joined));
+          removed.push_back(false);
+          x_aligned.insert(cover, cover.size() - 1);
+          y_aligned.insert(cover, cover.size() - 1);
+          queue.push_back(cover.size() - 1);
+          break;
+        }
+      }
+
+      // compact the cover once, keeping the order of the remaining rectangles
+      size_t kept{0};
+      for (size_t index = 0; index < cover.size(); index++) {
+        if (!removed[index]) {
+          cover[kept++] = std::move(cover[index]);
+        }
+      }
+      cover.erase(cover.begin() + static_cast<std::ptrdiff_t>(kept), cover.end());
+
+      PROFILE_COUNT("joined", original_size - cover.size());
+      PROFILE_COUNT("join_attempts", attempts);
+      LOG(info) << "Cover joiner finished after " << attempts << " join attempts";
+    }
+} // cover
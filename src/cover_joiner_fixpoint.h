@@ -0,0 +1,64 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVERING_COVER_JOINER_FIXPOINT_H
+#define COVERING_COVER_JOINER_FIXPOINT_H
+
+#include "cover_joiner.h"
+
+namespace cover {
+
+    /**
+     * @brief Cover joiner which keeps joining aligned rectangles until no join reduces the cost anymore
+     *
+     * Considers the same joins as the Cover_joiner, i.e. of neighboring rectangles with the same top and bottom or
+     * left and right edges, but in both directions at once and repeatedly, which yields covers like a chain of
+     * several joiners. The alignments are kept in ordered buckets which are updated with every join, instead of
+     * being recalculated per pass. Each rectangle is put on a work queue, joined with the neighbor saving the most
+     * cost among its valid joins, and the joined rectangle is queued again, as are the rectangles which became
+     * neighbors because of the join. Joined rectangles are only marked as removed and the cover is compacted once
+     * at the end, so the number of join attempts is linear in the size of the cover.
+     */
+    class Cover_joiner_fixpoint : public Cover_joiner {
+    protected:
+        /**
+         * Function to postprocess the given cover.
+         *
+         * @param cover The cover to postprocess
+         * @param polygon The polygon the cover was calculated for
+         * @param costs The costs associated with the problem instance
+         * @param covered_points Optional map of how many rectangles in the cover cover each point of the polygon
+         */
+        void postprocess_cover(Cover &cover, const Polygon_with_holes &polygon,
+                               const Problem_instance::Costs &costs, Runtime_environment *env,
+                               std::optional<Map<Point, size_t>> &covered_points) const override;
+
+    public:
+        using Cover_joiner::Cover_joiner;
+    };
+
+} // cover
+
+#endif //COVERING_COVER_JOINER_FIXPOINT_H
@@ -23,7 +23,12 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
 #include "cover_joiner_full.h"
+#include "profile.h"
 
 namespace cover {
     bool Cover_joiner_full::is_valid(const Polygon_with_holes &polygon, const Rectangle &rectangle) {
@@ -42,49 +47,161 @@ namespace cover {
         });
     }
 
+    namespace {
+        CGAL::Bbox_2 to_bbox(const Rectangle &rectangle) {
+            return {rectangle.get_min_x(), rectangle.get_min_y(), rectangle.get_max_x(), rectangle.get_max_y()};
+        }
+
+        std::vector<Segment> collect_edges(const Polygon_with_holes &polygon) {
+            std::vector<Segment> edges(polygon.outer_boundary().edges_begin(), polygon.outer_boundary().edges_end());
+            for (const auto &hole: polygon.holes()) {
+                edges.insert(edges.end(), hole.edges_begin(), hole.edges_end());
+            }
+            return edges;
+        }
+
+        size_t cells_per_dimension(size_t edge_count) {
+            return static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(edge_count))));
+        }
+    }
+
+    Cover_joiner_full::Edge_grid::Edge_grid(const Polygon_with_holes &polygon)
+            : edges(collect_edges(polygon)),
+              grid(polygon.outer_boundary().bbox(), cells_per_dimension(edges.size()), cells_per_dimension(edges.size())) {
+        for (size_t i = 0; i < edges.size(); i++) {
+            grid.insert(i, edges[i].bbox());
+        }
+    }
+
+    bool Cover_joiner_full::Edge_grid::is_valid(const Rectangle &rectangle) {
+        const auto &nearby_edges{grid.query(to_bbox(rectangle))};
+        return std::none_of(nearby_edges.begin(), nearby_edges.end(), [&](size_t edge) {
+            return rectangle.fully_intersects(edges[edge]);
+        });
+    }
+
+    bool Cover_joiner_full::Validity_checker::is_valid(const Rectangle &rectangle) {
+        const auto contained{is_contained(polygon, rectangle, env)};
+        if (contained.has_value()) {
+            return contained.value();
+        }
+
+        if (!edge_grid.has_value()) {
+            edge_grid.emplace(polygon);
+        }
+        return edge_grid->is_valid(rectangle);
+    }
+
     void Cover_joiner_full::postprocess_cover(
         Cover_provider::Cover &cover, const Polygon_with_holes &polygon,
         const Problem_instance::Costs &costs, Runtime_environment *env,
         std::optional<Map<Point, size_t>> &covered_points) const {
-      auto it{cover.begin()};
-      while (it != cover.end()) {
-        auto inner_it{it};
+      PROFILE_SCOPE("join_full");
+      const auto original_size{cover.size()};
+
+      Validity_checker validity_checker{polygon, env};
+
+      // cells about the size of an average rectangle, but no more than a few cells per rectangle
+      const auto bounds{polygon.outer_boundary().bbox()};
+      const auto count{static_cast<double>(std::max<size_t>(cover.size(), 1))};
+      const auto max_cells_per_dimension{static_cast<size_t>(2 * std::ceil(std::sqrt(count))) + 1};
+      double total_width{0};
+      double total_height{0};
+      for (const auto &rectangle: cover) {
+        total_width += rectangle.get_max_x() - rectangle.get_min_x();
+        total_height += rectangle.get_max_y() - rectangle.get_min_y();
+      }
+      const auto cells_for{[&](double extent, double average_size) {
+        if (!(average_size > 0)) {
+          return size_t{1};
+        }
+        return std::clamp(static_cast<size_t>(std::ceil(extent / average_size)), size_t{1}, max_cells_per_dimension);
+      }};
+      Uniform_grid rectangle_grid{bounds, cells_for(bounds.xmax() - bounds.xmin(), total_width / count),
+                                  cells_for(bounds.ymax() - bounds.ymin(), total_height / count)};
+      for (size_t i = 0; i < cover.size(); i++) {
+        rectangle_grid.insert(i, to_bbox(cover[i]));
+      }
+
+      std::vector<size_t> partners{};
+      size_t it{0};
+      // every join keeps the cover valid, so it can be stopped after any of them
+      while (it < cover.size() && !env->deadline.expired()) {
+        // all other rectangles cannot reduce the cost, so skipping them does not change which partner is picked
+        const auto &candidates{rectangle_grid.query(get_join_window(cover[it], costs, bounds))};
+        partners.clear();
+        std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(partners),
+                     [&](size_t other) { return other > it; });
+        std::sort(partners.begin(), partners.end());
+
         std::optional<CostType> current_best_cost_reduction{};
-        auto current_best_other_rectangle{inner_it};
-        auto current_best_joined_rectangle{*inner_it};
-        while (++inner_it != cover.end()) {
+        auto current_best_other_rectangle{it};
+        auto current_best_joined_rectangle{cover[it]};
+        for (const auto other: partners) {
           const auto potentially_joined{try_join_rectangles(
-              *it, *inner_it, polygon, costs, current_best_cost_reduction)};
+              cover[it], cover[other], validity_checker, costs, current_best_cost_reduction)};
 
           if (potentially_joined.has_value()) {
             current_best_cost_reduction = potentially_joined.value().second;
-            current_best_other_rectangle = inner_it;
+            current_best_other_rectangle = other;
             current_best_joined_rectangle = potentially_joined.value().first;
           }
         }
         if (current_best_cost_reduction.has_value()) {
-          bool best_is_last{current_best_other_rectangle == cover.end() - 1};
+          env->coverage.remove(env->graph, cover[it]);
+          env->coverage.remove(env->graph, cover[current_best_other_rectangle]);
+          env->coverage.add(env->graph, current_best_joined_rectangle);
+
+          // only the rectangles at these positions are moved around below
+          std::vector<size_t> moved{it, current_best_other_rectangle, cover.size() - 2, cover.size() - 1};
+          std::sort(moved.begin(), moved.end());
+          moved.erase(std::unique(moved.begin(), moved.end()), moved.end());
+          for (const auto position: moved) {
+            rectangle_grid.erase(position, to_bbox(cover[position]));
+          }
+
+          bool best_is_last{current_best_other_rectangle == cover.size() - 1};
 
-          *it = *(cover.end() - 1);
+          cover[it] = cover.back();
           cover.pop_back();
 
           if (!best_is_last) {
-            *current_best_other_rectangle = *(cover.end() - 1);
+            cover[current_best_other_rectangle] = cover.back();
           } else {
-            *it = *(cover.end() - 1);
+            cover[it] = cover.back();
           }
 
           cover.pop_back();
           cover.push_back(current_best_joined_rectangle);
+
+          for (const auto position: moved) {
+            if (position < cover.size()) {
+              rectangle_grid.insert(position, to_bbox(cover[position]));
+            }
+          }
         } else {
           ++it;
         }
       }
+      PROFILE_COUNT("joined", original_size - cover.size());
+    }
+
+    CGAL::Bbox_2 Cover_joiner_full::get_join_window(const Rectangle &rectangle, const Problem_instance::Costs &costs,
+                                                    const CGAL::Bbox_2 &bounds) {
+        if (costs.area_cost == 0) {
+            return bounds;
+        }
+        // the areas are truncated to integers, which may make a join up to one area unit cheaper
+        const auto slack{static_cast<double>(costs.creation_cost) / static_cast<double>(costs.area_cost) + 1};
+        const auto x_margin{slack / (rectangle.get_max_y() - rectangle.get_min_y())};
+        const auto y_margin{slack / (rectangle.get_max_x() - rectangle.get_min_x())};
+        return {rectangle.get_min_x() - x_margin, rectangle.get_min_y() - y_margin,
+                rectangle.get_max_x() + x_margin, rectangle.get_max_y() + y_margin};
     }
 
     std::optional<std::pair<Rectangle, CostType>> Cover_joiner_full::try_join_rectangles(
             const Rectangle &first, const Rectangle &second,
-            const Polygon_with_holes &polygon,
+            Validity_checker &validity_checker,
             const Problem_instance::Costs &costs,
             std::optional<CostType> current_best_cost_reduction) {
         const auto max_x{std::max({first.get_max_x(), second.get_max_x()})};
@@ -105,7 +222,7 @@ namespace cover {
         if (
                 joined_cost >= original_cost ||
                 (current_best_cost_reduction.has_value() && current_best_cost_reduction.value() <= cost_reduction) ||
-                !is_valid(polygon, joined)) {
+                !validity_checker.is_valid(joined)) {
             return {};
         }
 
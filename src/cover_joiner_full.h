@@ -29,6 +29,7 @@
 #include "logging.h"
 
 #include "cover_postprocessor.h"
+#include "uniform_grid.h"
 
 namespace cover {
 
@@ -41,9 +42,63 @@ namespace cover {
      * is valid, if it is, the best cost reduction is updated. At the end of such an iteration, we join the two
      * rectangles giving the best cost reduction, then carry on trying to join the next rectangle until there are no
      * more joins to be considered.
+     *
+     * A uniform grid over the cover's rectangles keeps this feasible for large covers by only proposing partners
+     * close enough for the join to possibly reduce the cost, skipping only pairs which could not change the outcome.
+     * Joined rectangles are checked for validity via the containment index over the base rectangle graph, or if
+     * they are not aligned with the base rectangles, against the polygon's edges close to them.
      */
     class Cover_joiner_full : public Cover_postprocessor {
     protected:
+        /**
+         * @brief The edges of a polygon in a uniform grid, for checking rectangles against the nearby edges only
+         */
+        class Edge_grid {
+        public:
+            /**
+             * Buckets the edges of the polygon's outer boundary and its holes.
+             *
+             * @param polygon The polygon whose edges to bucket
+             */
+            explicit Edge_grid(const Polygon_with_holes &polygon);
+
+            /**
+             * Same as Cover_joiner_full::is_valid for the polygon this grid was built for.
+             *
+             * @param rectangle The rectangle that should be checked for validity
+             * @return Whether no edge of the polygon runs through the rectangle's interior
+             */
+            bool is_valid(const Rectangle &rectangle);
+
+        private:
+            std::vector<Segment> edges;
+            Uniform_grid grid;
+        };
+
+        /**
+         * @brief Checks joined rectangles against the containment index over the base rectangle graph, and against
+         * the polygon's edges for rectangles which are not aligned with the base rectangles
+         */
+        class Validity_checker {
+        public:
+            Validity_checker(const Polygon_with_holes &polygon, Runtime_environment *env)
+                    : polygon(polygon), env(env) {}
+
+            /**
+             * Same as Cover_joiner_full::is_valid for the polygon this checker was created for.
+             *
+             * @param rectangle The rectangle that should be checked for validity
+             * @return Whether the rectangle is fully contained in the polygon
+             */
+            bool is_valid(const Rectangle &rectangle);
+
+        private:
+            const Polygon_with_holes &polygon;
+            Runtime_environment *env;
+            // only built once the first rectangle is not aligned with the base rectangles
+            std::optional<Edge_grid> edge_grid;
+        };
+
         /**
          * Function which calculates whether a given rectangle lies fully within the passed polygon.
          *
@@ -70,7 +125,7 @@ namespace cover {
          *
          * @param first First rectangle to be joined
          * @param second Second rectangle to be joined
-         * @param polygon The polygon the join is taking place in
+         * @param validity_checker The validity checker for the polygon the join is taking place in
          * @param costs The costs associated with the problem instance
          * @param current_best_cost_reduction The cost reduction to compare ours to
          * @return A pair of joined rectangle and cost reduction if the cost reduction is better and the rectangle
@@ -78,10 +133,24 @@ namespace cover {
          */
         static std::optional<std::pair<Rectangle, CostType>> try_join_rectangles(
                 const Rectangle &first, const Rectangle &second,
-                const Polygon_with_holes &polygon,
+                Validity_checker &validity_checker,
                 const Problem_instance::Costs &costs,
                 std::optional<CostType> current_best_cost_reduction);
 
+        /**
+         * Returns the area any rectangle joinable with the given one with a cost reduction has to overlap. Joining
+         * two rectangles whose gap in x direction is d_x adds at least d_x times the first rectangle's height to the
+         * area, which only pays off while this is less than the creation cost divided by the area cost, and likewise
+         * in y direction.
+         *
+         * @param rectangle The rectangle to find join partners for
+         * @param costs The costs associated with the problem instance
+         * @param bounds The area covering all rectangles, returned if the area cost is 0
+         * @return The area join partners have to overlap
+         */
+        static CGAL::Bbox_2 get_join_window(const Rectangle &rectangle, const Problem_instance::Costs &costs,
+                                            const CGAL::Bbox_2 &bounds);
+
         /**
          * Function to postprocess the given cover.
          *
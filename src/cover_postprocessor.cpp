@@ -39,8 +39,19 @@ namespace cover {
         std::optional<Map<Point, size_t>> &covered_points) const {
       auto cover{get_previous_cover_for(polygon, costs, env, covered_points)};
 
+      // the previous cover is valid, postprocessors only improve it, so they can be skipped once out of time
+      if (env->deadline.expired()) {
+        LOG(info) << "Deadline reached, skipping postprocessor";
+        return cover;
+      }
+
       postprocess_cover(cover, polygon, costs, env, covered_points);
 
+      // the point coverage is not updated along with the cover, drop it once the cover changed
+      if (!env->coverage.is_valid(Base_rectangle_coverage::POINTS)) {
+        covered_points.reset();
+      }
+
       return cover;
     }
 
@@ -60,43 +71,37 @@ namespace cover {
     BaseRectGraph& Cover_postprocessor::get_or_calculate_br_graph(
             const Polygon_with_holes &polygon,
             Runtime_environment *env) {
-        if (env->graph.empty()) {
-            env->graph.build(get_or_calculate_brs(polygon, env));
-        }
+        env->ensure_decomposition(polygon);
 
         return env->graph;
     }
 
+    std::optional<bool> Cover_postprocessor::is_contained(
+            const Polygon_with_holes &polygon,
+            const Rectangle &rectangle,
+            Runtime_environment *env) {
+        const auto &graph{get_or_calculate_br_graph(polygon, env)};
+        if (env->containment.empty()) {
+            env->containment.build(graph);
+        }
+
+        return env->containment.contains(graph, rectangle);
+    }
+
     std::vector<Rectangle>& Cover_postprocessor::get_or_calculate_brs(const Polygon_with_holes &polygon,
                                                                       Runtime_environment *env) {
-        if (env->base_rectangles.empty()) {
-            env->base_rectangles = Rectangle_enumerator::get_base_rectangles(polygon);
-        }
+        env->ensure_decomposition(polygon);
 
         return env->base_rectangles;
     }
 
-    std::vector<size_t>& Cover_postprocessor::get_or_calculate_br_coverage(const Polygon_with_holes &polygon,
-                                                                           const Cover_provider::Cover &cover,
-                                                                           Runtime_environment *env) {
-        if (env->base_rectangle_cover_counts.empty()) {
-            const auto &nodes = get_or_calculate_br_graph(polygon, env).getNodes();
-            std::vector<size_t> covered(nodes.size(), 0);
-            for (const auto& rectangle : cover) {
-                LOG(debug) << "Computing base rectangles covered by rectangle " << rectangle.as_polygon() << "...\n";
-
-                const auto tr{rectangle.get_top_right()};
-                const auto bl{rectangle.get_bottom_left()};
-
-                for (auto it = env->graph.begin(tr, bl); it != env->graph.end(); ++it) {
-                    LOG(trace) << "Base rectangle " << *it << " is covered.\n";
-                    ++covered[*it];
-                    assert(rectangle.fully_contains(nodes[*it].base_rectangle));
-                }
-            }
-            env->base_rectangle_cover_counts = std::move(covered);
+    Base_rectangle_coverage& Cover_postprocessor::get_or_calculate_br_coverage(const Polygon_with_holes &polygon,
+                                                                              const Cover_provider::Cover &cover,
+                                                                              Runtime_environment *env) {
+        if (!env->coverage.is_valid(Base_rectangle_coverage::BASE_RECTANGLES)) {
+            env->coverage.build(get_or_calculate_br_graph(polygon, env), cover);
         }
 
-        return env->base_rectangle_cover_counts;
+        return env->coverage;
     }
 }
@@ -96,7 +96,18 @@ namespace cover {
               const Polygon_with_holes &polygon,
               Runtime_environment *env);
 
-      static std::vector<size_t>& get_or_calculate_br_coverage(
+      /**
+       * Returns how many rectangles of the cover contain each base rectangle,
+       * counting them first if no valid counts are left from an earlier
+       * postprocessor. Postprocessors changing the cover have to report every
+       * change to the returned coverage so it stays valid for the next one.
+       *
+       * @param polygon The polygon the cover was calculated for
+       * @param cover The current cover
+       * @param env The environment holding the graph and the coverage
+       * @return The base rectangle coverage of the cover
+       */
+      static Base_rectangle_coverage& get_or_calculate_br_coverage(
               const Polygon_with_holes &polygon,
               const Cover& cover,
               Runtime_environment *env);
@@ -105,6 +116,23 @@ namespace cover {
               const Polygon_with_holes &polygon,
               Runtime_environment *env);
 
+      /**
+       * Returns whether the rectangle lies inside the polygon according to the
+       * containment index over the base rectangle graph, building both if
+       * needed.
+       *
+       * @param polygon The polygon the rectangle should be contained in
+       * @param rectangle The rectangle to check
+       * @param env The environment holding the graph and the index
+       * @return Whether the rectangle lies inside the polygon, nullopt if it
+       * is not aligned with the base rectangles and has to be checked
+       * geometrically
+       */
+      static std::optional<bool> is_contained(
+              const Polygon_with_holes &polygon,
+              const Rectangle &rectangle,
+              Runtime_environment *env);
+
     public:
       /**
        * Returns postprocessed cover for the given polygon with the given costs.
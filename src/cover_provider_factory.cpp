@@ -0,0 +1,164 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cover_provider_factory.h"
+
+#include <stdexcept>
+
+#include "bbox_cover_splitter.h"
+#include "branch_and_bound_algorithm.h"
+#include "cover_joiner.h"
+#include "cover_joiner_fixpoint.h"
+#include "cover_joiner_full.h"
+#include "cover_prune_trimmer.h"
+#include "cover_pruner.h"
+#include "cover_trimmer.h"
+#include "greedy_set_cover_algorithm.h"
+#include "ILP_algorithm.h"
+#include "lagrangian_algorithm.h"
+#include "memory_budget_algorithm.h"
+#include "partition_algorithm.h"
+#include "partition_cover_splitter.h"
+#include "portfolio_algorithm.h"
+#include "strip_algorithm.h"
+
+namespace cover {
+    std::vector<std::string> split(const std::string &str) {
+        std::size_t pos, startPos = 0;
+        std::vector<std::string> tokens;
+        while ((pos = str.find("+", startPos, 1)) != std::string::npos) {
+            tokens.emplace_back(str.substr(startPos, pos - startPos));
+            startPos = pos + 1;
+        }
+        tokens.emplace_back(str.substr(startPos));
+        return tokens;
+    }
+
+    std::unique_ptr<Algorithm> string_to_algorithm(const std::string &str, double timeout, size_t greedy_threads,
+                                                   size_t greedy_candidates) {
+        if (str == "greedy") {
+            return std::make_unique<Greedy_set_cover_algorithm>(false, greedy_threads);
+        } else if (str == "greedy-lazy") {
+            return std::make_unique<Greedy_set_cover_algorithm>(true);
+        } else if (str == "greedy-bounded") {
+            return std::make_unique<Greedy_set_cover_algorithm>(true, 1, greedy_candidates);
+        } else if (str == "lagrangian") {
+            return std::make_unique<Lagrangian_algorithm>(greedy_threads);
+        } else if (str == "strip") {
+            return std::make_unique<Strip_algorithm>();
+        } else if (str == "partition") {
+            return std::make_unique<Partition_algorithm>();
+        }
+#ifdef GUROBI_AVAILABLE
+            else if (str == "ilp") {
+                return std::make_unique<ILP_algorithm>(false, timeout);
+            } else if (str == "ilp-pixel") {
+                return std::make_unique<ILP_algorithm>(true, timeout);
+            } else if (str == "ilp-warm") {
+                return std::make_unique<ILP_algorithm>(false, timeout, true);
+            } else if (str == "ilp-reduced") {
+                return std::make_unique<ILP_algorithm>(false, timeout, true, ILP_algorithm::Formulation::REDUCED);
+            }
+#else
+        else if (str == "ilp" || str == "ilp-pixel" || str == "ilp-warm" || str == "ilp-reduced") {
+            throw std::runtime_error("Cannot use ilp formulation as Gurobi was unavailable at compile time");
+        }
+#endif
+        else {
+            throw std::runtime_error("Unknown algorithm name specified");
+        }
+    }
+
+    namespace {
+        template<class T>
+        std::unique_ptr<Cover_postprocessor> string_to_postprocessor(const std::string &str,
+                                                                     std::unique_ptr<T> previous_provider) {
+            if (str == "prune") {
+                return std::make_unique<Cover_pruner>(std::move(previous_provider));
+            } else if (str == "trim") {
+                return std::make_unique<Cover_trimmer>(std::move(previous_provider));
+            } else if (str == "prune-trim") {
+                return std::make_unique<Cover_prune_trimmer>(std::move(previous_provider));
+            } else if (str == "join") {
+                return std::make_unique<Cover_joiner>(std::move(previous_provider));
+            } else if (str == "join-fixpoint") {
+                return std::make_unique<Cover_joiner_fixpoint>(std::move(previous_provider));
+            } else if (str == "join-full") {
+                return std::make_unique<Cover_joiner_full>(std::move(previous_provider));
+            } else if (str == "bbox-split") {
+                return std::make_unique<Bounding_box_cover_splitter>(std::move(previous_provider));
+            } else if (str == "partition-split") {
+                return std::make_unique<Partition_cover_splitter>(std::move(previous_provider));
+            } else {
+                throw std::runtime_error("Unknown postprocessor name specified: " + str);
+            }
+        }
+    }
+
+    std::unique_ptr<Cover_provider> add_postprocessors(std::unique_ptr<Algorithm> algorithm,
+                                                       const std::vector<std::string> &postprocessor_names) {
+        if (postprocessor_names.empty()) {
+            return algorithm;
+        }
+
+        std::unique_ptr<Cover_postprocessor> current_postprocessor{
+                string_to_postprocessor(postprocessor_names.front(), std::move(algorithm))};
+        for (auto it = postprocessor_names.begin() + 1; it != postprocessor_names.end(); ++it) {
+            current_postprocessor = string_to_postprocessor(*it, std::move(current_postprocessor));
+        }
+        return current_postprocessor;
+    }
+
+    std::unique_ptr<Cover_provider> create_cover_provider(const std::string &base_algorithm_name,
+                                                          const std::vector<std::string> &postprocessor_names,
+                                                          double timeout, size_t greedy_threads,
+                                                          size_t greedy_candidates, size_t exact_below,
+                                                          size_t memory_budget) {
+        auto algorithm{string_to_algorithm(base_algorithm_name, timeout, greedy_threads, greedy_candidates)};
+        if (memory_budget > 0) {
+            algorithm = std::make_unique<Memory_budget_algorithm>(std::move(algorithm), memory_budget,
+                                                                  greedy_candidates);
+        }
+        if (exact_below > 0) {
+            algorithm = std::make_unique<Branch_and_bound_algorithm>(std::move(algorithm), exact_below);
+        }
+        return add_postprocessors(std::move(algorithm), postprocessor_names);
+    }
+
+    std::unique_ptr<Cover_provider> create_portfolio_provider(const std::vector<std::string> &member_names,
+                                                              const std::vector<std::string> &postprocessor_names,
+                                                              double timeout, size_t greedy_threads,
+                                                              size_t greedy_candidates, size_t exact_below,
+                                                              size_t memory_budget) {
+        std::vector<std::unique_ptr<Cover_provider>> members{};
+        for (const auto &member_name: member_names) {
+            const auto tokens{split(member_name)};
+            const std::vector<std::string> member_postprocessor_names(tokens.begin() + 1, tokens.end());
+            members.push_back(create_cover_provider(tokens[0], member_postprocessor_names, timeout, greedy_threads,
+                                                    greedy_candidates, exact_below, memory_budget));
+        }
+        return add_postprocessors(std::make_unique<Portfolio_algorithm>(std::move(members)), postprocessor_names);
+    }
+} // cover
@@ -0,0 +1,109 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVER_PROVIDER_FACTORY_H
+#define COVER_PROVIDER_FACTORY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "algorithm.h"
+#include "cover_provider.h"
+
+namespace cover {
+    /**
+     * Splits a full algorithm name like "strip+prune+trim" into the algorithm and postprocessor names.
+     *
+     * @param str The full name
+     * @return The names in order, the algorithm first
+     */
+    std::vector<std::string> split(const std::string &str);
+
+    /**
+     * Creates the algorithm with the given name, e.g. "greedy" or "strip". Throws if the name is unknown or names an
+     * ILP formulation while Gurobi was unavailable at compile time.
+     *
+     * @param str Name of the algorithm
+     * @param timeout Timeout in seconds per polygon, passed on to algorithms supporting it
+     * @param greedy_threads Number of threads the eager greedy and the lagrangian algorithm use per polygon
+     * @param greedy_candidates Number of candidates the bounded greedy algorithm keeps per corner
+     * @return The algorithm
+     */
+    std::unique_ptr<Algorithm> string_to_algorithm(const std::string &str, double timeout, size_t greedy_threads,
+                                                   size_t greedy_candidates);
+
+    /**
+     * Appends the given postprocessors to the algorithm.
+     *
+     * @param algorithm The underlying algorithm
+     * @param postprocessor_names Names of the postprocessors, executed in order from left to right
+     * @return The resulting cover provider
+     */
+    std::unique_ptr<Cover_provider> add_postprocessors(std::unique_ptr<Algorithm> algorithm,
+                                                       const std::vector<std::string> &postprocessor_names);
+
+    /**
+     * Creates the cover provider consisting of the given algorithm, followed by the given postprocessors in order.
+     *
+     * @param base_algorithm_name Name of the underlying algorithm
+     * @param postprocessor_names Names of the postprocessors, executed in order from left to right
+     * @param timeout Timeout in seconds per polygon, passed on to algorithms supporting it
+     * @param greedy_threads Number of threads the eager greedy and the lagrangian algorithm use per polygon
+     * @param greedy_candidates Number of candidates the bounded greedy algorithm keeps per corner
+     * @param exact_below Polygons with at most this many base rectangles are covered optimally by branch-and-bound
+     * instead of the underlying algorithm, 0 disables it
+     * @param memory_budget Polygons whose estimated memory exceeds this many bytes are covered by a cheaper
+     * algorithm instead of the underlying one, see Memory_budget_algorithm, 0 disables it
+     * @return The resulting cover provider
+     */
+    std::unique_ptr<Cover_provider> create_cover_provider(const std::string &base_algorithm_name,
+                                                          const std::vector<std::string> &postprocessor_names,
+                                                          double timeout, size_t greedy_threads,
+                                                          size_t greedy_candidates, size_t exact_below,
+                                                          size_t memory_budget);
+
+    /**
+     * Creates a portfolio of the given full algorithm names, e.g. "strip+prune+trim", followed by the given
+     * postprocessors, which run on the cheapest cover of the members.
+     *
+     * @param member_names Full names of the algorithms run concurrently
+     * @param postprocessor_names Names of the postprocessors, executed in order from left to right
+     * @param timeout Timeout in seconds per polygon, passed on to algorithms supporting it
+     * @param greedy_threads Number of threads the eager greedy algorithm uses per polygon
+     * @param greedy_candidates Number of candidates the bounded greedy algorithm keeps per corner
+     * @param exact_below Polygons with at most this many base rectangles are covered optimally by every member
+     * @param memory_budget The memory budget in bytes applied to every member on its own, 0 disables it
+     * @return The resulting cover provider
+     */
+    std::unique_ptr<Cover_provider> create_portfolio_provider(const std::vector<std::string> &member_names,
+                                                              const std::vector<std::string> &postprocessor_names,
+                                                              double timeout, size_t greedy_threads,
+                                                              size_t greedy_candidates, size_t exact_below,
+                                                              size_t memory_budget);
+} // cover
+
+#endif //COVER_PROVIDER_FACTORY_H
@@ -0,0 +1,111 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cover_prune_trimmer.h"
+#include "profile.h"
+#include <algorithm>
+#include <numeric>
+
+namespace cover {
+
+void Cover_prune_trimmer::postprocess_cover(
+    Cover_provider::Cover &cover, const Polygon_with_holes &polygon,
+    const Problem_instance::Costs &costs, Runtime_environment *env,
+    std::optional<Map<Point, size_t>> &covered_points) const {
+
+  PROFILE_SCOPE("prune_trim");
+  LOG(info) << "Running Cover_prune_trimmer on cover";
+
+  auto &covered{get_or_calculate_br_coverage(polygon, cover, env)};
+  const auto &graph{env->graph};
+  const auto &nodes{graph.getNodes()};
+
+  // most expensive first, the stable sort keeps rectangles of equal cost in cover order
+  std::vector<size_t> order(cover.size());
+  std::iota(order.begin(), order.end(), 0);
+  {
+    std::vector<CostType> rectangle_costs{};
+    rectangle_costs.reserve(cover.size());
+    for (const auto &rectangle : cover) {
+      rectangle_costs.push_back(Problem_instance::calculate_total_cost_of_rectangle(rectangle, costs));
+    }
+    std::stable_sort(order.begin(), order.end(), [&rectangle_costs](size_t lhs, size_t rhs) {
+      return rectangle_costs[lhs] > rectangle_costs[rhs];
+    });
+  }
+
+  std::vector<bool> pruned(cover.size(), false);
+  size_t num_pruned{0};
+  size_t num_trimmed{0};
+  for (const auto i : order) {
+    if (env->deadline.expired()) {
+      break;
+    }
+    auto &rectangle{cover[i]};
+
+    bool redundant{true};
+    for (auto it = graph.begin(rectangle.get_top_right(), rectangle.get_bottom_left()); it != graph.end(); ++it) {
+      assert(covered[*it] > 0);
+      if (covered[*it] == 1) {
+        redundant = false;
+        break;
+      }
+    }
+
+    if (redundant) {
+      LOG(debug) << "Rectangle " << rectangle.as_polygon() << " is fully redundant, pruning it\n";
+      covered.remove(graph, rectangle);
+      pruned[i] = true;
+      num_pruned++;
+      continue;
+    }
+
+    // at least one base rectangle is covered by this rectangle alone, so trimming cannot make it empty
+    const auto original{rectangle};
+    trim_top(rectangle, nodes, graph, covered);
+    trim_bottom(rectangle, nodes, graph, covered);
+    trim_right(rectangle, nodes, graph, covered);
+    trim_left(rectangle, nodes, graph, covered);
+    if (!(rectangle == original)) {
+      num_trimmed++;
+    }
+  }
+
+  if (num_pruned > 0) {
+    size_t kept{0};
+    for (size_t i = 0; i < cover.size(); ++i) {
+      if (!pruned[i]) {
+        cover[kept++] = cover[i];
+      }
+    }
+    cover.resize(kept);
+  }
+
+  LOG(info) << "Pruned " << num_pruned << " and trimmed " << num_trimmed << " rectangles.";
+  PROFILE_COUNT("pruned", num_pruned);
+  PROFILE_COUNT("trimmed", num_trimmed);
+}
+
+} // cover
@@ -0,0 +1,63 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVER_PRUNE_TRIMMER_H
+#define COVER_PRUNE_TRIMMER_H
+
+#include "cover_trimmer.h"
+
+namespace cover {
+
+    /**
+     * @brief A postprocessor which prunes and trims a cover in a single pass, equivalent in purpose to running
+     * Cover_pruner followed by Cover_trimmer
+     *
+     * The rectangles are handled from the most to the least expensive one, rectangles of equal cost in the order of
+     * the cover. Each rectangle is removed if none of its base rectangles is covered by it alone and trimmed on all
+     * four sides otherwise, so more expensive rectangles give up shared base rectangles first. The surviving
+     * rectangles keep their relative order, which makes the result independent of how the pruning reorders the cover.
+     */
+    class Cover_prune_trimmer : public Cover_trimmer {
+    protected:
+
+        /**
+         * Postprocessing function which removes fully redundant rectangles from the cover and trims the others.
+         *
+         * @param cover The cover to prune and trim
+         * @param polygon The polygon associated with the problem instance
+         * @param costs The costs associated with the problem instance, determine the order the rectangles are handled in
+         * @param covered_points Map of how many rectangles in the cover cover each point of the polygon, becomes stale
+         */
+        void postprocess_cover(
+                Cover &cover, const Polygon_with_holes &polygon,
+                const Problem_instance::Costs &costs, Runtime_environment *env,
+                std::optional<Map<Point, size_t>> &covered_points) const override;
+
+    public:
+        using Cover_trimmer::Cover_trimmer;
+    };
+}
+
+#endif //COVER_PRUNE_TRIMMER_H
@@ -24,7 +24,8 @@
  */
 
 #include "cover_pruner.h"
-#include "rectangle_enumerator.h"
+#include "area_index.h"
+#include "profile.h"
 
 namespace cover {
 
@@ -33,33 +34,42 @@ void Cover_pruner::postprocess_cover(
     const Problem_instance::Costs &costs, Runtime_environment *env,
     std::optional<Map<Point, size_t>> &covered_points) const {
 
+  PROFILE_SCOPE("prune");
   LOG(info) << "Running Cover_pruner on cover";
 
-  env->pixel_coverage_invalidated = true;
-
-  if (env->base_rectangles.empty()) {
-    env->base_rectangles = Rectangle_enumerator::get_base_rectangles(polygon);
-  }
-
-  const auto &nodes = env->graph.getNodes();
-  const auto &topRight = env->graph.getTopRightMap();
-
   size_t num_pruned {0};
 
   auto& covered{ get_or_calculate_br_coverage(polygon, cover, env) };
+  auto &graph{ env->graph };
+
+  // counts the uniquely covered base rectangles, only built if the grid is not larger than the cells spanned by
+  // the cover, which bounds the cost of walking all cover rectangles
+  size_t spanned_cells{0};
+  for (const auto &rectangle : cover) {
+    const auto compact{graph.to_compact_rectangle(rectangle)};
+    spanned_cells += static_cast<size_t>(compact.max_x - compact.min_x) * (compact.max_y - compact.min_y);
+  }
+  Area_index uniquely_covered{};
+  uniquely_covered.build(graph, [&covered](BaseRectNode::PtrType node) { return covered[node] == 1; },
+                         std::min(spanned_cells, Area_index::DEFAULT_MAX_CELLS));
 
-  for (size_t i = 0; i < cover.size();) {
+  for (size_t i = 0; i < cover.size() && !env->deadline.expired();) {
     const auto &rectangle{cover[i]};
     LOG(debug) << "Checking cover rectangle " << rectangle.as_polygon() << "...\n";
     bool redundant = true;
 
     const auto tr{rectangle.get_top_right()};
     const auto bl{rectangle.get_bottom_left()};
+    const auto compact{graph.to_compact_rectangle(rectangle)};
 
-    for (auto it = env->graph.begin(tr, bl); it != env->graph.end(); ++it) {
-      assert(covered[*it] > 0);
-      if (covered[*it] == 1) {
-        redundant = false;
+    if (uniquely_covered.is_cheaper_than_walk(compact)) {
+      redundant = uniquely_covered.sum_within(compact) == 0;
+    } else {
+      for (auto it = graph.begin(tr, bl); it != graph.end(); ++it) {
+        assert(covered[*it] > 0);
+        if (covered[*it] == 1) {
+          redundant = false;
+        }
       }
     }
 
@@ -67,12 +77,13 @@ void Cover_pruner::postprocess_cover(
       LOG(debug) << "Rectangle " << rectangle.as_polygon()
                  << " is fully redundant, pruning it\n";
 
-      // decrement counts
-      for (auto it = env->graph.begin(tr, bl); it != env->graph.end(); ++it) {
-        LOG(trace) << "Base rectangle " << *it << " was covered "
-                   << covered[*it] << " times.\n";
-        assert(covered[*it] > 1);
-        covered[*it]--;
+      covered.remove(graph, rectangle);
+      if (!uniquely_covered.empty()) {
+        for (auto it = graph.begin(tr, bl); it != graph.end(); ++it) {
+          if (covered[*it] == 1) {
+            uniquely_covered.add(graph, *it, 1);
+          }
+        }
       }
 
       num_pruned++;
@@ -85,6 +96,7 @@ void Cover_pruner::postprocess_cover(
     }
   }
   LOG(info) << "Pruned " << num_pruned << " rectangles.";
+  PROFILE_COUNT("pruned", num_pruned);
 }
 
 } // cover
\ No newline at end of file
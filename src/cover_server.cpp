@@ -0,0 +1,240 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "cover_server.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "instance_io.h"
+#include "logging.h"
+#include "result_writer.h"
+
+using json = nlohmann::json;
+
+namespace cover {
+    namespace {
+        Problem_instance::Costs parse_costs(const json &costs) {
+            if (!costs.is_array() || costs.size() != 2 || !costs[0].is_number_unsigned()
+                || !costs[1].is_number_unsigned()) {
+                throw std::runtime_error("costs must be a pair of non-negative integers");
+            }
+            return {costs[0].get<CostType>(), costs[1].get<CostType>()};
+        }
+    }
+
+    Cover_server::Cover_server(Provider_builder builder, bool verify, Algorithm_runner::Verification_method method,
+                               size_t workers, size_t cache_capacity, Run_options options,
+                               Result_writer::Output_options output_options)
+            : builder(std::move(builder)), verify(verify), method(method), workers(std::max<size_t>(1, workers)),
+              cache_capacity(cache_capacity), options(std::move(options)), output_options(output_options) {}
+
+    size_t Cover_server::serve(std::istream &in, std::ostream &out) {
+        // a few requests wait for each worker, so a worker never idles while the next line is parsed
+        Bounded_queue<Request> requests{2 * workers};
+        auto threads{start_workers(requests)};
+
+        const auto connection{std::make_shared<Connection>(out)};
+        read_requests(in, connection, requests);
+        requests.close();
+        for (auto &thread: threads) {
+            thread.join();
+        }
+
+        return connection->failures;
+    }
+
+    void Cover_server::serve_socket(const std::string &socket_path) {
+        using boost::asio::local::stream_protocol;
+
+        // only a socket left behind by an earlier server is replaced, never any other file
+        struct stat status{};
+        if (::lstat(socket_path.c_str(), &status) == 0) {
+            if (!S_ISSOCK(status.st_mode)) {
+                throw std::runtime_error("'" + socket_path + "' exists and is not a socket");
+            }
+            ::unlink(socket_path.c_str());
+        }
+        boost::asio::io_context context{};
+        stream_protocol::acceptor acceptor{context, stream_protocol::endpoint{socket_path}};
+        LOG(info) << "Listening on " << socket_path;
+
+        // all connections share the queue and the workers, so more clients don't mean more concurrent solves, the
+        // readers of the connections hold on to the queue as they may outlive this function
+        const auto requests{std::make_shared<Bounded_queue<Request>>(2 * workers)};
+        auto threads{start_workers(*requests)};
+        try {
+            while (true) {
+                auto stream{std::make_shared<stream_protocol::iostream>()};
+                acceptor.accept(stream->socket());
+                boost::thread{[this, stream, requests]() {
+                    read_requests(*stream, std::make_shared<Connection>(*stream, stream), *requests);
+                    LOG(info) << "Connection closed";
+                }}.detach();
+            }
+        } catch (...) {
+            requests->close();
+            for (auto &thread: threads) {
+                thread.join();
+            }
+            throw;
+        }
+    }
+
+    std::vector<boost::thread> Cover_server::start_workers(Bounded_queue<Request> &requests) {
+        std::vector<boost::thread> threads{};
+        threads.reserve(workers);
+        for (size_t i = 0; i < workers; i++) {
+            threads.emplace_back([this, &requests]() {
+                while (auto request{requests.pop()}) {
+                    const auto reply{handle(request->line)};
+                    auto &connection{*request->connection};
+                    const boost::lock_guard<boost::mutex> lock{connection.mutex};
+                    if (reply.contains("error")) {
+                        connection.failures++;
+                    }
+                    connection.out << reply.dump() << std::endl;
+                }
+            });
+        }
+        return threads;
+    }
+
+    void Cover_server::read_requests(std::istream &in, const std::shared_ptr<Connection> &connection,
+                                     Bounded_queue<Request> &requests) {
+        std::string line{};
+        while (std::getline(in, line)) {
+            if (line.find_first_not_of(" \t\r") != std::string::npos
+                && !requests.push(Request{std::move(line), connection})) {
+                return;
+            }
+        }
+    }
+
+    json Cover_server::handle(const std::string &line) {
+        json reply = json::object();
+        try {
+            const auto request{json::parse(line)};
+            if (request.contains("id")) {
+                reply["id"] = request["id"];
+            }
+
+            const auto costs{parse_costs(request.at("costs"))};
+            const auto algorithm{request.at("algorithm").get<std::string>()};
+            std::vector<std::string> postprocessors{};
+            if (request.contains("postprocessors")) {
+                postprocessors = request["postprocessors"].get<std::vector<std::string>>();
+            }
+            Run_options request_options{options};
+            request_options.timeout = request.value("timeout", options.timeout);
+            const auto include_cover{request.value("include_cover", true)};
+
+            // creating the provider first rejects unknown names before the instance is read
+            const auto provider{builder(algorithm, postprocessors, request_options.timeout)};
+            std::stringstream ss;
+            ss << algorithm;
+            for (const auto &postprocessor: postprocessors) {
+                ss << "+" << postprocessor;
+            }
+
+            bool cache_hit{false};
+            const auto cached{get_instance(request, cache_hit)};
+            const Problem_instance instance{cached->instance, costs.creation_cost, costs.area_cost};
+
+            // another request using the environments would overwrite them, so this one decomposes on its own
+            boost::unique_lock<boost::mutex> lock{cached->mutex, boost::try_to_lock};
+            const bool decomposition_reused{lock.owns_lock() && !cached->environments.empty()};
+            const auto results{Algorithm_runner::run_algorithm(*provider, instance, verify, method, request_options,
+                                                               lock.owns_lock() ? &cached->environments : nullptr)};
+            if (lock.owns_lock()) {
+                lock.unlock();
+            }
+
+            reply.update(Result_writer::reply_to_json(instance, ss.str(), results, include_cover, output_options));
+            reply["cache_hit"] = cache_hit;
+            reply["decomposition_reused"] = decomposition_reused;
+        } catch (const std::exception &e) {
+            LOG(warning) << "Request failed: " << e.what();
+            reply["error"] = e.what();
+        }
+        return reply;
+    }
+
+    std::shared_ptr<Cover_server::Cached_instance> Cover_server::get_instance(const json &request, bool &cache_hit) {
+        const bool inline_geometry{request.contains("wkt")};
+        if (!inline_geometry && !request.contains("input")) {
+            throw std::runtime_error("request needs either \"input\" or \"wkt\"");
+        }
+        // inline geometry is keyed by its text, so resending the same polygons hits the cache as well
+        const auto key{inline_geometry ? "wkt:" + request["wkt"].get<std::string>()
+                                       : "input:" + request["input"].get<std::string>()};
+
+        {
+            const boost::lock_guard<boost::mutex> lock{cache_mutex};
+            const auto it{cache.find(key)};
+            if (it != cache.end()) {
+                recently_used.splice(recently_used.begin(), recently_used, it->second);
+                cache_hit = true;
+                return it->second->second;
+            }
+        }
+
+        // read without holding the lock, so requests for cached instances don't wait for it
+        LOG(info) << "Reading instance " << (inline_geometry ? std::string{"from request"} : key.substr(6));
+        std::shared_ptr<Cached_instance> cached{};
+        if (inline_geometry) {
+            const auto &wkt{request["wkt"].get_ref<const std::string &>()};
+            cached = std::make_shared<Cached_instance>(
+                    Problem_instance{"inline", Instance_io::parse_wkt(wkt.data(), wkt.size()), 0, 0});
+        } else {
+            cached = std::make_shared<Cached_instance>(
+                    Problem_instance{fs::path{request["input"].get<std::string>()}, 0, 0});
+        }
+
+        const boost::lock_guard<boost::mutex> lock{cache_mutex};
+        const auto it{cache.find(key)};
+        if (it != cache.end()) {
+            // a concurrent request read it first, keep that one so both share the environments
+            recently_used.splice(recently_used.begin(), recently_used, it->second);
+            return it->second->second;
+        }
+        recently_used.emplace_front(key, cached);
+        cache[key] = recently_used.begin();
+        while (recently_used.size() > cache_capacity) {
+            cache.erase(recently_used.back().first);
+            recently_used.pop_back();
+        }
+        return cached;
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVER_SERVER_H
+#define COVER_SERVER_H
+
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <nlohmann/json.hpp>
+
+#include "algorithm_runner.h"
+#include "bounded_queue.h"
+#include "cover_provider.h"
+#include "datastructures.h"
+#include "instance.h"
+#include "result_writer.h"
+#include "runtime_environment.h"
+
+namespace cover {
+    /**
+     * @brief Long-running process answering cover requests, keeping recently used instances and their
+     * decompositions in memory
+     *
+     * Requests are read in JSON lines format, one request per line:
+     *
+     *     {"id": 7, "input": "data/a.wkt", "costs": [1, 1], "algorithm": "greedy+prune", "postprocessors": ["trim"]}
+     *
+     * Instead of "input", "wkt" may hold the MULTIPOLYGON itself. "postprocessors", "timeout" (in seconds, the
+     * server's timeout by default) and "include_cover" (true by default) are optional, "id" is copied into the
+     * reply to match it with its request. Each reply is a single line written as soon as the request finished, so
+     * replies may be out of order: the fields of Result_writer::reply_to_json() and "cache_hit", or "error" with a
+     * description if the request failed.
+     *
+     * serve() speaks this protocol over a pair of streams, e.g. stdin and stdout, serve_socket() over the connections
+     * to a Unix domain socket, whose replies go back to the connection the request came from.
+     *
+     * Requests run concurrently on a fixed number of workers, shared by all connections. The instances are kept in a cache which evicts the
+     * least recently used one, along with the Runtime_environment of each of its polygons, so repeated requests for
+     * an instance skip reading it and, like in the Batch_runner, the decomposition into base rectangles and the
+     * BaseRectGraph. Concurrent requests for the same instance don't wait for each other, the ones which find its
+     * environments in use decompose their polygons again.
+     */
+    class Cover_server {
+    public:
+        /**
+         * Function creating the cover provider for an algorithm name, which may contain postprocessors separated by
+         * '+' like the --algorithm option, followed by the given postprocessors, with the timeout of the request.
+         */
+        using Provider_builder = std::function<std::unique_ptr<Cover_provider>(
+                const std::string &algorithm_name, const std::vector<std::string> &postprocessor_names,
+                double timeout)>;
+
+        /**
+         * @param builder Function used to create the cover provider of each request, called concurrently
+         * @param verify Whether to verify the covers
+         * @param method The method used for the verification
+         * @param workers The number of requests handled concurrently, at least 1
+         * @param cache_capacity The number of instances kept in memory
+         * @param options How requests are run, its timeout is used for requests which don't specify one
+         * @param output_options The measurements written to the replies
+         */
+        Cover_server(Provider_builder builder, bool verify, Algorithm_runner::Verification_method method,
+                     size_t workers, size_t cache_capacity, Run_options options,
+                     Result_writer::Output_options output_options);
+
+        /**
+         * Answers the requests read from in until it ends, writing the replies to out. Returns once all requests
+         * were answered.
+         *
+         * @param in The stream to read the requests from
+         * @param out The stream to write the replies to
+         * @return The number of requests which failed
+         */
+        size_t serve(std::istream &in, std::ostream &out);
+
+        /**
+         * Listens on a Unix domain socket and answers the requests of every client connecting to it until the
+         * process is terminated. The requests of all connections go through a single queue to the same workers. A
+         * socket left at the path by an earlier server is replaced, if any other file exists there, a
+         * std::runtime_error is thrown.
+         *
+         * @param socket_path The path of the socket
+         */
+        void serve_socket(const std::string &socket_path);
+
+        /**
+         * Answers a single request, never throws.
+         *
+         * @param line The request as a line of JSON
+         * @return The reply
+         */
+        nlohmann::json handle(const std::string &line);
+
+    private:
+        /**
+         * @brief The stream the replies to the requests of a client are written to
+         */
+        struct Connection {
+            explicit Connection(std::ostream &out, std::shared_ptr<std::iostream> stream = nullptr)
+                    : out(out), stream(std::move(stream)) {}
+
+            std::ostream &out;
+            // keeps the socket of the client open until the last reply was written
+            const std::shared_ptr<std::iostream> stream;
+            // held while writing a reply
+            boost::mutex mutex{};
+            size_t failures{0};
+        };
+
+        struct Request {
+            std::string line;
+            std::shared_ptr<Connection> connection;
+        };
+
+        struct Cached_instance {
+            explicit Cached_instance(Problem_instance instance) : instance(std::move(instance)) {}
+
+            const Problem_instance instance;
+            // held by the request using the environments
+            boost::mutex mutex{};
+            std::vector<Runtime_environment> environments{};
+        };
+
+        /**
+         * Returns the cached instance the request refers to, reading it if it isn't cached.
+         *
+         * @param request The request
+         * @param cache_hit Set to whether the instance was cached
+         * @return The cached instance
+         */
+        std::shared_ptr<Cached_instance> get_instance(const nlohmann::json &request, bool &cache_hit);
+
+        /**
+         * Starts the workers, which answer the requests of the queue until it is closed.
+         *
+         * @param requests The queue of requests
+         * @return The worker threads
+         */
+        std::vector<boost::thread> start_workers(Bounded_queue<Request> &requests);
+
+        /**
+         * Reads requests from in until it ends and appends them to the queue, returns early if the queue was closed.
+         *
+         * @param in The stream to read the requests from
+         * @param connection Where the replies to the requests go
+         * @param requests The queue of requests
+         */
+        static void read_requests(std::istream &in, const std::shared_ptr<Connection> &connection,
+                                  Bounded_queue<Request> &requests);
+
+        const Provider_builder builder;
+        const bool verify;
+        const Algorithm_runner::Verification_method method;
+        const size_t workers;
+        const size_t cache_capacity;
+        const Run_options options;
+        const Result_writer::Output_options output_options;
+
+        boost::mutex cache_mutex{};
+        // the cached instances by key, the most recently used first
+        std::list<std::pair<std::string, std::shared_ptr<Cached_instance>>> recently_used{};
+        Map<std::string, decltype(recently_used)::iterator> cache{};
+    };
+}
+
+#endif //COVER_SERVER_H
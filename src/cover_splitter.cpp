@@ -23,21 +23,24 @@
  * SOFTWARE.
  */
 
+#include <optional>
+
 #include "cover_splitter.h"
+#include "profile.h"
 
 namespace cover {
     void Cover_splitter::postprocess_cover(Cover &cover, const Polygon_with_holes &polygon,
                                            const Problem_instance::Costs &costs, Runtime_environment *env,
                                            std::optional<Map<Point, size_t>> &covered_points) const {
+        PROFILE_SCOPE("split");
         LOG(info) << "Subclass of Cover_splitter postprocessing cover";
 
         get_or_calculate_br_coverage(polygon, cover, env);
-        env->pixel_coverage_invalidated = true;
 
         std::vector<Rectangle> newly_added_rectangles{};
 
         auto rectangle_it{cover.begin()};
-        while (rectangle_it != cover.end()) {
+        while (rectangle_it != cover.end() && !env->deadline.expired()) {
             const auto current_costs{Problem_instance::calculate_cost_of_rectangle(*rectangle_it, costs)};
             const auto current_total_cost{current_costs.area_cost + current_costs.creation_cost};
 
@@ -50,6 +53,7 @@ namespace cover {
 
             if (new_total_cost < current_total_cost) {
                 LOG(debug) << "Split improves solution, adding to cover, removing old rectangle";
+                PROFILE_COUNT("split", 1);
                 newly_added_rectangles.insert(newly_added_rectangles.end(), split.begin(), split.end());
                 reduce_covered_amount(polygon, *rectangle_it, split, env);
 
@@ -72,7 +76,7 @@ namespace cover {
         LOG(debug) << "Updating covered brs for new split";
         assert(!env->base_rectangles.empty() && !env->graph.empty());
 
-        auto& covered{env->base_rectangle_cover_counts};
+        auto& covered{env->coverage};
         const auto& nodes{ env->graph.getNodes() };
 
         const auto tr{ original_rectangle.get_top_right() };
@@ -88,42 +92,35 @@ namespace cover {
             };
 
             if (!still_covered) {
-                --covered[*it];
+                covered.decrement(*it);
                 assert(covered[*it] >= 1);
             }
         }
     }
 
     std::vector<Polygon_with_holes> Cover_splitter::split_into_polygons(const Rectangle &rectangle, Runtime_environment *env) {
-        assert(!env->graph.empty() && !env->base_rectangle_cover_counts.empty() && !env->base_rectangles.empty());
-
-        const auto& nodes{ env->graph.getNodes() };
-
-        auto uniquely_covered{ get_uniquely_covered_brs(rectangle, env) };
-        std::vector<Polygon> as_polygons{};
-        std::sort(uniquely_covered.begin(), uniquely_covered.end(),
-            [&nodes](const auto &first, const auto &second) {
-                return nodes[first].base_rectangle < nodes[second].base_rectangle;
-            });
-        for (auto& unique_br : uniquely_covered) {
-            const auto& base_rect{ nodes[unique_br].base_rectangle };
-            LOG(trace) << base_rect.as_polygon();
-            as_polygons.push_back(base_rect.as_polygon());
-        }
-
         std::vector<Polygon_with_holes> split_polygons{};
-        CGAL::join(as_polygons.begin(), as_polygons.end(),
-                   std::back_inserter(split_polygons), CGAL::Tag_false());
+        for (const auto& region : get_uniquely_covered_regions(rectangle, env)) {
+            split_polygons.push_back(region.to_polygon(env->graph));
+        }
 
         return split_polygons;
     }
 
+    std::vector<Base_rectangle_region>
+    Cover_splitter::get_uniquely_covered_regions(const Rectangle &rectangle, Runtime_environment *env) {
+        const auto regions{ Base_rectangle_region::find_regions(env->graph, get_uniquely_covered_brs(rectangle, env)) };
+        LOG(trace) << "Found " << regions.size() << " uniquely covered regions";
+        return regions;
+    }
+
     std::vector<BaseRectNode::PtrType>
     Cover_splitter::get_uniquely_covered_brs(const Rectangle &rectangle, Runtime_environment *env) {
-        assert(!env->graph.empty() && !env->base_rectangle_cover_counts.empty() && !env->base_rectangles.empty());
+        assert(!env->graph.empty() && !env->base_rectangles.empty()
+               && env->coverage.is_valid(Base_rectangle_coverage::BASE_RECTANGLES));
 
         auto& graph{ env->graph };
-        const auto& covered{ env->base_rectangle_cover_counts };
+        const auto& covered{ env->coverage };
         std::vector<BaseRectNode::PtrType> uniquely_covered{};
 
         const auto tr{ rectangle.get_top_right() };
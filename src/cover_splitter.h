@@ -31,6 +31,7 @@
 #include "logging.h"
 
 #include "CGAL_classes.h"
+#include "base_rectangle_region.h"
 #include "cover_postprocessor.h"
 #include "rectangle.h"
 #include "instance.h"
@@ -80,7 +81,17 @@ namespace cover {
                               const std::vector<Rectangle> &split_rectangle,
                               Runtime_environment *env);
 
-        static std::vector<Polygon_with_holes> 
+        /**
+         * Groups the base rectangles within rectangle which are covered exactly once into connected regions.
+         *
+         * @param rectangle A rectangle of the cover
+         * @return The connected regions of uniquely covered base rectangles within rectangle
+         */
+        static std::vector<Base_rectangle_region>
+        get_uniquely_covered_regions(const Rectangle &rectangle,
+                                     Runtime_environment *env);
+
+        static std::vector<Polygon_with_holes>
         split_into_polygons(const Rectangle &rectangle,
                             Runtime_environment *env);
 
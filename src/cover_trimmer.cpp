@@ -24,36 +24,43 @@
  */
 
 #include "cover_trimmer.h"
+#include "profile.h"
 
 namespace cover {
     void Cover_trimmer::postprocess_cover(
             Cover &cover, const Polygon_with_holes &polygon,
             const Problem_instance::Costs &costs, Runtime_environment *env,
             std::optional<Map<Point, size_t>> &covered_points) const {
-
-        env->pixel_coverage_invalidated = true;
+        PROFILE_SCOPE("trim");
 
         auto& br_coverage{ get_or_calculate_br_coverage(polygon, cover, env) };
-        const auto& top_right_map{ env->graph.getTopRightMap() };
-        const auto& bottom_left_map{ env->graph.getBottomLeftMap() };
         const auto& nodes{ env->graph.getNodes() };
 
+        size_t num_trimmed{0};
         for (auto& rectangle : cover) {
-            trim_top(rectangle, nodes, top_right_map, bottom_left_map, br_coverage);
-            trim_bottom(rectangle, nodes, top_right_map, bottom_left_map, br_coverage);
-            trim_right(rectangle, nodes, top_right_map, bottom_left_map, br_coverage);
-            trim_left(rectangle, nodes, top_right_map, bottom_left_map, br_coverage);
+            if (env->deadline.expired()) {
+                break;
+            }
+            const auto original{rectangle};
+            trim_top(rectangle, nodes, env->graph, br_coverage);
+            trim_bottom(rectangle, nodes, env->graph, br_coverage);
+            trim_right(rectangle, nodes, env->graph, br_coverage);
+            trim_left(rectangle, nodes, env->graph, br_coverage);
+            if (!(rectangle == original)) {
+                num_trimmed++;
+            }
         }
+        PROFILE_COUNT("trimmed", num_trimmed);
     }
 
     void Cover_trimmer::trim_top(cover::Rectangle &rectangle_to_trim,
                                    const std::vector<BaseRectNode>& nodes,
-                                   const BaseRectGraph::PointBaseRectMap& top_right_map,
-                                   const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                                   std::vector<BaseRectNode::PtrType>& br_coverage) {
+                                   const BaseRectGraph& graph,
+                                   Base_rectangle_coverage& br_coverage) {
 
         auto top_right{ rectangle_to_trim.get_top_right() };
-        auto curr_br_idx{ top_right_map.at(top_right) };
+        auto curr_br_idx{ graph.find_top_right(top_right) };
+        assert(curr_br_idx != BaseRectNode::NO_NEIGHBOR);
         while (true) {
             const auto& curr_right_br{ nodes[curr_br_idx] };
             const auto top_left{ rectangle_to_trim.get_top_left() };
@@ -85,7 +92,7 @@ namespace cover {
                 rectangle_to_trim.shrink_down(height);
                 curr_br_idx = curr_right_br.bottom;
                 for (const auto idx : seen_brs) {
-                    --br_coverage[idx];
+                    br_coverage.decrement(idx);
                 }
             }
         }
@@ -93,12 +100,12 @@ namespace cover {
 
     void Cover_trimmer::trim_left(cover::Rectangle &rectangle_to_trim,
                                     const std::vector<BaseRectNode>& nodes,
-                                    const BaseRectGraph::PointBaseRectMap& top_right_map,
-                                    const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                                    std::vector<BaseRectNode::PtrType>& br_coverage) {
+                                    const BaseRectGraph& graph,
+                                    Base_rectangle_coverage& br_coverage) {
 
         auto bottom_left{ rectangle_to_trim.get_bottom_left() };
-        auto curr_br_idx{ bottom_left_map.at(bottom_left) };
+        auto curr_br_idx{ graph.find_bottom_left(bottom_left) };
+        assert(curr_br_idx != BaseRectNode::NO_NEIGHBOR);
         while (true) {
             const auto& curr_bottom_br{ nodes[curr_br_idx] };
             const auto top_left{ rectangle_to_trim.get_top_left() };
@@ -130,7 +137,7 @@ namespace cover {
                 rectangle_to_trim.shrink_left(width);
                 curr_br_idx = curr_bottom_br.right;
                 for (const auto idx : seen_brs) {
-                    --br_coverage[idx];
+                    br_coverage.decrement(idx);
                 }
             }
         }
@@ -138,12 +145,12 @@ namespace cover {
 
     void Cover_trimmer::trim_bottom(cover::Rectangle &rectangle_to_trim,
                                       const std::vector<BaseRectNode>& nodes,
-                                      const BaseRectGraph::PointBaseRectMap& top_right_map,
-                                      const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                                      std::vector<BaseRectNode::PtrType>& br_coverage) {
+                                      const BaseRectGraph& graph,
+                                      Base_rectangle_coverage& br_coverage) {
 
         auto bottom_left{ rectangle_to_trim.get_bottom_left() };
-        auto curr_br_idx{ bottom_left_map.at(bottom_left) };
+        auto curr_br_idx{ graph.find_bottom_left(bottom_left) };
+        assert(curr_br_idx != BaseRectNode::NO_NEIGHBOR);
         while (true) {
             const auto& curr_left_br{ nodes[curr_br_idx] };
             const auto bottom_right{ rectangle_to_trim.get_bottom_right() };
@@ -175,7 +182,7 @@ namespace cover {
                 rectangle_to_trim.shrink_up(height);
                 curr_br_idx = curr_left_br.top;
                 for (const auto idx : seen_brs) {
-                    --br_coverage[idx];
+                    br_coverage.decrement(idx);
                 }
             }
         }
@@ -183,11 +190,11 @@ namespace cover {
 
     void Cover_trimmer::trim_right(cover::Rectangle &rectangle_to_trim,
                                      const std::vector<BaseRectNode>& nodes,
-                                     const BaseRectGraph::PointBaseRectMap& top_right_map,
-                                     const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                                     std::vector<BaseRectNode::PtrType>& br_coverage) {
+                                     const BaseRectGraph& graph,
+                                     Base_rectangle_coverage& br_coverage) {
         auto top_right{ rectangle_to_trim.get_top_right() };
-        auto curr_br_idx{ top_right_map.at(top_right) };
+        auto curr_br_idx{ graph.find_top_right(top_right) };
+        assert(curr_br_idx != BaseRectNode::NO_NEIGHBOR);
         while (true) {
             const auto& curr_top_br{ nodes[curr_br_idx] };
             const auto bottom_right{ rectangle_to_trim.get_bottom_right() };
@@ -219,7 +226,7 @@ namespace cover {
                 rectangle_to_trim.shrink_right(width);
                 curr_br_idx = curr_top_br.left;
                 for (const auto idx : seen_brs) {
-                    --br_coverage[idx];
+                    br_coverage.decrement(idx);
                 }
             }
         }
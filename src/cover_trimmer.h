@@ -42,30 +42,26 @@ namespace cover {
         static void trim_top(
                 Rectangle& rectangle_to_trim,
                 const std::vector<BaseRectNode>& nodes,
-                const BaseRectGraph::PointBaseRectMap& top_right_map,
-                const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                std::vector<BaseRectNode::PtrType>& br_coverage);
+                const BaseRectGraph& graph,
+                Base_rectangle_coverage& br_coverage);
 
         static void trim_left(
                 Rectangle& rectangle_to_trim,
                 const std::vector<BaseRectNode>& nodes,
-                const BaseRectGraph::PointBaseRectMap& top_right_map,
-                const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                std::vector<BaseRectNode::PtrType>& br_coverage);
+                const BaseRectGraph& graph,
+                Base_rectangle_coverage& br_coverage);
 
         static void trim_bottom(
                 Rectangle& rectangle_to_trim,
                 const std::vector<BaseRectNode>& nodes,
-                const BaseRectGraph::PointBaseRectMap& top_right_map,
-                const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                std::vector<BaseRectNode::PtrType>& br_coverage);
+                const BaseRectGraph& graph,
+                Base_rectangle_coverage& br_coverage);
 
         static void trim_right(
                 Rectangle& rectangle_to_trim,
                 const std::vector<BaseRectNode>& nodes,
-                const BaseRectGraph::PointBaseRectMap& top_right_map,
-                const BaseRectGraph::PointBaseRectMap& bottom_left_map,
-                std::vector<BaseRectNode::PtrType>& br_coverage);
+                const BaseRectGraph& graph,
+                Base_rectangle_coverage& br_coverage);
 
     public:
         using Cover_postprocessor::Cover_postprocessor;
@@ -0,0 +1,106 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "covering.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "cover_provider_factory.h"
+#include "instance_io.h"
+#include "util.h"
+
+namespace cover {
+    Cover_solver::Cover_solver(Settings settings_)
+        : settings(std::move(settings_)),
+          names(split(settings.algorithm)),
+          factory([this]() {
+              return create_cover_provider(names[0], {names.begin() + 1, names.end()}, settings.timeout,
+                                           settings.greedy_threads, settings.greedy_candidates,
+                                           settings.exact_below, 0);
+          }) {
+        if (names.empty() || names[0] == "portfolio") {
+            throw std::invalid_argument("Unsupported algorithm '" + settings.algorithm + "'");
+        }
+        try {
+            // creating the provider once reports unknown names here instead of on the first call
+            factory();
+        } catch (const std::runtime_error &e) {
+            throw std::invalid_argument(e.what());
+        }
+    }
+
+    Cover_solver::Cover_result Cover_solver::cover(MultiPolygon multi_polygon) const {
+#ifdef COVER_INTEGER_COORDINATES
+        if (!Instance_io::has_integer_coordinates(multi_polygon)) {
+            throw std::invalid_argument("The polygons have non-integer coordinates, which this build does not support");
+        }
+#endif
+        for (auto &polygon: multi_polygon) {
+            Util::normalize_orientation(polygon);
+        }
+        const auto polygon_count{multi_polygon.size()};
+        const Problem_instance instance{"embedded", std::move(multi_polygon), settings.creation_cost,
+                                        settings.area_cost};
+
+        Run_options options{};
+        options.timeout = settings.timeout;
+        const auto results{Algorithm_runner::run_algorithm(
+                factory, instance, settings.verify, std::max<size_t>(settings.threads, 1),
+                Algorithm_runner::Verification_method::BASE_RECTANGLE_GRAPH, options)};
+
+        Cover_result cover_result{};
+        cover_result.cost = results[0].cost;
+        cover_result.rectangles.reserve(4 * results[0].cover_size);
+        cover_result.rectangle_offsets.reserve(polygon_count + 1);
+        cover_result.rectangle_offsets.push_back(0);
+        for (size_t polygon = 1; polygon < results.size(); polygon++) {
+            const auto &result{results[polygon]};
+            for (const auto &rectangle: result.cover) {
+                cover_result.rectangles.insert(cover_result.rectangles.end(),
+                                               {static_cast<double>(rectangle.get_min_x()),
+                                                static_cast<double>(rectangle.get_min_y()),
+                                                static_cast<double>(rectangle.get_max_x()),
+                                                static_cast<double>(rectangle.get_max_y())});
+            }
+            cover_result.rectangle_offsets.push_back(cover_result.rectangles.size() / 4);
+            cover_result.timeout |= result.is_valid == Algorithm_runner::Result::Validity::TIMEOUT;
+            cover_result.invalid |= result.is_valid == Algorithm_runner::Result::Validity::INVALID;
+        }
+
+        return cover_result;
+    }
+
+    Cover_solver::Cover_result Cover_solver::cover(const int64_t *coordinates, const uint64_t *vertex_offsets,
+                                                   const uint64_t *ring_offsets, size_t polygon_count) const {
+        return cover(Instance_io::from_arrays(coordinates, vertex_offsets, ring_offsets, polygon_count));
+    }
+
+    Cover_solver::Cover_result Cover_solver::cover(const double *coordinates, const uint64_t *vertex_offsets,
+                                                   const uint64_t *ring_offsets, size_t polygon_count) const {
+        return cover(Instance_io::from_arrays(coordinates, vertex_offsets, ring_offsets, polygon_count));
+    }
+} // cover
@@ -0,0 +1,141 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVERING_H
+#define COVERING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "algorithm_runner.h"
+#include "CGAL_classes.h"
+#include "instance.h"
+
+namespace cover {
+
+    /**
+     * @brief Entry point for applications embedding the library instead of running covering_run
+     *
+     * Covers polygons handed over in memory, either as a MultiPolygon or as flat coordinate arrays in the layout of
+     * Instance_io::from_arrays(), with the cover provider named like the --algorithm option of the command line
+     * interface. The cover is returned as a flat array of rectangles rather than as Rectangle objects, so it can be
+     * passed on without depending on CGAL, see covering_c.h for the C interface built on top of it.
+     *
+     * Everything a call depends on, including the timeout, is local to the solver, so solvers with different settings
+     * can cover concurrently and a single solver can be used by several threads at once.
+     */
+    class Cover_solver {
+    public:
+        struct Settings {
+            /**
+             * Full name of the cover provider, e.g. "greedy+prune+trim", "portfolio" is not supported
+             */
+            std::string algorithm{"greedy+prune+trim"};
+            CostType creation_cost{1};
+            CostType area_cost{0};
+            /**
+             * Number of threads covering the polygons of a call, see Algorithm_runner::run_algorithm()
+             */
+            size_t threads{1};
+            /**
+             * Timeout in seconds per polygon, 0 disables it
+             */
+            double timeout{0};
+            size_t greedy_threads{1};
+            size_t greedy_candidates{4};
+            size_t exact_below{0};
+            /**
+             * Whether to check the covers with the base rectangle graph
+             */
+            bool verify{false};
+        };
+
+        struct Cover_result {
+            /**
+             * Four values per rectangle: min x, min y, max x and max y
+             */
+            std::vector<double> rectangles;
+            /**
+             * The index of the first rectangle of each polygon, with one trailing entry holding the total
+             */
+            std::vector<uint64_t> rectangle_offsets;
+            Problem_instance::Costs cost;
+            /**
+             * Whether any polygon was not covered by the end of the timeout, its cover is valid but may be expensive
+             */
+            bool timeout{false};
+            /**
+             * Whether a verified cover was invalid, always false without Settings::verify
+             */
+            bool invalid{false};
+        };
+
+        /**
+         * Throws std::invalid_argument if the algorithm name in the settings is unknown.
+         *
+         * @param settings The settings used for all calls
+         */
+        explicit Cover_solver(Settings settings);
+
+        // the provider factory refers to the solver it belongs to
+        Cover_solver(const Cover_solver &other) = delete;
+        Cover_solver &operator=(const Cover_solver &other) = delete;
+
+        /**
+         * Throws std::invalid_argument if rectangles store integer coordinates, see Coordinate, and a vertex of the
+         * polygons has a non-integer coordinate. Rings may have either orientation, see Util::normalize_orientation.
+         *
+         * @param multi_polygon The polygons to cover
+         * @return The covers of the polygons
+         */
+        [[nodiscard]] Cover_result cover(MultiPolygon multi_polygon) const;
+
+        /**
+         * Covers polygons given as flat arrays, see Instance_io::from_arrays() for the layout and thrown exceptions.
+         */
+        [[nodiscard]] Cover_result cover(const int64_t *coordinates, const uint64_t *vertex_offsets,
+                                         const uint64_t *ring_offsets, size_t polygon_count) const;
+
+        /**
+         * Covers polygons given as flat arrays, see Instance_io::from_arrays() for the layout and thrown exceptions.
+         */
+        [[nodiscard]] Cover_result cover(const double *coordinates, const uint64_t *vertex_offsets,
+                                         const uint64_t *ring_offsets, size_t polygon_count) const;
+
+        [[nodiscard]] const Settings &get_settings() const {
+            return settings;
+        }
+
+    private:
+        const Settings settings;
+        const std::vector<std::string> names;
+        const Algorithm_runner::Provider_factory factory;
+    };
+
+} // cover
+
+#endif //COVERING_H
@@ -0,0 +1,157 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "covering_c.h"
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "covering.h"
+
+struct covering_solver {
+    explicit covering_solver(cover::Cover_solver::Settings settings) : solver(std::move(settings)) {}
+
+    cover::Cover_solver solver;
+};
+
+struct covering_result {
+    cover::Cover_solver::Cover_result result;
+};
+
+namespace {
+    thread_local std::string last_error{};
+
+    /**
+     * Runs the function, translating exceptions into status codes, as they must not cross the C interface.
+     */
+    template<class F>
+    covering_status guarded(F &&function) {
+        try {
+            function();
+            return COVERING_OK;
+        } catch (const std::invalid_argument &e) {
+            last_error = e.what();
+            return COVERING_INVALID_ARGUMENT;
+        } catch (const std::exception &e) {
+            last_error = e.what();
+            return COVERING_ERROR;
+        } catch (...) {
+            last_error = "unknown error";
+            return COVERING_ERROR;
+        }
+    }
+
+    template<class T>
+    covering_status cover_arrays(const covering_solver *solver, const T *coordinates, const uint64_t *vertex_offsets,
+                                 const uint64_t *ring_offsets, size_t polygon_count, covering_result **result) {
+        return guarded([&]() {
+            if (solver == nullptr || result == nullptr || ring_offsets == nullptr
+                || (polygon_count > 0 && (coordinates == nullptr || vertex_offsets == nullptr))) {
+                throw std::invalid_argument("null pointer passed");
+            }
+            *result = nullptr;
+            auto cover_result{solver->solver.cover(coordinates, vertex_offsets, ring_offsets, polygon_count)};
+            *result = new covering_result{std::move(cover_result)};
+        });
+    }
+}
+
+extern "C" {
+    void covering_default_settings(covering_settings *settings) {
+        static const std::string algorithm{cover::Cover_solver::Settings{}.algorithm};
+        const cover::Cover_solver::Settings defaults{};
+        *settings = {algorithm.c_str(), defaults.creation_cost, defaults.area_cost, defaults.threads,
+                     defaults.timeout, defaults.greedy_threads, defaults.greedy_candidates, defaults.exact_below,
+                     defaults.verify ? 1 : 0};
+    }
+
+    covering_status covering_solver_create(const covering_settings *settings, covering_solver **solver) {
+        return guarded([&]() {
+            if (settings == nullptr || settings->algorithm == nullptr || solver == nullptr) {
+                throw std::invalid_argument("null pointer passed");
+            }
+            *solver = nullptr;
+            *solver = new covering_solver{{settings->algorithm, settings->creation_cost, settings->area_cost,
+                                           settings->threads, settings->timeout, settings->greedy_threads,
+                                           settings->greedy_candidates, settings->exact_below,
+                                           settings->verify != 0}};
+        });
+    }
+
+    void covering_solver_destroy(covering_solver *solver) {
+        delete solver;
+    }
+
+    covering_status covering_cover_i64(const covering_solver *solver, const int64_t *coordinates,
+                                       const uint64_t *vertex_offsets, const uint64_t *ring_offsets,
+                                       size_t polygon_count, covering_result **result) {
+        return cover_arrays(solver, coordinates, vertex_offsets, ring_offsets, polygon_count, result);
+    }
+
+    covering_status covering_cover_f64(const covering_solver *solver, const double *coordinates,
+                                       const uint64_t *vertex_offsets, const uint64_t *ring_offsets,
+                                       size_t polygon_count, covering_result **result) {
+        return cover_arrays(solver, coordinates, vertex_offsets, ring_offsets, polygon_count, result);
+    }
+
+    size_t covering_result_rectangle_count(const covering_result *result) {
+        return result->result.rectangles.size() / 4;
+    }
+
+    const double *covering_result_rectangles(const covering_result *result) {
+        return result->result.rectangles.data();
+    }
+
+    const uint64_t *covering_result_rectangle_offsets(const covering_result *result) {
+        return result->result.rectangle_offsets.data();
+    }
+
+    uint64_t covering_result_creation_cost(const covering_result *result) {
+        return result->result.cost.creation_cost;
+    }
+
+    uint64_t covering_result_area_cost(const covering_result *result) {
+        return result->result.cost.area_cost;
+    }
+
+    int covering_result_timeout(const covering_result *result) {
+        return result->result.timeout ? 1 : 0;
+    }
+
+    int covering_result_invalid(const covering_result *result) {
+        return result->result.invalid ? 1 : 0;
+    }
+
+    void covering_result_destroy(covering_result *result) {
+        delete result;
+    }
+
+    const char *covering_last_error(void) {
+        return last_error.c_str();
+    }
+}
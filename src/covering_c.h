@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVERING_C_H
+#define COVERING_C_H
+
+/*
+ * C interface of the covering library, a thin wrapper around cover::Cover_solver. Polygons are passed as flat arrays:
+ * for each polygon the index of its first ring and for each ring the index of its first vertex, both with one trailing
+ * entry holding the total, and the interleaved x and y coordinates of the vertices. The first ring of a polygon is its
+ * outer boundary, the remaining ones are its holes.
+ *
+ * Functions returning a covering_status store a description of the error for the calling thread, which can be read
+ * with covering_last_error() until the next failing call of that thread.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct covering_solver covering_solver;
+typedef struct covering_result covering_result;
+
+typedef enum {
+    COVERING_OK = 0,
+    /* unknown algorithm name, malformed offsets, null pointers */
+    COVERING_INVALID_ARGUMENT = 1,
+    /* any other failure while covering */
+    COVERING_ERROR = 2
+} covering_status;
+
+typedef struct {
+    /* full name of the cover provider, e.g. "greedy+prune+trim", copied on creation */
+    const char *algorithm;
+    uint64_t creation_cost;
+    uint64_t area_cost;
+    size_t threads;
+    /* timeout in seconds per polygon, 0 disables it */
+    double timeout;
+    size_t greedy_threads;
+    size_t greedy_candidates;
+    size_t exact_below;
+    /* non-zero to check the covers */
+    int verify;
+} covering_settings;
+
+/* Fills the settings with the defaults of cover::Cover_solver::Settings. */
+void covering_default_settings(covering_settings *settings);
+
+covering_status covering_solver_create(const covering_settings *settings, covering_solver **solver);
+
+void covering_solver_destroy(covering_solver *solver);
+
+/* Covers polygons with integer coordinates, the result has to be released with covering_result_destroy(). */
+covering_status covering_cover_i64(const covering_solver *solver, const int64_t *coordinates,
+                                   const uint64_t *vertex_offsets, const uint64_t *ring_offsets, size_t polygon_count,
+                                   covering_result **result);
+
+/* Covers polygons with double coordinates, the result has to be released with covering_result_destroy(). Libraries
+ * built with integer coordinates fail with COVERING_INVALID_ARGUMENT if a coordinate is not an integer. */
+covering_status covering_cover_f64(const covering_solver *solver, const double *coordinates,
+                                   const uint64_t *vertex_offsets, const uint64_t *ring_offsets, size_t polygon_count,
+                                   covering_result **result);
+
+size_t covering_result_rectangle_count(const covering_result *result);
+
+/* Four values per rectangle: min x, min y, max x and max y, valid until the result is destroyed. */
+const double *covering_result_rectangles(const covering_result *result);
+
+/* The index of the first rectangle of each polygon, polygon_count + 1 entries, valid until the result is destroyed. */
+const uint64_t *covering_result_rectangle_offsets(const covering_result *result);
+
+uint64_t covering_result_creation_cost(const covering_result *result);
+
+uint64_t covering_result_area_cost(const covering_result *result);
+
+/* Non-zero if any polygon reached the timeout. */
+int covering_result_timeout(const covering_result *result);
+
+/* Non-zero if a verified cover was invalid. */
+int covering_result_invalid(const covering_result *result);
+
+void covering_result_destroy(covering_result *result);
+
+/* Description of the last error of the calling thread, empty if there was none. */
+const char *covering_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COVERING_C_H */
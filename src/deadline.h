@@ -0,0 +1,100 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+namespace cover {
+    /**
+     * @brief Cooperative per-polygon time limit
+     *
+     * Algorithms and postprocessors check the deadline between steps after which their cover is still valid and stop
+     * early once it expired, returning the best cover they have so far. A default constructed deadline never expires.
+     * Once any stage stopped because of the deadline, it is marked as reached, which the Algorithm_runner reports as
+     * a timeout.
+     */
+    class Deadline {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        Deadline() = default;
+
+        /**
+         * Creates a deadline the given amount of seconds from now.
+         *
+         * @param seconds The time limit in seconds, a non-positive limit means no deadline
+         */
+        explicit Deadline(double seconds) {
+            if (seconds > 0) {
+                end = clock::now() + std::chrono::duration_cast<clock::duration>(
+                        std::chrono::duration<double>(seconds));
+            }
+        }
+
+        /**
+         * Checks whether the deadline passed. If so, the deadline is marked as reached, so callers are expected to
+         * stop once this returns true.
+         *
+         * @return Whether the deadline passed
+         */
+        [[nodiscard]] bool expired() const {
+            if (hit) {
+                return true;
+            }
+            hit = end.has_value() && clock::now() >= *end;
+            return hit;
+        }
+
+        /**
+         * Marks the deadline as reached, for stages which stopped on a time limit of their own, e.g. a solver.
+         */
+        void report() const { hit = true; }
+
+        /**
+         * @return Whether a stage stopped because of the deadline
+         */
+        [[nodiscard]] bool reached() const { return hit; }
+
+        [[nodiscard]] bool is_set() const { return end.has_value(); }
+
+        /**
+         * @return The seconds left until the deadline, zero once it passed, must only be called if a deadline is set
+         */
+        [[nodiscard]] double remaining_seconds() const {
+            const std::chrono::duration<double> remaining{*end - clock::now()};
+            return std::max(0.0, remaining.count());
+        }
+
+    private:
+        std::optional<clock::time_point> end{};
+        mutable bool hit{false};
+    };
+}
+
+#endif //DEADLINE_H
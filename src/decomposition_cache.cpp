@@ -0,0 +1,339 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "decomposition_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "logging.h"
+#include "util.h"
+
+namespace cover {
+    namespace {
+        constexpr char MAGIC[8] = {'W', 'R', 'C', 'B', 'R', 'G', '\0', '\0'};
+        constexpr uint32_t VERSION{1};
+        constexpr uint64_t STORED_NO_NEIGHBOR{std::numeric_limits<uint64_t>::max()};
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t num_type_size;
+            uint64_t ring_count;
+            uint64_t vertex_count;
+            uint64_t node_count;
+            uint64_t x_count;
+            uint64_t y_count;
+            uint64_t base_rectangle_count;
+        };
+
+        struct Stored_node {
+            NumType min_x;
+            NumType min_y;
+            NumType max_x;
+            NumType max_y;
+            uint64_t left;
+            uint64_t right;
+            uint64_t top;
+            uint64_t bottom;
+        };
+
+        /**
+         * Sequential reader over a memory-mapped file, copying flat arrays out of it.
+         */
+        class Reader {
+        public:
+            Reader(const char *data, size_t size) : data(data), size(size) {}
+
+            template<class T>
+            bool read(T *out, size_t count) {
+                if (count > (size - offset) / sizeof(T)) {
+                    return false;
+                }
+                std::memcpy(out, data + offset, count * sizeof(T));
+                offset += count * sizeof(T);
+                return true;
+            }
+
+            template<class T>
+            bool read(std::vector<T> &out, size_t count) {
+                if (count > (size - offset) / sizeof(T)) {
+                    return false;
+                }
+                out.resize(count);
+                return read(out.data(), count);
+            }
+
+        private:
+            const char *data;
+            const size_t size;
+            size_t offset{0};
+        };
+
+        template<class T>
+        void write(std::ostream &out, const T *data, size_t count) {
+            out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        std::vector<const Polygon *> rings_of(const Polygon_with_holes &polygon) {
+            std::vector<const Polygon *> rings{&polygon.outer_boundary()};
+            for (const auto &hole: polygon.holes()) {
+                rings.push_back(&hole);
+            }
+            return rings;
+        }
+
+        void ring_data(const Polygon_with_holes &polygon, std::vector<uint64_t> &ring_sizes,
+                       std::vector<NumType> &vertices) {
+            for (const auto *ring: rings_of(polygon)) {
+                ring_sizes.push_back(ring->size());
+                for (auto it = ring->vertices_begin(); it != ring->vertices_end(); ++it) {
+                    vertices.push_back(it->x());
+                    vertices.push_back(it->y());
+                }
+            }
+        }
+
+        uint64_t to_stored(BaseRectNode::PtrType link) {
+            return link == BaseRectNode::NO_NEIGHBOR ? STORED_NO_NEIGHBOR : link;
+        }
+
+        bool from_stored(uint64_t link, uint64_t node_count, BaseRectNode::PtrType &out) {
+            if (link == STORED_NO_NEIGHBOR) {
+                out = BaseRectNode::NO_NEIGHBOR;
+                return true;
+            }
+            out = static_cast<BaseRectNode::PtrType>(link);
+            return link < node_count;
+        }
+    }
+
+    Decomposition_cache::Decomposition_cache(fs::path cache_directory) : directory(std::move(cache_directory)) {
+        if (!fs::exists(directory)) {
+            fs::create_directories(directory);
+        }
+    }
+
+    uint64_t Decomposition_cache::hash(const Polygon_with_holes &polygon, Decomposition_engine engine) {
+        // 64 bit FNV-1a
+        uint64_t hash{0xcbf29ce484222325ULL};
+        const auto add = [&hash](const void *data, size_t size) {
+            const auto *bytes{static_cast<const unsigned char *>(data)};
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3ULL;
+            }
+        };
+
+        const auto engine_id{static_cast<uint32_t>(engine)};
+        add(&engine_id, sizeof(engine_id));
+        std::vector<uint64_t> ring_sizes{};
+        std::vector<NumType> vertices{};
+        ring_data(polygon, ring_sizes, vertices);
+        add(ring_sizes.data(), ring_sizes.size() * sizeof(uint64_t));
+        add(vertices.data(), vertices.size() * sizeof(NumType));
+        return hash;
+    }
+
+    fs::path Decomposition_cache::path_of(const Polygon_with_holes &polygon, Decomposition_engine engine) const {
+        std::stringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << hash(polygon, engine) << ".brg";
+        return directory / name.str();
+    }
+
+    bool Decomposition_cache::load(const Polygon_with_holes &polygon, Decomposition_engine engine,
+                                   Runtime_environment &env) const {
+        namespace bip = boost::interprocess;
+
+        const auto path{path_of(polygon, engine)};
+        if (!fs::exists(path)) {
+            LOG(debug) << "No cached decomposition at " << path.string();
+            return false;
+        }
+
+        try {
+            const bip::file_mapping mapping{path.c_str(), bip::read_only};
+            const bip::mapped_region region{mapping, bip::read_only};
+            Reader reader{static_cast<const char *>(region.get_address()), region.get_size()};
+
+            Header header{};
+            if (!reader.read(&header, 1) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+                || header.version != VERSION || header.num_type_size != sizeof(NumType)) {
+                LOG(warning) << "Ignoring cache file " << path.string() << " with unknown format";
+                return false;
+            }
+
+            std::vector<uint64_t> ring_sizes{};
+            std::vector<NumType> vertices{};
+            ring_data(polygon, ring_sizes, vertices);
+            std::vector<uint64_t> stored_ring_sizes{};
+            std::vector<NumType> stored_vertices{};
+            if (header.ring_count != ring_sizes.size() || header.vertex_count * 2 != vertices.size()
+                || !reader.read(stored_ring_sizes, header.ring_count)
+                || !reader.read(stored_vertices, header.vertex_count * 2)
+                || stored_ring_sizes != ring_sizes || stored_vertices != vertices) {
+                LOG(warning) << "Cache file " << path.string() << " belongs to a different polygon";
+                return false;
+            }
+
+            std::vector<Stored_node> stored_nodes{};
+            std::vector<CompactRectangle> compact_nodes{};
+            std::vector<NumType> x_coordinates{};
+            std::vector<NumType> y_coordinates{};
+            std::vector<uint64_t> order{};
+            if (!reader.read(stored_nodes, header.node_count)
+                || !reader.read(compact_nodes, header.node_count)
+                || !reader.read(x_coordinates, header.x_count)
+                || !reader.read(y_coordinates, header.y_count)
+                || !reader.read(order, header.base_rectangle_count)) {
+                LOG(warning) << "Ignoring truncated cache file " << path.string();
+                return false;
+            }
+
+            // the graph indexes its coordinate arrays with the ranks of the compact nodes
+            const auto valid_ranks{[&header](const CompactRectangle &compact) {
+                return compact.min_x < compact.max_x && compact.max_x < header.x_count
+                       && compact.min_y < compact.max_y && compact.max_y < header.y_count;
+            }};
+            if (!std::all_of(compact_nodes.begin(), compact_nodes.end(), valid_ranks)) {
+                LOG(warning) << "Ignoring corrupt cache file " << path.string();
+                return false;
+            }
+
+            std::vector<BaseRectNode> nodes{};
+            nodes.reserve(stored_nodes.size());
+            for (const auto &stored: stored_nodes) {
+                nodes.emplace_back(Rectangle{stored.min_x, stored.min_y, stored.max_x, stored.max_y});
+                auto &node{nodes.back()};
+                if (!from_stored(stored.left, header.node_count, node.left)
+                    || !from_stored(stored.right, header.node_count, node.right)
+                    || !from_stored(stored.top, header.node_count, node.top)
+                    || !from_stored(stored.bottom, header.node_count, node.bottom)) {
+                    LOG(warning) << "Ignoring corrupt cache file " << path.string();
+                    return false;
+                }
+            }
+
+            std::vector<Rectangle> base_rectangles{};
+            base_rectangles.reserve(order.size());
+            for (const auto node: order) {
+                if (node >= nodes.size()) {
+                    LOG(warning) << "Ignoring corrupt cache file " << path.string();
+                    return false;
+                }
+                base_rectangles.push_back(nodes[node].base_rectangle);
+            }
+
+            env.base_rectangles = std::move(base_rectangles);
+            env.graph.restore(std::move(nodes), std::move(compact_nodes),
+                              std::move(x_coordinates), std::move(y_coordinates));
+        } catch (const bip::interprocess_exception &e) {
+            LOG(warning) << "Could not map cache file " << path.string() << ": " << e.what();
+            return false;
+        }
+
+        LOG(info) << "Loaded decomposition with " << env.base_rectangles.size() << " base rectangle(s) from "
+                  << path.string();
+        return true;
+    }
+
+    void Decomposition_cache::store(const Polygon_with_holes &polygon, Decomposition_engine engine,
+                                    const Runtime_environment &env) const {
+        assert(!env.base_rectangles.empty() && !env.graph.empty());
+
+        const auto &graph{env.graph};
+        const auto &nodes{graph.getNodes()};
+
+        std::vector<uint64_t> order{};
+        order.reserve(env.base_rectangles.size());
+        for (const auto &rectangle: env.base_rectangles) {
+            const auto node{graph.find_top_right(rectangle.get_top_right())};
+            if (node == BaseRectNode::NO_NEIGHBOR || !(nodes[node].base_rectangle == rectangle)) {
+                LOG(warning) << "Base rectangles do not match the graph, not caching decomposition";
+                return;
+            }
+            order.push_back(node);
+        }
+
+        std::vector<Stored_node> stored_nodes{};
+        stored_nodes.reserve(nodes.size());
+        for (const auto &node: nodes) {
+            const auto &rectangle{node.base_rectangle};
+            stored_nodes.push_back({rectangle.get_min_x(), rectangle.get_min_y(),
+                                    rectangle.get_max_x(), rectangle.get_max_y(),
+                                    to_stored(node.left), to_stored(node.right),
+                                    to_stored(node.top), to_stored(node.bottom)});
+        }
+
+        std::vector<uint64_t> ring_sizes{};
+        std::vector<NumType> vertices{};
+        ring_data(polygon, ring_sizes, vertices);
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.num_type_size = sizeof(NumType);
+        header.ring_count = ring_sizes.size();
+        header.vertex_count = vertices.size() / 2;
+        header.node_count = nodes.size();
+        header.x_count = graph.getXCoordinates().size();
+        header.y_count = graph.getYCoordinates().size();
+        header.base_rectangle_count = order.size();
+
+        const auto path{path_of(polygon, engine)};
+        auto temporary_path{path};
+        temporary_path += ".tmp" + std::to_string(std::random_device{}());
+        try {
+            {
+                std::ofstream out{temporary_path.string(), std::ios_base::binary | std::ios_base::trunc};
+                write(out, &header, 1);
+                write(out, ring_sizes.data(), ring_sizes.size());
+                write(out, vertices.data(), vertices.size());
+                write(out, stored_nodes.data(), stored_nodes.size());
+                write(out, graph.getCompactNodes().data(), graph.getCompactNodes().size());
+                write(out, graph.getXCoordinates().data(), graph.getXCoordinates().size());
+                write(out, graph.getYCoordinates().data(), graph.getYCoordinates().size());
+                write(out, order.data(), order.size());
+                if (!out) {
+                    throw std::runtime_error("writing failed");
+                }
+            }
+            fs::rename(temporary_path, path);
+            LOG(info) << "Stored decomposition with " << order.size() << " base rectangle(s) at " << path.string();
+        } catch (const std::exception &e) {
+            LOG(warning) << "Could not store decomposition at " << path.string() << ": " << e.what();
+            std::error_code error{};
+            fs::remove(temporary_path, error);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DECOMPOSITION_CACHE_H
+#define DECOMPOSITION_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <experimental/filesystem>
+
+#include "CGAL_classes.h"
+#include "runtime_environment.h"
+
+namespace fs = std::experimental::filesystem;
+
+namespace cover {
+    /**
+     * @brief Persistent cache of the decomposition of polygons into base rectangles
+     *
+     * The base rectangles of a polygon and its BaseRectGraph don't depend on the costs or the algorithm, so they are
+     * stored in a directory, one file per polygon, named after a content hash of the polygon. A file contains the
+     * polygon itself, to rule out hash collisions, followed by the graph's nodes with their neighbor links, the
+     * compressed coordinates and the order of the base rectangles, as flat arrays. Files are memory-mapped when read
+     * and only the corner maps of the graph have to be recomputed.
+     *
+     * Files are written to a temporary file first and then renamed, so multiple processes or threads can share a
+     * cache directory.
+     */
+    class Decomposition_cache {
+    public:
+        /**
+         * @param directory The directory containing the cache files, it is created if it does not exist
+         */
+        explicit Decomposition_cache(fs::path directory);
+
+        /**
+         * Fills the base rectangles and the graph of the environment from the cache.
+         *
+         * @param polygon The polygon to look up
+         * @param engine The engine the cached decomposition has to be computed with
+         * @param env The environment to fill
+         * @return Whether the polygon was found in the cache, env is left untouched otherwise
+         */
+        bool load(const Polygon_with_holes &polygon, Decomposition_engine engine, Runtime_environment &env) const;
+
+        /**
+         * Stores the base rectangles and the graph of the environment in the cache.
+         *
+         * @param polygon The polygon the environment belongs to
+         * @param engine The engine the decomposition was computed with
+         * @param env The environment, its base rectangles and graph have to be computed already
+         */
+        void store(const Polygon_with_holes &polygon, Decomposition_engine engine,
+                   const Runtime_environment &env) const;
+
+        /**
+         * Returns a hash of the polygon's vertices and the decomposition engine, which is used as the file name of the
+         * polygon's cache entry.
+         *
+         * @param polygon The polygon to hash
+         * @param engine The engine the decomposition is computed with
+         * @return The hash of the polygon
+         */
+        static uint64_t hash(const Polygon_with_holes &polygon, Decomposition_engine engine);
+
+    private:
+        [[nodiscard]] fs::path path_of(const Polygon_with_holes &polygon, Decomposition_engine engine) const;
+
+        const fs::path directory;
+    };
+}
+
+#endif //DECOMPOSITION_CACHE_H
@@ -24,7 +24,13 @@
  */
 
 #include "greedy_set_cover_algorithm.h"
+#include "area_index.h"
+#include "candidate_filter.h"
 #include "datastructures.h"
+#include "profile.h"
+#include <algorithm>
+#include <limits>
+#include <optional>
 #include <sstream>
 
 namespace cover {
@@ -32,171 +38,736 @@ namespace cover {
     /**
      * A struct which maintains information about a rectangle in the queue of the algorithm.
      *
-     * Maintains the rectangle itself, its area, the area it covers which is not yet covered by any other rectangle,
-     * its cost and its cost per unit which it uniquely covers.
+     * Maintains the graph nodes in the top right and bottom left corner of the rectangle, the area it covers which is
+     * not yet covered by any other rectangle, its cost and its cost per unit which it uniquely covers. The rectangle
+     * itself is only materialized from the graph once it is picked.
      */
     struct Greedy_set_cover_algorithm::QueueEntry {
-        Rectangle rectangle;
-        size_t area;
+        using NodeIndex = uint32_t;
+
+        NodeIndex top_right;
+        NodeIndex bottom_left;
         size_t effective_area;
-        size_t cost;
+        CostType cost;
         double cost_per_unit;
 
-        explicit QueueEntry(const Rectangle &rectangle, const Problem_instance::Costs &costs)
-            : rectangle(rectangle), area(rectangle.area()), effective_area(area),
-              cost(Problem_instance::calculate_total_cost_of_rectangle(rectangle, costs)),
-              cost_per_unit(static_cast<double>(cost) / static_cast<double>(effective_area)) {}
+        QueueEntry(const BaseRectGraph &graph, BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left,
+                   const Problem_instance::Costs &costs)
+            : top_right(static_cast<NodeIndex>(top_right)), bottom_left(static_cast<NodeIndex>(bottom_left)) {
+          const auto rectangle{graph.get_rectangle(top_right, bottom_left)};
+          effective_area = rectangle.area();
+          cost = Problem_instance::calculate_total_cost_of_rectangle(rectangle, costs);
+          cost_per_unit = static_cast<double>(cost) / static_cast<double>(effective_area);
+        }
 
-        bool 
-        update(const Rectangle &picked_rectangle,
-               const std::vector<Rectangle> &newly_covered_base_rectangles) {
-          LOG(trace) << "Updating " << this->print().rdbuf() <<  " for picked rectangle " << picked_rectangle;
+        void set_effective_area(size_t new_effective_area) {
+          assert(new_effective_area > 0 && new_effective_area <= effective_area);
+          effective_area = new_effective_area;
+          cost_per_unit = static_cast<double>(cost) / static_cast<double>(effective_area);
+        }
 
-          if (!picked_rectangle.intersects(rectangle)) {
-            LOG(trace) << "  Picked rectangle does not intersect, "
-                          "skipping";
-            // picked rectangle covers none of our area
-            return false;
-          }
+        std::stringstream print() const {
+          std::stringstream ss;
+          ss << "QE: nodes " << top_right << " / " << bottom_left << ", cost per unit: " << cost_per_unit
+             << ", effective area: " << effective_area;
+          return ss;
+        }
+    };
 
-          if (picked_rectangle.fully_contains(rectangle)) {
-            LOG(trace) << "Picked rectangle fully contains this entry, making it completely "
-                          "redundant, setting"
-                          " effective area to 0 and returning from update...";
-            // picked rectangle covers us completely
-            effective_area = 0;
-            return true;
-          }
+    namespace {
+        using EntryIndex = uint32_t;
+
+        /**
+         * A binary heap of queue entry indices which keeps track of the position of each index, allowing entries to
+         * be removed and moved down after their key got worse. The comparator is a template parameter, so the
+         * comparisons in the sift loops can be inlined.
+         */
+        template<class Worse>
+        class Entry_heap {
+        public:
+            Entry_heap(size_t entry_count, Worse worse,
+                       std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+                : heap(resource), positions(entry_count, NOT_CONTAINED, resource), worse(std::move(worse)) {
+              heap.reserve(entry_count);
+            }
+
+            [[nodiscard]] bool empty() const { return heap.empty(); }
+
+            [[nodiscard]] size_t size() const { return heap.size(); }
+
+            [[nodiscard]] EntryIndex top() const { return heap.front(); }
+
+            [[nodiscard]] bool contains(EntryIndex entry) const { return positions[entry] != NOT_CONTAINED; }
+
+            void push(EntryIndex entry) {
+              positions[entry] = heap.size();
+              heap.push_back(entry);
+              sift_up(heap.size() - 1);
+            }
+
+            EntryIndex pop() {
+              const auto top{heap.front()};
+              remove(top);
+              return top;
+            }
+
+            void remove(EntryIndex entry) {
+              const auto position{positions[entry]};
+              positions[entry] = NOT_CONTAINED;
+              if (position == heap.size() - 1) {
+                heap.pop_back();
+                return;
+              }
+              heap[position] = heap.back();
+              positions[heap[position]] = position;
+              heap.pop_back();
+              sift_down(sift_up(position));
+            }
+
+            void worsened(EntryIndex entry) { sift_down(positions[entry]); }
+
+            [[nodiscard]] size_t memory_usage() const {
+              return heap.capacity() * sizeof(EntryIndex) + positions.capacity() * sizeof(size_t);
+            }
 
-          LOG(trace) << "Picked rectangle partially intersects this entry, checking base "
-                        "rectangle intersections...";
-          for (const auto &base_rectangle : newly_covered_base_rectangles) {
-            LOG(trace) << "Checking intersection with "
-                       << base_rectangle;
-            if (rectangle.fully_contains(base_rectangle)) {
-              LOG(trace) << "Entry rectangle fully contains base rectangle: "
-                         << base_rectangle
-                         << ", reducing effective area of entry rectangle ("
-                         << effective_area
-                         << ") by area of base rectangle ("
-                         << base_rectangle.area() << ")...";
-              assert(effective_area >= base_rectangle.area());
-              effective_area -= base_rectangle.area();
+            /**
+             * Replaces the content of the heap by the given entries in linear time.
+             *
+             * @param entries The entries to put into the heap
+             */
+            void assign(Arena_vector<EntryIndex> entries) {
+              for (const auto entry : heap) {
+                positions[entry] = NOT_CONTAINED;
+              }
+              heap = std::move(entries);
+              for (size_t position = 0; position < heap.size(); position++) {
+                positions[heap[position]] = position;
+              }
+              for (auto position = heap.size() / 2; position > 0; position--) {
+                sift_down(position - 1);
+              }
             }
+
+        private:
+            constexpr static size_t NOT_CONTAINED = std::numeric_limits<size_t>::max();
+
+            Arena_vector<EntryIndex> heap;
+            Arena_vector<size_t> positions;
+            Worse worse;
+
+            void place(size_t position, EntryIndex entry) {
+              heap[position] = entry;
+              positions[entry] = position;
+            }
+
+            size_t sift_up(size_t position) {
+              const auto entry{heap[position]};
+              while (position > 0) {
+                const auto parent{(position - 1) / 2};
+                if (!worse(heap[parent], entry)) {
+                  break;
+                }
+                place(position, heap[parent]);
+                position = parent;
+              }
+              place(position, entry);
+              return position;
+            }
+
+            void sift_down(size_t position) {
+              const auto entry{heap[position]};
+              while (true) {
+                auto child{2 * position + 1};
+                if (child >= heap.size()) {
+                  break;
+                }
+                if (child + 1 < heap.size() && worse(heap[child], heap[child + 1])) {
+                  ++child;
+                }
+                if (!worse(entry, heap[child])) {
+                  break;
+                }
+                place(position, heap[child]);
+                position = child;
+              }
+              place(position, entry);
+            }
+        };
+
+        /**
+         * Returns whether the entry lhs is picked after the entry rhs: lower cost per unit first, ties are broken by
+         * the larger effective area and then by the smaller index, which makes the order total.
+         */
+        template<class Entries>
+        bool is_worse(const Entries &entries, EntryIndex lhs, EntryIndex rhs) {
+          const auto &first{entries[lhs]};
+          const auto &second{entries[rhs]};
+          return first.cost_per_unit > second.cost_per_unit
+                 || first.cost_per_unit == second.cost_per_unit
+                    && (first.effective_area < second.effective_area
+                        || first.effective_area == second.effective_area && lhs > rhs);
+        }
+    }
+
+    size_t Greedy_set_cover_algorithm::find_largest_entry(const Arena_vector<QueueEntry> &entries) {
+      assert(!entries.empty());
+
+      // the maximum of each block is computed without branches, only blocks improving on the best area so far are
+      // searched for the position of their maximum, which keeps the first of several largest entries
+      constexpr size_t BLOCK_SIZE{8};
+      size_t best{0};
+      size_t best_area{entries.front().effective_area};
+      size_t block_begin{0};
+      for (; block_begin + BLOCK_SIZE <= entries.size(); block_begin += BLOCK_SIZE) {
+        size_t block_area{0};
+        for (size_t i = 0; i < BLOCK_SIZE; i++) {
+          block_area = std::max(block_area, entries[block_begin + i].effective_area);
+        }
+        if (block_area > best_area) {
+          best = block_begin;
+          while (entries[best].effective_area != block_area) {
+            ++best;
           }
+          best_area = block_area;
+        }
+      }
+      for (auto i = block_begin; i < entries.size(); i++) {
+        if (entries[i].effective_area > best_area) {
+          best = i;
+          best_area = entries[i].effective_area;
+        }
+      }
+      return best;
+    }
+
+    template<typename Visitor>
+    void Greedy_set_cover_algorithm::for_each_candidate(const Problem_instance::Costs &costs,
+                                                        const BaseRectGraph &graph, Visitor &&visitor) const {
+      const Candidate_filter filter{costs};
+      if (candidate_limit == 0 || filter.get_rule() == Candidate_filter::Rule::SINGLE) {
+        filter.for_each_candidate(graph, visitor);
+        return;
+      }
+
+      // the filter's maximal rectangles are all among the widest rectangles of each height, so the bound only adds
+      // the best of the others when the filter would keep more than them
+      const auto extra_limit{filter.get_rule() == Candidate_filter::Rule::MAXIMAL ? 0 : candidate_limit};
+      const auto &nodes{graph.getNodes()};
+      const auto heights{graph.get_node_heights()};
 
-          if (effective_area == 0) {
-            LOG(trace) << "Entry rectangle has no effective area left, "
-                          "returning from update...";
-            return true;
+      struct Corner {
+        BaseRectNode::PtrType bottom_left;
+        double cost_per_unit;
+      };
+      std::vector<Corner> others{};
+      size_t kept{0};
+      for (BaseRectNode::PtrType top_right = 0; top_right < nodes.size(); top_right++) {
+        others.clear();
+        bool base_rectangle_kept{false};
+
+        // walking left, the height of the tallest rectangle only shrinks, the widest rectangle of a height ends
+        // right before the height drops below it or the row ends
+        auto max_height{heights[top_right]};
+        for (auto left{top_right}; left != BaseRectNode::NO_NEIGHBOR; left = nodes[left].left) {
+          max_height = std::min(max_height, heights[left]);
+          const auto next{nodes[left].left};
+          if (next != BaseRectNode::NO_NEIGHBOR && heights[next] >= max_height) {
+            continue;
           }
 
-          cost_per_unit = static_cast<double>(cost) /
-                                static_cast<double>(effective_area);
-          LOG(trace) << "  Updated: " << this->print().rdbuf();
-          return true;
+          auto bottom_left{left};
+          for (size_t h = 0; h < max_height; h++) {
+            bottom_left = nodes[bottom_left].bottom;
+          }
+          if (Candidate_filter::is_maximal(graph, top_right, bottom_left)) {
+            base_rectangle_kept |= bottom_left == top_right;
+            visitor(top_right, bottom_left);
+            ++kept;
+          } else if (extra_limit > 0) {
+            const auto rectangle{graph.get_rectangle(top_right, bottom_left)};
+            others.push_back({bottom_left,
+                              static_cast<double>(Problem_instance::calculate_total_cost_of_rectangle(rectangle, costs))
+                              / static_cast<double>(rectangle.area())});
+          }
         }
 
-        std::stringstream print() const {
-          std::stringstream ss;
-          ss << "QE: " << rectangle << ", cost per unit: " << cost_per_unit
-             << ", area: " << area << ", effective area: " << effective_area;
-          return ss;
+        // stable, so ties keep the order of the walk and the candidates do not depend on the sort implementation
+        std::stable_sort(others.begin(), others.end(), [](const Corner &lhs, const Corner &rhs) {
+          return lhs.cost_per_unit < rhs.cost_per_unit;
+        });
+        others.resize(std::min(others.size(), extra_limit));
+        for (const auto &corner : others) {
+          base_rectangle_kept |= corner.bottom_left == top_right;
+          visitor(top_right, corner.bottom_left);
         }
-    };
+        kept += others.size();
+
+        // the single base rectangles guarantee that every base rectangle can still be covered on its own
+        if (!base_rectangle_kept) {
+          visitor(top_right, top_right);
+          ++kept;
+        }
+      }
+      LOG(debug) << "Kept " << kept << " bounded candidate(s) for " << nodes.size() << " base rectangle(s)";
+      PROFILE_COUNT("bounded_candidates", kept);
+    }
+
+    size_t Greedy_set_cover_algorithm::expected_candidates(const Problem_instance::Costs &costs,
+                                                           const BaseRectGraph &graph) const {
+      const auto node_count{graph.getNodes().size()};
+      if (Candidate_filter{costs}.get_rule() != Candidate_filter::Rule::NONE) {
+        return node_count;
+      }
+      return candidate_limit > 0 ? node_count * (candidate_limit + 2) : graph.count_all_rectangles();
+    }
+
+    void Greedy_set_cover_algorithm::add_uncovered_base_rectangles(std::vector<Rectangle> &cover,
+                                                                   const Arena_vector<bool> &covered,
+                                                                   const std::vector<BaseRectNode> &nodes) {
+      size_t added{0};
+      for (BaseRectNode::PtrType node = 0; node < nodes.size(); node++) {
+        if (!covered[node]) {
+          cover.push_back(nodes[node].base_rectangle);
+          ++added;
+        }
+      }
+      PROFILE_COUNT("deadline_fill", added);
+    }
 
     std::vector<Rectangle> Greedy_set_cover_algorithm::calculate_cover(
         const Polygon_with_holes &polygon, const Problem_instance::Costs &costs,
         Runtime_environment *env) {
-      using RectangleQueue = std::vector<QueueEntry>;
-      LOG(info) << "Running Eager Greedy Set Cover algorithm (using base rectangle graph)";
+      LOG(debug) << "Getting base rectangles of polygon";
+      env->ensure_decomposition(polygon);
 
-      std::vector<Rectangle> cover{};
+      if (lazy) {
+        return calculate_lazy_cover(costs, env);
+      }
+      if (threads > 1) {
+        return calculate_parallel_eager_cover(costs, env);
+      }
+      return calculate_eager_cover(costs, env);
+    }
 
-      LOG(debug) << "Getting base rectangles of polygon";
-      if (env->base_rectangles.empty()) {
-        env->base_rectangles =
-            Rectangle_enumerator::get_base_rectangles(polygon);
+    size_t Greedy_set_cover_algorithm::estimate_memory(const BaseRectGraph &graph) const {
+      const auto node_count{graph.getNodes().size()};
+      auto [candidates, incidences]{graph.count_all_candidates()};
+      if (candidate_limit > 0 && candidates > 0) {
+        const auto bounded_candidates{std::min(candidates, node_count * (candidate_limit + 2))};
+        incidences = static_cast<size_t>(static_cast<double>(incidences) / static_cast<double>(candidates)
+                                         * static_cast<double>(bounded_candidates));
+        candidates = bounded_candidates;
       }
-      if (env->graph.empty()) {
-        env->graph.build(env->base_rectangles);
+
+      // the entries, the heap with its positions and whether each base rectangle is covered
+      size_t bytes{candidates * (sizeof(QueueEntry) + sizeof(EntryIndex) + sizeof(size_t)) + node_count};
+      if (lazy) {
+        bytes += Area_index::estimate_memory(graph);
+      } else {
+        // every chunk of the parallel engine has its own offsets and insert positions over all base rectangles
+        const auto chunks{threads > 1 ? std::max<size_t>(1, std::min(threads, candidates)) : 1};
+        bytes += incidences * sizeof(EntryIndex) + chunks * 2 * (node_count + 1) * sizeof(size_t);
       }
+      return bytes;
+    }
+
+    std::vector<Rectangle> Greedy_set_cover_algorithm::calculate_eager_cover(
+        const Problem_instance::Costs &costs, Runtime_environment *env) {
+      LOG(info) << "Running Eager Greedy Set Cover algorithm (using base rectangle graph)";
+
+      std::vector<Rectangle> cover{};
       const auto &nodes{env->graph.getNodes()};
 
-      auto all_rectangles {env->graph.get_all_rectangles()};
-      RectangleQueue rectangle_queue;
-      for (const auto &rectangle : all_rectangles) {
-        QueueEntry entry{rectangle, costs};
-        rectangle_queue.push_back(entry);
+      Arena_vector<QueueEntry> rectangle_queue{&env->arena};
+      {
+        PROFILE_SCOPE("candidate_enumeration");
+        rectangle_queue.reserve(expected_candidates(costs, env->graph));
+        for_each_candidate(costs, env->graph, [&](BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left) {
+          rectangle_queue.emplace_back(env->graph, top_right, bottom_left, costs);
+        });
       }
+      PROFILE_COUNT("candidates", rectangle_queue.size());
+      assert(rectangle_queue.size() < std::numeric_limits<EntryIndex>::max());
+      assert(nodes.size() < std::numeric_limits<QueueEntry::NodeIndex>::max());
 
-      auto current_best_entry{
-          std::max_element(rectangle_queue.begin(), rectangle_queue.end(),
-                           [](const QueueEntry &lhs, const QueueEntry &rhs) {
-                             return lhs.area < rhs.area;
-                           })};
+      LOG(debug) << "Building inverted index from base rectangles to the "
+                 << rectangle_queue.size() << " queue entries containing them";
+      Arena_vector<size_t> index_offsets(nodes.size() + 1, 0, &env->arena);
+      Arena_vector<EntryIndex> containing_entries{&env->arena};
+      {
+        PROFILE_SCOPE("inverted_index");
+        for (const auto &entry : rectangle_queue) {
+          for (auto it = env->graph.begin(entry.top_right, entry.bottom_left);
+               it != env->graph.end(); ++it) {
+            ++index_offsets[*it + 1];
+          }
+        }
+        for (size_t i = 1; i < index_offsets.size(); i++) {
+          index_offsets[i] += index_offsets[i - 1];
+        }
+        containing_entries.resize(index_offsets.back());
+        Arena_vector<size_t> insert_positions{index_offsets, &env->arena};
+        for (EntryIndex i = 0; i < rectangle_queue.size(); i++) {
+          const auto &entry{rectangle_queue[i]};
+          for (auto it = env->graph.begin(entry.top_right, entry.bottom_left);
+               it != env->graph.end(); ++it) {
+            containing_entries[insert_positions[*it]++] = i;
+          }
+        }
+      }
 
-      Set<Rectangle> covered_base_rectangles;
-      while (true) {
-        LOG(debug) << rectangle_queue.size() << " rectangle(s) left in queue";
+      Entry_heap queue{rectangle_queue.size(), [&rectangle_queue](EntryIndex lhs, EntryIndex rhs) {
+        return is_worse(rectangle_queue, lhs, rhs);
+      }, &env->arena};
 
-        const auto best_rectangle{current_best_entry->rectangle};
+      const auto first_entry{find_largest_entry(rectangle_queue)};
+      {
+        // the order is total, so building the heap at once instead of pushing one by one yields the same picks
+        Arena_vector<EntryIndex> initial_entries{&env->arena};
+        initial_entries.reserve(rectangle_queue.size() - 1);
+        for (EntryIndex i = 0; i < rectangle_queue.size(); i++) {
+          if (i != first_entry) {
+            initial_entries.push_back(i);
+          }
+        }
+        queue.assign(std::move(initial_entries));
+      }
 
-        LOG(trace) << "Adding rectangle to cover: "
-                   << current_best_entry->print().rdbuf();
+      PROFILE_SCOPE("greedy_loop");
+      Arena_vector<bool> covered(nodes.size(), false, &env->arena);
+      size_t covered_count{0};
+      auto best_entry{static_cast<EntryIndex>(first_entry)};
+      while (true) {
+        LOG(debug) << queue.size() << " rectangle(s) left in queue";
+        const auto &best{rectangle_queue[best_entry]};
+        LOG(trace) << "Adding rectangle to cover: " << best.print().rdbuf();
+        cover.push_back(env->graph.get_rectangle(best.top_right, best.bottom_left));
 
-        std::vector<Rectangle> base_of_best;
-        for (auto it = env->graph.begin(best_rectangle.get_top_right(),
-                                        best_rectangle.get_bottom_left());
+        for (auto it = env->graph.begin(best.top_right, best.bottom_left);
              it != env->graph.end(); ++it) {
-          if (covered_base_rectangles.find(nodes[*it].base_rectangle) ==
-              covered_base_rectangles.cend()) {
-            covered_base_rectangles.insert(nodes[*it].base_rectangle);
-            base_of_best.push_back(nodes[*it].base_rectangle);
+          if (covered[*it]) {
+            continue;
+          }
+          covered[*it] = true;
+          ++covered_count;
+
+          // only the entries containing a newly covered base rectangle lose effective area
+          const auto base_area{nodes[*it].base_rectangle.area()};
+          for (auto offset = index_offsets[*it]; offset < index_offsets[*it + 1]; offset++) {
+            const auto entry_index{containing_entries[offset]};
+            auto &entry{rectangle_queue[entry_index]};
+            assert(entry.effective_area >= base_area);
+            entry.effective_area -= base_area;
+            if (!queue.contains(entry_index)) {
+              continue;
+            }
+            if (entry.effective_area == 0) {
+              LOG(trace) << "Entry has no effective area left, pruning it";
+              queue.remove(entry_index);
+            } else {
+              entry.cost_per_unit = static_cast<double>(entry.cost) / static_cast<double>(entry.effective_area);
+              queue.worsened(entry_index);
+            }
           }
         }
-        LOG(trace) << "Base of added rectangle has size "
-                   << base_of_best.size();
-        assert(!base_of_best.empty());
 
-        cover.push_back(best_rectangle);
-        std::swap(*current_best_entry, rectangle_queue.back());
-        rectangle_queue.pop_back();
+        LOG(debug) << covered_count << " / " << nodes.size() << " covered.";
+        if (covered_count == nodes.size()) {
+          LOG(debug) << "No uncovered base rectangles left, exiting loop";
+          break;
+        }
+
+        if (env->deadline.expired()) {
+          LOG(info) << "Deadline reached, completing the cover with the uncovered base rectangles";
+          add_uncovered_base_rectangles(cover, covered, nodes);
+          break;
+        }
+
+        assert(!queue.empty());
+        best_entry = queue.pop();
+      }
+
+      PROFILE_COUNT("picks", cover.size());
+      LOG(info) << "Greedy_set_cover_algorithm finished";
+      return cover;
+    }
+
+    std::vector<Rectangle> Greedy_set_cover_algorithm::calculate_parallel_eager_cover(
+        const Problem_instance::Costs &costs, Runtime_environment *env) {
+      LOG(info) << "Running Eager Greedy Set Cover algorithm (using base rectangle graph) on " << threads
+                << " threads";
+
+      if (pool == nullptr) {
+        pool = std::make_unique<Worker_pool>(threads);
+      }
+
+      std::vector<Rectangle> cover{};
+      const auto &graph{env->graph};
+      const auto &nodes{graph.getNodes()};
+
+      Arena_vector<QueueEntry> rectangle_queue{&env->arena};
+      {
+        PROFILE_SCOPE("candidate_enumeration");
+        rectangle_queue.reserve(expected_candidates(costs, graph));
+        for_each_candidate(costs, graph, [&](BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left) {
+          rectangle_queue.emplace_back(graph, top_right, bottom_left, costs);
+        });
+      }
+      PROFILE_COUNT("candidates", rectangle_queue.size());
+      assert(rectangle_queue.size() < std::numeric_limits<EntryIndex>::max());
+      assert(nodes.size() < std::numeric_limits<QueueEntry::NodeIndex>::max());
+
+      // entry i is entry i / chunk_count of chunk i % chunk_count, dealing the entries round-robin spreads the
+      // entries containing a base rectangle, which were enumerated next to each other, evenly over the chunks
+      const auto chunk_count{std::min<size_t>(pool->size(), rectangle_queue.size())};
+      const auto chunk_order{[&rectangle_queue, chunk_count](size_t c) {
+        return [&rectangle_queue, c, chunk_count](EntryIndex lhs, EntryIndex rhs) {
+          return is_worse(rectangle_queue, static_cast<EntryIndex>(lhs * chunk_count + c),
+                          static_cast<EntryIndex>(rhs * chunk_count + c));
+        };
+      }};
+      struct Chunk {
+        std::vector<size_t> index_offsets;
+        std::vector<EntryIndex> containing_entries;
+        Entry_heap<decltype(chunk_order(0))> queue;
+      };
+      std::vector<Chunk> chunks{};
+      chunks.reserve(chunk_count);
+      for (size_t c = 0; c < chunk_count; c++) {
+        const auto local_count{(rectangle_queue.size() - c + chunk_count - 1) / chunk_count};
+        chunks.push_back({std::vector<size_t>(nodes.size() + 1, 0), {}, Entry_heap{local_count, chunk_order(c)}});
+      }
 
-        LOG(debug) << covered_base_rectangles.size() << " / "
-                   << nodes.size() << " covered.";
+      const auto first_entry{find_largest_entry(rectangle_queue)};
+      {
+        PROFILE_SCOPE("inverted_index");
+        pool->run(chunk_count, [&](size_t c, size_t) {
+          auto &chunk{chunks[c]};
+          for (auto i = c; i < rectangle_queue.size(); i += chunk_count) {
+            const auto &entry{rectangle_queue[i]};
+            for (auto it = graph.begin(entry.top_right, entry.bottom_left); it != graph.end(); ++it) {
+              ++chunk.index_offsets[*it + 1];
+            }
+          }
+          for (size_t i = 1; i < chunk.index_offsets.size(); i++) {
+            chunk.index_offsets[i] += chunk.index_offsets[i - 1];
+          }
+          chunk.containing_entries.resize(chunk.index_offsets.back());
+          auto insert_positions{chunk.index_offsets};
+          // filled on the pool's threads, so not drawn from the arena, which is not thread safe
+          Arena_vector<EntryIndex> initial_entries{};
+          initial_entries.reserve((rectangle_queue.size() - c + chunk_count - 1) / chunk_count);
+          for (auto i = c; i < rectangle_queue.size(); i += chunk_count) {
+            const auto local{static_cast<EntryIndex>(i / chunk_count)};
+            const auto &entry{rectangle_queue[i]};
+            for (auto it = graph.begin(entry.top_right, entry.bottom_left); it != graph.end(); ++it) {
+              chunk.containing_entries[insert_positions[*it]++] = local;
+            }
+            if (i != first_entry) {
+              initial_entries.push_back(local);
+            }
+          }
+          chunk.queue.assign(std::move(initial_entries));
+        });
+      }
+      // the chunks are filled outside the arena
+      Memory_account::Charge charge{env->memory};
+      for (const auto &chunk: chunks) {
+        charge.add(chunk.index_offsets.capacity() * sizeof(size_t)
+                   + chunk.containing_entries.capacity() * sizeof(EntryIndex) + chunk.queue.memory_usage());
+      }
+
+      PROFILE_SCOPE("greedy_loop");
+      Arena_vector<bool> covered(nodes.size(), false, &env->arena);
+      std::vector<BaseRectNode::PtrType> newly_covered{};
+      size_t covered_count{0};
+      auto best_entry{static_cast<EntryIndex>(first_entry)};
+      while (true) {
+        const auto &best{rectangle_queue[best_entry]};
+        LOG(trace) << "Adding rectangle to cover: " << best.print().rdbuf();
+        cover.push_back(graph.get_rectangle(best.top_right, best.bottom_left));
 
-        if (covered_base_rectangles.size() == nodes.size()) {
+        newly_covered.clear();
+        for (auto it = graph.begin(best.top_right, best.bottom_left); it != graph.end(); ++it) {
+          if (!covered[*it]) {
+            covered[*it] = true;
+            newly_covered.push_back(*it);
+          }
+        }
+        covered_count += newly_covered.size();
+
+        LOG(debug) << covered_count << " / " << nodes.size() << " covered.";
+        if (covered_count == nodes.size()) {
           LOG(debug) << "No uncovered base rectangles left, exiting loop";
           break;
         }
 
-        LOG(trace) << "Updating remaining queue entries";
+        if (env->deadline.expired()) {
+          LOG(info) << "Deadline reached, completing the cover with the uncovered base rectangles";
+          add_uncovered_base_rectangles(cover, covered, nodes);
+          break;
+        }
 
-        double current_best_cost{std::numeric_limits<double>::infinity()};
-        for (auto entry_it{rectangle_queue.begin()}; entry_it != rectangle_queue.end();) {
-          entry_it->update(best_rectangle, base_of_best);
+        // the chunks own disjoint sets of entries, so they can update them without synchronization
+        pool->run(chunk_count, [&](size_t c, size_t) {
+          auto &chunk{chunks[c]};
+          for (const auto node : newly_covered) {
+            const auto base_area{nodes[node].base_rectangle.area()};
+            for (auto offset = chunk.index_offsets[node]; offset < chunk.index_offsets[node + 1]; offset++) {
+              const auto local{chunk.containing_entries[offset]};
+              auto &entry{rectangle_queue[local * chunk_count + c]};
+              assert(entry.effective_area >= base_area);
+              entry.effective_area -= base_area;
+              if (!chunk.queue.contains(local)) {
+                continue;
+              }
+              if (entry.effective_area == 0) {
+                chunk.queue.remove(local);
+              } else {
+                entry.cost_per_unit = static_cast<double>(entry.cost) / static_cast<double>(entry.effective_area);
+                chunk.queue.worsened(local);
+              }
+            }
+          }
+        });
 
-          if (entry_it->effective_area == 0) {
-            LOG(trace) << "Entry has no effective area left, pruning it";
-            std::swap(*entry_it, rectangle_queue.back());
-            rectangle_queue.pop_back();
-          } else {
-            LOG(trace) << "Entry has cost per unit: " << entry_it->cost_per_unit
-                       << ", current best: " << current_best_cost;
-            if (entry_it->cost_per_unit < current_best_cost //) {
-                || entry_it->cost_per_unit == current_best_cost
-                    && entry_it->effective_area > current_best_entry->effective_area) {
-              LOG(trace)
-                  << "Entry has improved cost, marking it as current best";
-              current_best_entry = entry_it;
-              current_best_cost = entry_it->cost_per_unit;
+        // the best entry of all is the best of the chunks' best entries, checked in a fixed order
+        std::optional<size_t> best_chunk{};
+        for (size_t c = 0; c < chunk_count; c++) {
+          if (chunks[c].queue.empty()) {
+            continue;
+          }
+          const auto candidate{static_cast<EntryIndex>(chunks[c].queue.top() * chunk_count + c)};
+          if (!best_chunk.has_value()
+              || is_worse(rectangle_queue, best_entry, candidate)) {
+            best_chunk = c;
+            best_entry = candidate;
+          }
+        }
+        assert(best_chunk.has_value());
+        chunks[*best_chunk].queue.pop();
+      }
+
+      PROFILE_COUNT("picks", cover.size());
+      LOG(info) << "Greedy_set_cover_algorithm finished";
+      return cover;
+    }
+
+    std::vector<Rectangle> Greedy_set_cover_algorithm::calculate_lazy_cover(
+        const Problem_instance::Costs &costs, Runtime_environment *env) {
+      LOG(info) << "Running Lazy Greedy Set Cover algorithm (using base rectangle graph)";
+
+      std::vector<Rectangle> cover{};
+      const auto &nodes{env->graph.getNodes()};
+
+      Arena_vector<QueueEntry> rectangle_queue{&env->arena};
+      {
+        PROFILE_SCOPE("candidate_enumeration");
+        rectangle_queue.reserve(expected_candidates(costs, env->graph));
+        for_each_candidate(costs, env->graph, [&](BaseRectNode::PtrType top_right, BaseRectNode::PtrType bottom_left) {
+          rectangle_queue.emplace_back(env->graph, top_right, bottom_left, costs);
+        });
+      }
+      PROFILE_COUNT("candidates", rectangle_queue.size());
+      assert(rectangle_queue.size() < std::numeric_limits<EntryIndex>::max());
+
+      // the heap holds the indices of the entries, so it uses the same order as the eager engine, including the
+      // tie-break by index, the stored cost per unit only being a lower bound then picks the same entries
+      const auto worse = [&rectangle_queue](EntryIndex lhs, EntryIndex rhs) {
+        return is_worse(rectangle_queue, lhs, rhs);
+      };
+
+      // holds the area of every uncovered base rectangle, large entries are summed up through it instead of walked
+      Area_index uncovered_index{};
+      {
+        PROFILE_SCOPE("area_index");
+        uncovered_index.build(env->graph, [&nodes](BaseRectNode::PtrType node) {
+          return nodes[node].base_rectangle.area();
+        });
+      }
+      Memory_account::Charge charge{env->memory};
+      charge.add(uncovered_index.memory_usage());
+
+      PROFILE_SCOPE("greedy_loop");
+      Arena_vector<bool> covered(nodes.size(), false, &env->arena);
+      size_t covered_count{0};
+
+      auto pick = [&](const QueueEntry &entry) {
+        LOG(trace) << "Adding rectangle to cover: " << entry.print().rdbuf();
+        for (auto it = env->graph.begin(entry.top_right, entry.bottom_left);
+             it != env->graph.end(); ++it) {
+          if (!covered[*it]) {
+            covered[*it] = true;
+            ++covered_count;
+            if (!uncovered_index.empty()) {
+              const auto base_area{static_cast<Area_index::WeightType>(nodes[*it].base_rectangle.area())};
+              uncovered_index.add(env->graph, *it, -base_area);
             }
-            ++entry_it;
           }
         }
+        cover.push_back(env->graph.get_rectangle(entry.top_right, entry.bottom_left));
+        LOG(debug) << covered_count << " / " << nodes.size() << " covered.";
+      };
+
+      auto uncovered_area = [&](const QueueEntry &entry) {
+        const auto compact{env->graph.get_compact_rectangle(entry.top_right, entry.bottom_left)};
+        if (uncovered_index.is_cheaper_than_walk(compact)) {
+          return static_cast<size_t>(uncovered_index.sum_within(compact));
+        }
+
+        size_t area{0};
+        for (auto it = env->graph.begin(entry.top_right, entry.bottom_left);
+             it != env->graph.end(); ++it) {
+          if (!covered[*it]) {
+            area += nodes[*it].base_rectangle.area();
+          }
+        }
+        return area;
+      };
+
+      // the eager engine starts with the largest rectangle, do the same here to end up with the same cover
+      const auto first_entry{find_largest_entry(rectangle_queue)};
+      pick(rectangle_queue[first_entry]);
+
+      Arena_vector<EntryIndex> heap{&env->arena};
+      heap.reserve(rectangle_queue.size() - 1);
+      for (EntryIndex i = 0; i < rectangle_queue.size(); i++) {
+        if (i != first_entry) {
+          heap.push_back(i);
+        }
+      }
+      std::make_heap(heap.begin(), heap.end(), worse);
+      size_t recomputations{0};
+      while (covered_count < nodes.size()) {
+        if (env->deadline.expired()) {
+          LOG(info) << "Deadline reached, completing the cover with the uncovered base rectangles";
+          add_uncovered_base_rectangles(cover, covered, nodes);
+          break;
+        }
+        assert(!heap.empty());
+        std::pop_heap(heap.begin(), heap.end(), worse);
+        auto &top{rectangle_queue[heap.back()]};
+
+        const auto effective_area{uncovered_area(top)};
+        ++recomputations;
+        if (effective_area == 0) {
+          LOG(trace) << "Entry has no effective area left, pruning it";
+          heap.pop_back();
+        } else if (effective_area == top.effective_area) {
+          // the stored cost per unit is up to date and a lower bound for all other entries
+          pick(top);
+          heap.pop_back();
+        } else {
+          top.set_effective_area(effective_area);
+          LOG(trace) << "Entry is outdated, reinserting it: " << top.print().rdbuf();
+          std::push_heap(heap.begin(), heap.end(), worse);
+        }
       }
 
+      LOG(debug) << "Recomputed effective areas " << recomputations << " time(s) for "
+                 << cover.size() << " pick(s)";
+      PROFILE_COUNT("picks", cover.size());
+      PROFILE_COUNT("recomputations", recomputations);
       LOG(info) << "Greedy_set_cover_algorithm finished";
       return cover;
     }
@@ -28,18 +28,61 @@
 
 #include <CGAL/Polygon_set_2.h>
 
+#include <algorithm>
+#include <memory>
+
 #include "algorithm.h"
+#include "arena.h"
 #include "rectangle_enumerator.h"
 #include "algorithm_runner.h"
+#include "worker_pool.h"
 
 namespace cover {
     /**
      * @brief Algorithm which calculates a cover via the greedy weighted set cover algorithm
+     *
+     * Supports two engines which pick the same rectangles: the eager engine updates the affected
+     * candidates after each pick, the lazy engine keeps the candidates in a heap ordered by cost per unit and
+     * only recomputes the effective area of a candidate once it reaches the top of the heap. The eager engine can
+     * also run on multiple threads, which yields exactly the same cover as running it on a single one.
+     *
+     * With a candidate limit, both engines only consider a bounded number of candidates per top right corner instead
+     * of every rectangle of the polygon, which trades cover quality for memory and time linear in the number of base
+     * rectangles on the polygons where the full candidate set does not fit.
      */
     class Greedy_set_cover_algorithm : public Algorithm {
+    public:
+        /**
+         * Creates a new greedy set cover algorithm.
+         *
+         * @param lazy Whether to use the lazy (priority queue based) engine instead of the eager one
+         * @param threads The number of threads the eager engine uses for a single polygon, ignored by the lazy engine
+         * @param candidate_limit The number of candidates kept per top right corner in addition to the maximal
+         * rectangles and the base rectangle itself, 0 keeps all candidates
+         */
+        explicit Greedy_set_cover_algorithm(bool lazy = false, size_t threads = 1, size_t candidate_limit = 0)
+            : lazy(lazy), threads(std::max<size_t>(1, threads)), candidate_limit(candidate_limit) {}
+
+        /**
+         * Estimates the queue entries, heap and, for the eager engine, the inverted index from the number of all
+         * rectangles of the polygon and the base rectangles they contain, which bounds the candidates the filter
+         * keeps. With a candidate limit, at most candidate_limit + 2 entries per top right corner are assumed. The
+         * lazy engine adds its Area_index, the parallel eager engine the offsets of the inverted index of each chunk.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @return The estimated number of bytes
+         */
+        [[nodiscard]] size_t estimate_memory(const BaseRectGraph &graph) const override;
+
     protected:
         struct QueueEntry;
 
+        const bool lazy;
+        const size_t threads;
+        const size_t candidate_limit;
+        // created on first use and reused for all polygons this instance covers
+        std::unique_ptr<Worker_pool> pool;
+
         /**
          * Calculates a cover for the provided polygon and costs using the greedy set cover algorithm.
          *
@@ -55,6 +98,102 @@ namespace cover {
                         const Problem_instance::Costs &costs,
                         Runtime_environment *env) override;
 
+        /**
+         * Calculates a cover by updating the queue entries after each pick and keeping them in an indexed heap.
+         *
+         * An inverted index maps each base rectangle to the queue entries which contain it, so after a pick only
+         * the entries containing one of the newly covered base rectangles are updated.
+         *
+         * @param costs The costs associated with the problem instance
+         * @param env The runtime environment containing the base rectangle graph
+         * @return A cover of the polygon
+         */
+        [[nodiscard]] std::vector<Rectangle>
+        calculate_eager_cover(const Problem_instance::Costs &costs, Runtime_environment *env);
+
+        /**
+         * Calculates the same cover as calculate_eager_cover() using the worker pool.
+         *
+         * The queue entries are dealt round-robin into one chunk per thread, each with its own inverted index and
+         * heap. After each pick the chunks update their entries containing newly covered base rectangles in
+         * parallel, then the best of the chunks' heap tops is picked. The order of the entries is total, so this
+         * reduction picks the same entries as the single heap of calculate_eager_cover().
+         *
+         * @param costs The costs associated with the problem instance
+         * @param env The runtime environment containing the base rectangle graph
+         * @return A cover of the polygon
+         */
+        [[nodiscard]] std::vector<Rectangle>
+        calculate_parallel_eager_cover(const Problem_instance::Costs &costs, Runtime_environment *env);
+
+        /**
+         * Calculates a cover by keeping all queue entries in a heap ordered by cost per unit.
+         *
+         * The effective area of an entry can only decrease, hence the cost per unit stored in the heap is a lower
+         * bound of its actual cost per unit. The effective area of the top entry is recomputed from the base
+         * rectangle graph; if it did not change, the entry is the best one and is picked, otherwise it is
+         * reinserted with its updated cost per unit.
+         *
+         * Effective areas of entries spanning many grid cells are summed up through an Area_index over the
+         * uncovered base rectangles instead of walking all of their base rectangles.
+         *
+         * @param costs The costs associated with the problem instance
+         * @param env The runtime environment containing the base rectangle graph
+         * @return A cover of the polygon
+         */
+        [[nodiscard]] std::vector<Rectangle>
+        calculate_lazy_cover(const Problem_instance::Costs &costs, Runtime_environment *env);
+
+        /**
+         * Calls the visitor with the top right and bottom left node of every candidate the engines consider.
+         *
+         * Without a candidate limit, these are the candidates kept by the Candidate_filter. Otherwise, for each top
+         * right corner only the widest rectangle of each height is looked at, as the cost per unit of a rectangle
+         * decreases with its area. Of these, the maximal rectangles, the base rectangle itself and the
+         * candidate_limit ones with the lowest cost per unit are kept. Under costs for which the filter only keeps
+         * maximal rectangles, no others are added, which yields the same candidates without walking every rectangle.
+         *
+         * @param costs The costs associated with the problem instance
+         * @param graph The base rectangle graph of the polygon
+         * @param visitor Called with the top right and bottom left node of each candidate
+         */
+        template<typename Visitor>
+        void for_each_candidate(const Problem_instance::Costs &costs, const BaseRectGraph &graph,
+                                Visitor &&visitor) const;
+
+        /**
+         * Returns the number of candidates to reserve the queue entries for before for_each_candidate() is run:
+         * the exact number if all rectangles or only the base rectangles are kept, the bound of estimate_memory()
+         * with a candidate limit and otherwise only the base rectangles, as the number of maximal rectangles is not
+         * known without walking them and reserving all rectangles would hold far more than is kept.
+         *
+         * @param costs The costs associated with the problem instance
+         * @param graph The base rectangle graph of the polygon
+         * @return The number of queue entries to reserve
+         */
+        [[nodiscard]] size_t expected_candidates(const Problem_instance::Costs &costs,
+                                                 const BaseRectGraph &graph) const;
+
+        /**
+         * Returns the position of the first entry with the largest effective area, which is where both engines
+         * start. Evaluates the entries in blocks, so the comparisons can be vectorized.
+         *
+         * @param entries The queue entries, must not be empty
+         * @return The position of the first entry with the largest effective area
+         */
+        [[nodiscard]] static size_t find_largest_entry(const Arena_vector<QueueEntry> &entries);
+
+        /**
+         * Adds every base rectangle which is not covered yet to the cover, which completes the cover when the
+         * deadline is reached before the greedy loop finished.
+         *
+         * @param cover The cover built so far
+         * @param covered Whether each base rectangle is covered by the cover
+         * @param nodes The nodes of the base rectangle graph
+         */
+        static void add_uncovered_base_rectangles(std::vector<Rectangle> &cover, const Arena_vector<bool> &covered,
+                                                  const std::vector<BaseRectNode> &nodes);
+
     };
 
 } // cover
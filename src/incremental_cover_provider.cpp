@@ -0,0 +1,165 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "incremental_cover_provider.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "base_rectangle_region.h"
+#include "profile.h"
+#include "rectangle_enumerator.h"
+
+namespace cover {
+    Incremental_cover_provider::Previous_cover::Previous_cover(std::vector<Rectangle> rectangles)
+            : rectangles(std::move(rectangles)) {
+        std::sort(this->rectangles.begin(), this->rectangles.end(), [](const Rectangle &lhs, const Rectangle &rhs) {
+            return lhs.get_min_x() < rhs.get_min_x();
+        });
+    }
+
+    Incremental_cover_provider::Previous_cover
+    Incremental_cover_provider::Previous_cover::read_csv(const std::string &path) {
+        std::ifstream in{path};
+        if (!in) {
+            throw std::runtime_error("Cannot open previous cover " + path);
+        }
+
+        std::vector<Rectangle> rectangles{};
+        std::string line{};
+        std::getline(in, line);
+        if (line.rfind("polygon,", 0) != 0) {
+            throw std::runtime_error("Previous cover " + path + " does not start with a cover CSV header");
+        }
+
+        std::array<NumType, 4> coordinates{};
+        while (std::getline(in, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            std::stringstream fields{line};
+            std::string field{};
+            // the polygon index is skipped, rectangles are assigned to polygons by containment
+            std::getline(fields, field, ',');
+            for (auto &coordinate: coordinates) {
+                if (!std::getline(fields, field, ',')) {
+                    throw std::runtime_error("Malformed line in previous cover " + path + ": " + line);
+                }
+                coordinate = std::stod(field);
+            }
+            rectangles.emplace_back(coordinates[0], coordinates[1], coordinates[2], coordinates[3]);
+        }
+
+        LOG(info) << "Read " << rectangles.size() << " rectangle(s) of the previous cover from " << path;
+        return Previous_cover{std::move(rectangles)};
+    }
+
+    std::vector<Rectangle>
+    Incremental_cover_provider::Previous_cover::get_rectangles_within(const CGAL::Bbox_2 &bounds) const {
+        // rectangles within bounds have their left side within bounds, the rectangles are sorted by it
+        auto it{std::lower_bound(rectangles.begin(), rectangles.end(), bounds.xmin(),
+                                 [](const Rectangle &rectangle, double x) { return rectangle.get_min_x() < x; })};
+        std::vector<Rectangle> within{};
+        for (; it != rectangles.end() && it->get_min_x() <= bounds.xmax(); ++it) {
+            if (it->get_max_x() <= bounds.xmax() && bounds.ymin() <= it->get_min_y()
+                && it->get_max_y() <= bounds.ymax()) {
+                within.push_back(*it);
+            }
+        }
+        return within;
+    }
+
+    Cover_provider::Cover
+    Incremental_cover_provider::get_cover_for(const Polygon_with_holes &polygon,
+                                              const Problem_instance::Costs &costs,
+                                              Runtime_environment *env) {
+        PROFILE_SCOPE("incremental");
+        env->ensure_decomposition(polygon);
+        if (env->containment.empty()) {
+            env->containment.build(env->graph);
+        }
+        const auto &graph{env->graph};
+
+        // only unions of base rectangles of the new polygon are kept, the others lie across an edit
+        Cover cover{};
+        for (const auto &rectangle: previous->get_rectangles_within(polygon.outer_boundary().bbox())) {
+            if (graph.find_top_right(rectangle.get_top_right()) != BaseRectNode::NO_NEIGHBOR
+                && graph.find_bottom_left(rectangle.get_bottom_left()) != BaseRectNode::NO_NEIGHBOR
+                && env->containment.contains(graph, rectangle).value_or(false)) {
+                cover.push_back(rectangle);
+            }
+        }
+
+        env->coverage.build(graph, cover);
+        std::vector<BaseRectNode::PtrType> uncovered{};
+        for (BaseRectNode::PtrType node = 0; node < graph.getNodes().size(); node++) {
+            if (env->coverage[node] == 0) {
+                uncovered.push_back(node);
+            }
+        }
+        // the coverage does not match the cover the underlying provider computes, it must not pick it up
+        env->coverage.clear();
+
+        LOG(info) << "Keeping " << cover.size() << " rectangle(s) of the previous cover, re-covering "
+                  << uncovered.size() << " of " << graph.getNodes().size() << " base rectangles";
+        PROFILE_COUNT("kept", cover.size());
+        PROFILE_COUNT("recovered_base_rectangles", uncovered.size());
+
+        if (cover.empty()) {
+            return provider->get_cover_for(polygon, costs, env);
+        }
+
+        auto *profile{Profile::current()};
+        for (const auto &region: Base_rectangle_region::find_regions(graph, uncovered)) {
+            const auto region_polygon{region.to_polygon(graph)};
+            if (region_polygon.outer_boundary().size() == 4 && !region_polygon.has_holes()) {
+                cover.push_back(graph.to_rectangle(region.bounds));
+                continue;
+            }
+
+            Runtime_environment region_environment{};
+            region_environment.deadline = env->deadline;
+            region_environment.options = env->options;
+            Cover region_cover{};
+            {
+                // the stages of the regions add up in the profile of the polygon
+                const Profile::Activation activation{profile != nullptr ? &region_environment.profile : nullptr};
+                region_cover = provider->get_cover_for(region_polygon, costs, &region_environment);
+            }
+            if (profile != nullptr) {
+                profile->merge(region_environment.profile);
+            }
+            cover.insert(cover.end(), region_cover.begin(), region_cover.end());
+            if (region_environment.deadline.reached()) {
+                env->deadline.report();
+            }
+        }
+
+        return cover;
+    }
+} // cover
@@ -0,0 +1,100 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INCREMENTAL_COVER_PROVIDER_H
+#define INCREMENTAL_COVER_PROVIDER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cover_provider.h"
+
+namespace cover {
+
+    /**
+     * @brief Cover provider which re-covers a polygon after an edit, starting from a previous cover
+     *
+     * The rectangles of the previous cover which are still unions of base rectangles of the new polygon are kept,
+     * the rectangles lying across an edit are dropped. The base rectangles which no kept rectangle covers are grouped
+     * into connected regions and only these are covered by the underlying provider, including its postprocessors, so
+     * the work done is proportional to the size of the edit rather than to the size of the polygon.
+     *
+     * Previous rectangles are assigned to polygons by containment, so polygons may be reordered, added or removed.
+     */
+    class Incremental_cover_provider : public Cover_provider {
+    public:
+        /**
+         * @brief The rectangles of a previous cover of all polygons of an instance, sorted by their left side
+         */
+        class Previous_cover {
+        public:
+            explicit Previous_cover(std::vector<Rectangle> rectangles);
+
+            /**
+             * Reads a cover in the CSV format written by Result_writer::write_cover_csv().
+             *
+             * @param path The path of the CSV file
+             * @return The cover of all polygons
+             */
+            static Previous_cover read_csv(const std::string &path);
+
+            /**
+             * Returns all rectangles lying within the given bounding box.
+             *
+             * @param bounds The bounding box
+             * @return The rectangles within bounds
+             */
+            [[nodiscard]] std::vector<Rectangle> get_rectangles_within(const CGAL::Bbox_2 &bounds) const;
+
+            [[nodiscard]] size_t size() const { return rectangles.size(); }
+
+        private:
+            std::vector<Rectangle> rectangles;
+        };
+
+        /**
+         * @param provider The provider covering the regions which are not covered by the previous cover anymore
+         * @param previous The previous cover of the instance
+         */
+        Incremental_cover_provider(std::unique_ptr<Cover_provider> provider,
+                                   std::shared_ptr<const Previous_cover> previous)
+                : provider(std::move(provider)), previous(std::move(previous)) {}
+
+        [[nodiscard]] Cover
+        get_cover_for(const Polygon_with_holes &polygon,
+                      const Problem_instance::Costs &costs,
+                      Runtime_environment *env) override;
+
+        [[nodiscard]] bool timeouted() const override { return provider->timeouted(); }
+
+    private:
+        std::unique_ptr<Cover_provider> provider;
+        std::shared_ptr<const Previous_cover> previous;
+    };
+
+} // cover
+
+#endif //INCREMENTAL_COVER_PROVIDER_H
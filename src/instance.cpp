@@ -24,28 +24,38 @@
  */
 
 #include "instance.h"
+#include "instance_io.h"
 
 namespace cover {
 
     Problem_instance::Problem_instance(const fs::path &wkt_path,
                                        size_t rectangle_creation_cost, size_t rectangle_area_cost) :
-            multi_polygon(convert_wkt_to_multi_polygon(wkt_path)),
+            multi_polygon(std::make_shared<const MultiPolygon>(convert_wkt_to_multi_polygon(wkt_path))),
             costs({rectangle_creation_cost, rectangle_area_cost}), wkt_path(wkt_path), name(convert_to_name(wkt_path)) {
     }
 
+    Problem_instance::Problem_instance(const Problem_instance &other,
+                                       size_t rectangle_creation_cost, size_t rectangle_area_cost) :
+            multi_polygon(other.multi_polygon),
+            costs({rectangle_creation_cost, rectangle_area_cost}), wkt_path(other.wkt_path), name(other.name) {
+    }
+
+    Problem_instance::Problem_instance(std::string name, MultiPolygon multi_polygon,
+                                       size_t rectangle_creation_cost, size_t rectangle_area_cost) :
+            multi_polygon(std::make_shared<const MultiPolygon>(std::move(multi_polygon))),
+            costs({rectangle_creation_cost, rectangle_area_cost}), name(std::move(name)) {
+    }
+
     MultiPolygon Problem_instance::convert_wkt_to_multi_polygon(const fs::path &wkt_path) {
         if (!fs::exists(wkt_path)) {
-            throw std::runtime_error("Input WKT file '" + wkt_path.string() + "' not found");
+            throw std::runtime_error("Input file '" + wkt_path.string() + "' not found");
         }
 
-        if (wkt_path.extension() != ".wkt") {
-            throw std::runtime_error("File '" + wkt_path.string() + "' is not a .wkt file");
+        try {
+            return Instance_io::read(wkt_path);
+        } catch (const std::runtime_error &e) {
+            throw std::runtime_error("Input file '" + wkt_path.string() + "': " + e.what());
         }
-
-        std::ifstream wkt_stream{wkt_path.string()};
-        MultiPolygon multi_polygon{};
-        CGAL::IO::read_multi_polygon_WKT(wkt_stream, multi_polygon);
-        return multi_polygon;
     }
 
     std::string Problem_instance::convert_to_name(const fs::path &wkt_path) {
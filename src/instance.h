@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <experimental/filesystem>
 #include <fstream>
+#include <memory>
 
 #include <CGAL/IO/WKT.h>
 
@@ -61,7 +62,7 @@ namespace cover {
     protected:
         const fs::path wkt_path;
         const std::string name;
-        const MultiPolygon multi_polygon;
+        const std::shared_ptr<const MultiPolygon> multi_polygon;
         const Costs costs;
         //uint_fast64_t timeout {0};
 
@@ -87,9 +88,36 @@ namespace cover {
                          size_t rectangle_area_cost);
 
         /**
-         * Returns the compact name of the problem instance's WKT file.
+         * Constructor that creates a problem instance for the polygon of another instance with different costs. The
+         * polygon is shared between both instances instead of parsing the WKT file again.
          *
-         * @return The compact name of the problem instance's WKT file
+         * @param other The problem instance whose polygon to use
+         * @param rectangle_creation_cost Costs for creating a single rectangle when covering part of the
+         *                                    problem's MultiPolygon
+         * @param rectangle_area_cost Costs per area unit of a single rectangle when covering part of the
+         *                            problem's MultiPolygon
+         */
+        Problem_instance(const Problem_instance &other, size_t rectangle_creation_cost,
+                         size_t rectangle_area_cost);
+
+        /**
+         * Constructor that takes a MultiPolygon which was created in memory, e.g. by the Polygon_generator, instead
+         * of reading it from a WKT file.
+         *
+         * @param name The name of the problem instance
+         * @param multi_polygon The MultiPolygon to use for this problem instance
+         * @param rectangle_creation_cost Costs for creating a single rectangle when covering part of the
+         *                                    problem's MultiPolygon
+         * @param rectangle_area_cost Costs per area unit of a single rectangle when covering part of the
+         *                            problem's MultiPolygon
+         */
+        Problem_instance(std::string name, MultiPolygon multi_polygon, size_t rectangle_creation_cost,
+                         size_t rectangle_area_cost);
+
+        /**
+         * Returns the compact name of the problem instance's WKT file, or the name it was created with.
+         *
+         * @return The compact name of the problem instance
          */
         [[nodiscard]] const std::string &get_name() const {
             return name;
@@ -101,7 +129,7 @@ namespace cover {
          * @return Problem instance's underlying MultiPolygon
          */
         [[nodiscard]] const MultiPolygon &get_multi_polygon() const {
-            return multi_polygon;
+            return *multi_polygon;
         }
 
         /**
@@ -197,10 +225,10 @@ namespace cover {
 
     protected:
         /**
-         * Converts the WKT file at the passed path into a deque of polygons.
+         * Converts the WKT or binary instance file at the passed path into a deque of polygons, see Instance_io.
          *
-         * @param wkt_path The path to the WKT file
-         * @return The deque of polygons contained in the WKT file
+         * @param wkt_path The path to the WKT or binary instance file
+         * @return The deque of polygons contained in the file
          */
         static MultiPolygon convert_wkt_to_multi_polygon(const fs::path &wkt_path);
     };
@@ -0,0 +1,440 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "instance_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "util.h"
+
+namespace cover {
+    namespace {
+        constexpr char MAGIC[8] = {'W', 'R', 'C', 'I', 'N', 'S', 'T', '\0'};
+        constexpr uint32_t VERSION{1};
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t coordinate_size;
+            uint64_t polygon_count;
+            uint64_t ring_count;
+            uint64_t vertex_count;
+        };
+
+        /**
+         * Recursive descent parser for the MULTIPOLYGON of a WKT text.
+         */
+        class Wkt_parser {
+        public:
+            Wkt_parser(const char *data, size_t size) : begin(data), current(data), end(data + size) {}
+
+            MultiPolygon parse() {
+                MultiPolygon multi_polygon{};
+                if (!find_keyword("MULTIPOLYGON") || accept_keyword("EMPTY")) {
+                    return multi_polygon;
+                }
+
+                expect('(');
+                do {
+                    multi_polygon.push_back(parse_polygon());
+                } while (accept(','));
+                expect(')');
+                return multi_polygon;
+            }
+
+        private:
+            Polygon_with_holes parse_polygon() {
+                expect('(');
+                Polygon_with_holes polygon{parse_ring()};
+                while (accept(',')) {
+                    polygon.add_hole(parse_ring());
+                }
+                expect(')');
+                Util::normalize_orientation(polygon);
+                return polygon;
+            }
+
+            Polygon parse_ring() {
+                expect('(');
+                vertices.clear();
+                do {
+                    const auto x{parse_number()};
+                    const auto y{parse_number()};
+                    vertices.emplace_back(x, y);
+                } while (accept(','));
+                expect(')');
+
+                if (vertices.size() > 1 && vertices.front() == vertices.back()) {
+                    vertices.pop_back();
+                }
+                return Polygon(vertices.begin(), vertices.end());
+            }
+
+            NumType parse_number() {
+                skip_whitespace();
+                if (current != end && *current == '+') {
+                    ++current;
+                }
+
+                NumType value{};
+                const auto [next, error]{std::from_chars(current, end, value)};
+                if (error != std::errc{}) {
+                    fail("a number");
+                }
+                current = next;
+                return value;
+            }
+
+            void skip_whitespace() {
+                while (current != end && std::isspace(static_cast<unsigned char>(*current))) {
+                    ++current;
+                }
+            }
+
+            bool accept(char c) {
+                skip_whitespace();
+                if (current != end && *current == c) {
+                    ++current;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char c) {
+                if (!accept(c)) {
+                    fail(std::string{'\''} + c + '\'');
+                }
+            }
+
+            [[nodiscard]] bool matches_keyword(const char *keyword) const {
+                const auto length{std::strlen(keyword)};
+                if (static_cast<size_t>(end - current) < length) {
+                    return false;
+                }
+                for (size_t i = 0; i < length; i++) {
+                    if (std::toupper(static_cast<unsigned char>(current[i])) != keyword[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            bool accept_keyword(const char *keyword) {
+                skip_whitespace();
+                if (!matches_keyword(keyword)) {
+                    return false;
+                }
+                current += std::strlen(keyword);
+                return true;
+            }
+
+            bool find_keyword(const char *keyword) {
+                for (; current != end; ++current) {
+                    if (accept_keyword(keyword)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            [[noreturn]] void fail(const std::string &expected) const {
+                throw std::runtime_error("Malformed WKT at offset " + std::to_string(current - begin)
+                                         + ", expected " + expected);
+            }
+
+            const char *const begin;
+            const char *current;
+            const char *const end;
+            // reused for all rings, so only the polygons themselves allocate
+            std::vector<Point> vertices{};
+        };
+
+        /**
+         * Sequential reader over a memory-mapped file, copying flat arrays out of it.
+         */
+        class Reader {
+        public:
+            Reader(const char *data, size_t size) : data(data), size(size) {}
+
+            template<class T>
+            bool read(std::vector<T> &out, size_t count) {
+                if (count > (size - offset) / sizeof(T)) {
+                    return false;
+                }
+                out.resize(count);
+                std::memcpy(out.data(), data + offset, count * sizeof(T));
+                offset += count * sizeof(T);
+                return true;
+            }
+
+        private:
+            const char *data;
+            const size_t size;
+            size_t offset{0};
+        };
+
+        template<class T>
+        void write(std::ostream &out, const T *data, size_t count) {
+            out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+
+        template<class Parse>
+        MultiPolygon parse_mapped(const fs::path &path, Parse &&parse) {
+            namespace bip = boost::interprocess;
+
+            // empty files cannot be mapped
+            if (fs::file_size(path) == 0) {
+                return parse(nullptr, 0);
+            }
+
+            const bip::file_mapping mapping{path.c_str(), bip::read_only};
+            const bip::mapped_region region{mapping, bip::read_only};
+            return parse(static_cast<const char *>(region.get_address()), region.get_size());
+        }
+
+        bool is_ascending(const std::vector<uint64_t> &offsets, uint64_t total) {
+            return !offsets.empty() && offsets.front() == 0 && offsets.back() == total
+                   && std::is_sorted(offsets.begin(), offsets.end());
+        }
+
+        bool is_integer(NumType coordinate) {
+            // integers beyond 2^53 are not exactly representable as NumType anyway
+            return std::trunc(coordinate) == coordinate && std::fabs(coordinate) <= 9007199254740992.0;
+        }
+
+        /**
+         * Builds the polygons from offsets which were checked to be ascending and to give every polygon a ring.
+         */
+        template<class T>
+        MultiPolygon build_multi_polygon(const T *coordinates, const uint64_t *vertex_offsets,
+                                         const uint64_t *ring_offsets, size_t polygon_count) {
+            const auto ring_at{[&](uint64_t ring) {
+                Polygon polygon{};
+                for (auto vertex{vertex_offsets[ring]}; vertex < vertex_offsets[ring + 1]; vertex++) {
+                    polygon.push_back(Point(static_cast<NumType>(coordinates[2 * vertex]),
+                                            static_cast<NumType>(coordinates[2 * vertex + 1])));
+                }
+                return polygon;
+            }};
+
+            MultiPolygon multi_polygon{};
+            for (size_t polygon = 0; polygon < polygon_count; polygon++) {
+                const auto first_ring{ring_offsets[polygon]};
+                multi_polygon.emplace_back(ring_at(first_ring));
+                for (auto hole{first_ring + 1}; hole < ring_offsets[polygon + 1]; hole++) {
+                    multi_polygon.back().add_hole(ring_at(hole));
+                }
+                Util::normalize_orientation(multi_polygon.back());
+            }
+
+            return multi_polygon;
+        }
+
+        template<class T>
+        MultiPolygon checked_multi_polygon(const T *coordinates, const uint64_t *vertex_offsets,
+                                           const uint64_t *ring_offsets, size_t polygon_count) {
+            if (ring_offsets[0] != 0) {
+                throw std::invalid_argument("The ring offsets have to start at 0");
+            }
+            if (polygon_count == 0) {
+                // the vertex offsets and coordinates may be null, as there is nothing to point to
+                return {};
+            }
+            for (size_t polygon = 0; polygon < polygon_count; polygon++) {
+                if (ring_offsets[polygon + 1] <= ring_offsets[polygon]) {
+                    throw std::invalid_argument("Polygon " + std::to_string(polygon) + " has no ring");
+                }
+            }
+            const auto ring_count{ring_offsets[polygon_count]};
+            if (vertex_offsets[0] != 0 || !std::is_sorted(vertex_offsets, vertex_offsets + ring_count + 1)) {
+                throw std::invalid_argument("The vertex offsets have to start at 0 and be ascending");
+            }
+#ifdef COVER_INTEGER_COORDINATES
+            // rectangles store their coordinates as integers in this build, see Coordinate
+            if constexpr (std::is_floating_point_v<T>) {
+                const auto end{coordinates + 2 * vertex_offsets[ring_count]};
+                const auto coordinate{std::find_if_not(coordinates, end, is_integer)};
+                if (coordinate != end) {
+                    throw std::invalid_argument("Coordinate " + std::to_string(*coordinate) + " is not an integer, "
+                                                "which this build requires");
+                }
+            }
+#endif
+            return build_multi_polygon(coordinates, vertex_offsets, ring_offsets, polygon_count);
+        }
+
+        int64_t to_integer(NumType coordinate) {
+            if (!is_integer(coordinate)) {
+                throw std::runtime_error("Coordinate " + std::to_string(coordinate) + " is not an integer, the "
+                                         "binary instance format only supports integer coordinates");
+            }
+            return static_cast<int64_t>(coordinate);
+        }
+    }
+
+    MultiPolygon Instance_io::read(const fs::path &path) {
+        const auto extension{path.extension()};
+        if (extension == WKT_EXTENSION) {
+            return read_wkt(path);
+        } else if (extension == BINARY_EXTENSION) {
+            return read_binary(path);
+        }
+
+        throw std::runtime_error("File '" + path.string() + "' is neither a " + WKT_EXTENSION + " nor a "
+                                 + BINARY_EXTENSION + " file");
+    }
+
+    MultiPolygon Instance_io::read_wkt(const fs::path &path) {
+        return parse_mapped(path, &Instance_io::parse_wkt);
+    }
+
+    MultiPolygon Instance_io::parse_wkt(const char *data, size_t size) {
+#ifdef COVER_INTEGER_COORDINATES
+        // rectangles store their coordinates as integers in this build, see Coordinate
+        auto multi_polygon{Wkt_parser{data, size}.parse()};
+        if (!has_integer_coordinates(multi_polygon)) {
+            throw std::runtime_error("WKT has non-integer coordinates, which this build does not support");
+        }
+        return multi_polygon;
+#else
+        return Wkt_parser{data, size}.parse();
+#endif
+    }
+
+    MultiPolygon Instance_io::read_binary(const fs::path &path) {
+        return parse_mapped(path, [&path](const char *data, size_t size) {
+            const auto corrupt{[&path](const std::string &reason) {
+                return std::runtime_error("Binary instance file '" + path.string() + "' is " + reason);
+            }};
+
+            Header header{};
+            if (size < sizeof(Header)) {
+                throw corrupt("truncated");
+            }
+            std::memcpy(&header, data, sizeof(Header));
+            if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+                || header.coordinate_size != sizeof(int64_t)) {
+                throw corrupt("of an unknown format");
+            }
+
+            Reader reader{data + sizeof(Header), size - sizeof(Header)};
+            std::vector<uint64_t> ring_offsets{};
+            std::vector<uint64_t> vertex_offsets{};
+            std::vector<int64_t> coordinates{};
+            if (header.polygon_count >= size || header.ring_count >= size || header.vertex_count >= size
+                || !reader.read(ring_offsets, header.polygon_count + 1)
+                || !reader.read(vertex_offsets, header.ring_count + 1)
+                || !reader.read(coordinates, header.vertex_count * 2)) {
+                throw corrupt("truncated");
+            }
+            if (!is_ascending(ring_offsets, header.ring_count) || !is_ascending(vertex_offsets, header.vertex_count)) {
+                throw corrupt("corrupt");
+            }
+
+            for (uint64_t polygon = 0; polygon < header.polygon_count; polygon++) {
+                if (ring_offsets[polygon] == ring_offsets[polygon + 1]) {
+                    throw corrupt("corrupt");
+                }
+            }
+
+            return build_multi_polygon(coordinates.data(), vertex_offsets.data(), ring_offsets.data(),
+                                       header.polygon_count);
+        });
+    }
+
+    MultiPolygon Instance_io::from_arrays(const int64_t *coordinates, const uint64_t *vertex_offsets,
+                                          const uint64_t *ring_offsets, size_t polygon_count) {
+        return checked_multi_polygon(coordinates, vertex_offsets, ring_offsets, polygon_count);
+    }
+
+    MultiPolygon Instance_io::from_arrays(const double *coordinates, const uint64_t *vertex_offsets,
+                                          const uint64_t *ring_offsets, size_t polygon_count) {
+        return checked_multi_polygon(coordinates, vertex_offsets, ring_offsets, polygon_count);
+    }
+
+    bool Instance_io::has_integer_coordinates(const MultiPolygon &multi_polygon) {
+        const auto is_integer_ring{[](const Polygon &ring) {
+            return std::all_of(ring.vertices_begin(), ring.vertices_end(), [](const Point &vertex) {
+                return is_integer(vertex.x()) && is_integer(vertex.y());
+            });
+        }};
+
+        return std::all_of(multi_polygon.begin(), multi_polygon.end(), [&](const Polygon_with_holes &polygon) {
+            return is_integer_ring(polygon.outer_boundary())
+                   && std::all_of(polygon.holes().begin(), polygon.holes().end(), is_integer_ring);
+        });
+    }
+
+    void Instance_io::write_binary(const MultiPolygon &multi_polygon, const fs::path &path) {
+        std::vector<uint64_t> ring_offsets{0};
+        std::vector<uint64_t> vertex_offsets{0};
+        std::vector<int64_t> coordinates{};
+
+        const auto add_ring{[&](const Polygon &ring) {
+            for (auto it = ring.vertices_begin(); it != ring.vertices_end(); ++it) {
+                coordinates.push_back(to_integer(it->x()));
+                coordinates.push_back(to_integer(it->y()));
+            }
+            vertex_offsets.push_back(coordinates.size() / 2);
+        }};
+
+        for (const auto &polygon: multi_polygon) {
+            add_ring(polygon.outer_boundary());
+            for (const auto &hole: polygon.holes()) {
+                add_ring(hole);
+            }
+            ring_offsets.push_back(vertex_offsets.size() - 1);
+        }
+
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.coordinate_size = sizeof(int64_t);
+        header.polygon_count = multi_polygon.size();
+        header.ring_count = vertex_offsets.size() - 1;
+        header.vertex_count = coordinates.size() / 2;
+
+        std::ofstream out{path.string(), std::ios_base::binary | std::ios_base::trunc};
+        write(out, &header, 1);
+        write(out, ring_offsets.data(), ring_offsets.size());
+        write(out, vertex_offsets.data(), vertex_offsets.size());
+        write(out, coordinates.data(), coordinates.size());
+        if (!out) {
+            throw std::runtime_error("Could not write binary instance file '" + path.string() + "'");
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef COVERING_INSTANCE_IO_H
+#define COVERING_INSTANCE_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <experimental/filesystem>
+#include <string>
+
+#include "CGAL_classes.h"
+
+namespace fs = std::experimental::filesystem;
+
+namespace cover {
+    /**
+     * @brief Reading and writing of the polygons of problem instances
+     *
+     * Instances are read either from WKT files containing a MULTIPOLYGON, or from a compact binary format. Both are
+     * memory-mapped. The WKT reader parses the coordinates straight out of the mapping instead of going through
+     * CGAL's stream based reader, which is a large share of the total runtime on big instances.
+     *
+     * A binary instance file consists of a header with the number of polygons, rings and vertices, followed by three
+     * flat arrays: for each polygon the index of its first ring, for each ring the index of its first vertex (both
+     * with one trailing entry holding the total) and the interleaved x and y coordinates of all vertices as 64 bit
+     * integers. The first ring of a polygon is its outer boundary, the remaining ones are its holes. Rings are stored
+     * without repeating the first vertex and all values are in native byte order.
+     */
+    class Instance_io {
+    public:
+        static constexpr const char *WKT_EXTENSION{".wkt"};
+        static constexpr const char *BINARY_EXTENSION{".wrci"};
+
+        /**
+         * Reads the polygons of an instance, choosing the format by the extension of the file.
+         *
+         * @param path Path to a .wkt or .wrci file
+         * @return The polygons of the instance
+         */
+        static MultiPolygon read(const fs::path &path);
+
+        /**
+         * Reads the first MULTIPOLYGON of a WKT file. Like CGAL's reader, the closing vertex of each ring is dropped.
+         * Rings are reoriented where needed, see Util::normalize_orientation.
+         *
+         * @param path Path to the WKT file
+         * @return The polygons of the MULTIPOLYGON, empty if the file contains none
+         */
+        static MultiPolygon read_wkt(const fs::path &path);
+
+        /**
+         * Parses the first MULTIPOLYGON of WKT text, see read_wkt. If rectangles store integer coordinates, see
+         * Coordinate, non-integer coordinates throw std::runtime_error like malformed text.
+         *
+         * @param data The WKT text, which needs not be null-terminated
+         * @param size The length of the text
+         * @return The polygons of the MULTIPOLYGON, empty if the text contains none
+         */
+        static MultiPolygon parse_wkt(const char *data, size_t size);
+
+        /**
+         * @param path Path to a binary instance file
+         * @return The polygons stored in the file
+         */
+        static MultiPolygon read_binary(const fs::path &path);
+
+        /**
+         * Builds polygons from flat arrays laid out like the binary instance format, e.g. handed over by an
+         * application embedding the library: for each polygon the index of its first ring and for each ring the
+         * index of its first vertex, both with one trailing entry holding the total, and the interleaved x and y
+         * coordinates of the vertices. The first ring of a polygon is its outer boundary, the remaining ones are
+         * its holes, rings are reoriented like in read_wkt. Throws std::invalid_argument if the offsets are
+         * not ascending or a polygon has no ring. Without polygons, only ring_offsets is read.
+         *
+         * @param coordinates The interleaved coordinates of all vertices
+         * @param vertex_offsets The index of the first vertex of each ring, ring_count + 1 entries
+         * @param ring_offsets The index of the first ring of each polygon, polygon_count + 1 entries
+         * @param polygon_count The number of polygons
+         * @return The polygons
+         */
+        static MultiPolygon from_arrays(const int64_t *coordinates, const uint64_t *vertex_offsets,
+                                        const uint64_t *ring_offsets, size_t polygon_count);
+
+        /**
+         * Same as the other from_arrays, for coordinates which are not necessarily integers. If rectangles store
+         * integer coordinates, see Coordinate, non-integer coordinates throw std::invalid_argument as well.
+         */
+        static MultiPolygon from_arrays(const double *coordinates, const uint64_t *vertex_offsets,
+                                        const uint64_t *ring_offsets, size_t polygon_count);
+
+        /**
+         * @param multi_polygon The polygons to check
+         * @return Whether all vertices of the polygons have integer coordinates
+         */
+        static bool has_integer_coordinates(const MultiPolygon &multi_polygon);
+
+        /**
+         * Writes polygons in the binary instance format. Throws if a coordinate is not an integer.
+         *
+         * @param multi_polygon The polygons to write
+         * @param path The path of the file to write
+         */
+        static void write_binary(const MultiPolygon &multi_polygon, const fs::path &path);
+    };
+}
+
+#endif //COVERING_INSTANCE_IO_H
@@ -0,0 +1,269 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "lagrangian_algorithm.h"
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "candidate_filter.h"
+#include "profile.h"
+
+namespace cover {
+
+    void Lagrangian_algorithm::for_each_chunk(size_t count,
+                                              const std::function<void(size_t, size_t, size_t)> &task) {
+      const auto chunk_count{(count + CHUNK_SIZE - 1) / CHUNK_SIZE};
+      pool->run(chunk_count, [&](size_t chunk, size_t) {
+        task(chunk, chunk * CHUNK_SIZE, std::min(count, (chunk + 1) * CHUNK_SIZE));
+      });
+    }
+
+    std::vector<uint32_t> Lagrangian_algorithm::build_cover(const Incidence &incidence,
+                                                            const std::vector<double> &reduced_costs) {
+      std::vector<uint32_t> counts(incidence.node_count(), 0);
+      std::vector<uint32_t> picks{};
+      auto pick = [&](uint32_t candidate) {
+        picks.push_back(candidate);
+        for (auto k = incidence.candidate_offsets[candidate]; k < incidence.candidate_offsets[candidate + 1]; k++) {
+          ++counts[incidence.candidate_nodes[k]];
+        }
+      };
+
+      for (uint32_t candidate = 0; candidate < incidence.candidate_count(); candidate++) {
+        if (reduced_costs[candidate] < 0) {
+          pick(candidate);
+        }
+      }
+      for (size_t node = 0; node < incidence.node_count(); node++) {
+        if (counts[node] > 0) {
+          continue;
+        }
+        auto best{incidence.node_candidates[incidence.node_offsets[node]]};
+        for (auto k = incidence.node_offsets[node] + 1; k < incidence.node_offsets[node + 1]; k++) {
+          const auto candidate{incidence.node_candidates[k]};
+          if (reduced_costs[candidate] < reduced_costs[best]) {
+            best = candidate;
+          }
+        }
+        pick(best);
+      }
+
+      // the most expensive candidates are removed first, ties in the order they were picked
+      std::stable_sort(picks.begin(), picks.end(), [&incidence](uint32_t lhs, uint32_t rhs) {
+        return incidence.costs[lhs] > incidence.costs[rhs];
+      });
+      std::vector<uint32_t> cover{};
+      cover.reserve(picks.size());
+      for (const auto candidate: picks) {
+        const auto first{incidence.candidate_offsets[candidate]};
+        const auto last{incidence.candidate_offsets[candidate + 1]};
+        bool redundant{true};
+        for (auto k = first; k < last && redundant; k++) {
+          redundant = counts[incidence.candidate_nodes[k]] > 1;
+        }
+        if (redundant) {
+          for (auto k = first; k < last; k++) {
+            --counts[incidence.candidate_nodes[k]];
+          }
+        } else {
+          cover.push_back(candidate);
+        }
+      }
+      return cover;
+    }
+
+    size_t Lagrangian_algorithm::estimate_memory(const BaseRectGraph &graph) const {
+      const auto node_count{graph.getNodes().size()};
+      const auto counts{graph.count_all_candidates()};
+      // the candidates' corners, costs, offsets and reduced costs, both directions of the incidence and the
+      // offsets and multipliers of the base rectangles
+      return counts.rectangles * (2 * sizeof(uint32_t) + 2 * sizeof(double) + sizeof(size_t))
+             + counts.incidences * 2 * sizeof(uint32_t)
+             + node_count * (sizeof(size_t) + 2 * sizeof(double));
+    }
+
+    std::vector<Rectangle> Lagrangian_algorithm::calculate_cover(
+        const Polygon_with_holes &polygon, const Problem_instance::Costs &costs,
+        Runtime_environment *env) {
+      LOG(info) << "Running Lagrangian relaxation algorithm (using base rectangle graph)";
+      env->ensure_decomposition(polygon);
+      if (pool == nullptr) {
+        pool = std::make_unique<Worker_pool>(threads);
+      }
+      const auto &graph{env->graph};
+      const auto node_count{graph.getNodes().size()};
+
+      Incidence incidence{};
+      {
+        PROFILE_SCOPE("incidence");
+        incidence.candidate_offsets.push_back(0);
+        Candidate_filter{costs}.for_each_candidate(graph, [&](BaseRectNode::PtrType top_right,
+                                                              BaseRectNode::PtrType bottom_left) {
+          incidence.top_rights.push_back(static_cast<uint32_t>(top_right));
+          incidence.bottom_lefts.push_back(static_cast<uint32_t>(bottom_left));
+          incidence.costs.push_back(static_cast<double>(Problem_instance::calculate_total_cost_of_rectangle(
+              graph.get_rectangle(top_right, bottom_left), costs)));
+          for (auto it = graph.begin(top_right, bottom_left); it != graph.end(); ++it) {
+            incidence.candidate_nodes.push_back(static_cast<uint32_t>(*it));
+          }
+          incidence.candidate_offsets.push_back(incidence.candidate_nodes.size());
+        });
+        assert(incidence.candidate_count() < std::numeric_limits<uint32_t>::max());
+
+        incidence.node_offsets.assign(node_count + 1, 0);
+        for (const auto node: incidence.candidate_nodes) {
+          ++incidence.node_offsets[node + 1];
+        }
+        std::partial_sum(incidence.node_offsets.begin(), incidence.node_offsets.end(),
+                         incidence.node_offsets.begin());
+        incidence.node_candidates.resize(incidence.candidate_nodes.size());
+        auto insert_positions{incidence.node_offsets};
+        for (uint32_t candidate = 0; candidate < incidence.candidate_count(); candidate++) {
+          for (auto k = incidence.candidate_offsets[candidate]; k < incidence.candidate_offsets[candidate + 1]; k++) {
+            incidence.node_candidates[insert_positions[incidence.candidate_nodes[k]]++] = candidate;
+          }
+        }
+      }
+      PROFILE_COUNT("candidates", incidence.candidate_count());
+      Memory_account::Charge charge{env->memory};
+      charge.add(incidence.memory_usage());
+      const auto candidate_count{incidence.candidate_count()};
+
+      // start from the cheapest cost per base rectangle of any candidate containing it
+      std::vector<double> multipliers(node_count, std::numeric_limits<double>::infinity());
+      for (uint32_t candidate = 0; candidate < candidate_count; candidate++) {
+        const auto first{incidence.candidate_offsets[candidate]};
+        const auto last{incidence.candidate_offsets[candidate + 1]};
+        const auto share{incidence.costs[candidate] / static_cast<double>(last - first)};
+        for (auto k = first; k < last; k++) {
+          auto &multiplier{multipliers[incidence.candidate_nodes[k]]};
+          multiplier = std::min(multiplier, share);
+        }
+      }
+
+      std::vector<double> reduced_costs(candidate_count);
+      std::vector<double> subgradient(node_count);
+      std::vector<double> chunk_sums((std::max(candidate_count, node_count) + CHUNK_SIZE - 1) / CHUNK_SIZE);
+      charge.add((multipliers.size() + reduced_costs.size() + subgradient.size()) * sizeof(double));
+      std::vector<uint32_t> best_cover{};
+      double upper_bound{std::numeric_limits<double>::infinity()};
+      double lower_bound{-std::numeric_limits<double>::infinity()};
+      double step{INITIAL_STEP};
+      size_t stalled{0};
+      size_t iteration{0};
+
+      PROFILE_SCOPE("subgradient");
+      for (; iteration < max_iterations; iteration++) {
+        // reduced costs and the Lagrangian bound, summed per chunk in a fixed order to be independent of the threads
+        for_each_chunk(candidate_count, [&](size_t chunk, size_t begin, size_t end) {
+          double negative_sum{0};
+          for (auto candidate = begin; candidate < end; candidate++) {
+            auto reduced_cost{incidence.costs[candidate]};
+            for (auto k = incidence.candidate_offsets[candidate]; k < incidence.candidate_offsets[candidate + 1];
+                 k++) {
+              reduced_cost -= multipliers[incidence.candidate_nodes[k]];
+            }
+            reduced_costs[candidate] = reduced_cost;
+            negative_sum += std::min(0.0, reduced_cost);
+          }
+          chunk_sums[chunk] = negative_sum;
+        });
+        const auto bound{std::accumulate(multipliers.begin(), multipliers.end(), 0.0)
+                         + std::accumulate(chunk_sums.begin(),
+                                           chunk_sums.begin() + (candidate_count + CHUNK_SIZE - 1) / CHUNK_SIZE, 0.0)};
+        if (bound > lower_bound) {
+          lower_bound = bound;
+          stalled = 0;
+        } else if (++stalled >= STALL_ITERATIONS) {
+          step /= 2;
+          stalled = 0;
+        }
+
+        auto cover{build_cover(incidence, reduced_costs)};
+        const auto cover_cost{std::accumulate(cover.begin(), cover.end(), 0.0, [&incidence](double sum, uint32_t c) {
+          return sum + incidence.costs[c];
+        })};
+        if (cover_cost < upper_bound) {
+          upper_bound = cover_cost;
+          best_cover = std::move(cover);
+          LOG(debug) << "Iteration " << iteration << ": cover of cost " << upper_bound << ", lower bound "
+                     << lower_bound;
+        }
+
+        // costs are integral, so a cover less than 1 above the lower bound is optimal
+        if (upper_bound - lower_bound < 1 - 1e-9 || step < MIN_STEP) {
+          break;
+        }
+        if (env->deadline.expired()) {
+          LOG(info) << "Deadline reached, returning the best cover so far";
+          break;
+        }
+
+        // covering a base rectangle more than once drives its multiplier down, not covering it drives it up
+        for_each_chunk(node_count, [&](size_t chunk, size_t begin, size_t end) {
+          double norm{0};
+          for (auto node = begin; node < end; node++) {
+            double gradient{1};
+            for (auto k = incidence.node_offsets[node]; k < incidence.node_offsets[node + 1]; k++) {
+              if (reduced_costs[incidence.node_candidates[k]] < 0) {
+                gradient -= 1;
+              }
+            }
+            // multipliers at zero cannot decrease any further, their direction does not count towards the step
+            if (multipliers[node] <= 0 && gradient < 0) {
+              gradient = 0;
+            }
+            subgradient[node] = gradient;
+            norm += gradient * gradient;
+          }
+          chunk_sums[chunk] = norm;
+        });
+        const auto norm{std::accumulate(chunk_sums.begin(),
+                                        chunk_sums.begin() + (node_count + CHUNK_SIZE - 1) / CHUNK_SIZE, 0.0)};
+        if (norm == 0) {
+          // the multipliers would not change anymore
+          break;
+        }
+        const auto step_length{step * (upper_bound - bound) / norm};
+        for (size_t node = 0; node < node_count; node++) {
+          multipliers[node] = std::max(0.0, multipliers[node] + step_length * subgradient[node]);
+        }
+      }
+
+      LOG(info) << "Lagrangian relaxation stopped after " << iteration << " iteration(s) with a cover of cost "
+                << upper_bound << " and a lower bound of " << lower_bound;
+      PROFILE_COUNT("iterations", iteration);
+
+      std::vector<Rectangle> cover{};
+      cover.reserve(best_cover.size());
+      for (const auto candidate: best_cover) {
+        cover.push_back(graph.get_rectangle(incidence.top_rights[candidate], incidence.bottom_lefts[candidate]));
+      }
+      return cover;
+    }
+
+} // cover
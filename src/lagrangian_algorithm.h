@@ -0,0 +1,140 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LAGRANGIAN_ALGORITHM_H
+#define LAGRANGIAN_ALGORITHM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "algorithm.h"
+#include "worker_pool.h"
+
+namespace cover {
+
+    /**
+     * @brief Algorithm which covers a polygon via the Lagrangian relaxation of the set cover ILP, without a solver
+     *
+     * Relaxes the constraint of every base rectangle to be covered with a multiplier and improves the resulting lower
+     * bound with the subgradient method. In every iteration, the candidates with negative reduced cost are taken,
+     * the base rectangles they leave uncovered are covered by their candidate with the lowest reduced cost, and
+     * redundant candidates are removed again, most expensive first. The cheapest such cover is returned.
+     *
+     * Stops once the cover is provably optimal, the step size vanished, the iteration limit or the deadline is
+     * reached, so it always returns a valid cover. The reduced costs and subgradients are computed on multiple
+     * threads in chunks of fixed size, so the cover does not depend on the number of threads.
+     */
+    class Lagrangian_algorithm : public Algorithm {
+    public:
+        static constexpr size_t DEFAULT_MAX_ITERATIONS{500};
+
+        /**
+         * @param threads The number of threads used for a single polygon
+         * @param max_iterations The maximum number of subgradient iterations
+         */
+        explicit Lagrangian_algorithm(size_t threads = 1, size_t max_iterations = DEFAULT_MAX_ITERATIONS)
+                : threads(std::max<size_t>(1, threads)), max_iterations(max_iterations) {}
+
+        /**
+         * Estimates the incidence matrix and the per candidate and per base rectangle vectors of the subgradient
+         * method from the number of all rectangles of the polygon and the base rectangles they contain.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @return The estimated number of bytes
+         */
+        [[nodiscard]] size_t estimate_memory(const BaseRectGraph &graph) const override;
+
+    protected:
+        /**
+         * Calculates a cover for the provided polygon and costs from the Lagrangian relaxation.
+         *
+         * @param polygon The polygon to cover
+         * @param costs The costs associated with the problem instance
+         * @return A cover of the polygon
+         */
+        [[nodiscard]] std::vector<Rectangle>
+        calculate_cover(const Polygon_with_holes &polygon,
+                        const Problem_instance::Costs &costs,
+                        Runtime_environment *env) override;
+
+    private:
+        // the step size is halved after this many iterations without improving the lower bound
+        static constexpr size_t STALL_ITERATIONS{20};
+        static constexpr double INITIAL_STEP{2.0};
+        static constexpr double MIN_STEP{1e-4};
+        static constexpr size_t CHUNK_SIZE{4096};
+
+        /**
+         * @brief The candidates together with the base rectangles they contain and vice versa, in CSR format
+         */
+        struct Incidence {
+            std::vector<uint32_t> top_rights;
+            std::vector<uint32_t> bottom_lefts;
+            std::vector<double> costs;
+            std::vector<size_t> candidate_offsets;
+            std::vector<uint32_t> candidate_nodes;
+            std::vector<size_t> node_offsets;
+            std::vector<uint32_t> node_candidates;
+
+            [[nodiscard]] size_t candidate_count() const { return costs.size(); }
+
+            [[nodiscard]] size_t node_count() const { return node_offsets.size() - 1; }
+
+            [[nodiscard]] size_t memory_usage() const {
+                return (top_rights.capacity() + bottom_lefts.capacity() + candidate_nodes.capacity()
+                        + node_candidates.capacity()) * sizeof(uint32_t) + costs.capacity() * sizeof(double)
+                       + (candidate_offsets.capacity() + node_offsets.capacity()) * sizeof(size_t);
+            }
+        };
+
+        /**
+         * Builds a cover from the reduced costs: takes all candidates with negative reduced cost, covers the
+         * remaining base rectangles by their candidate with the lowest reduced cost and removes redundant
+         * candidates, most expensive first.
+         *
+         * @param incidence The candidates and base rectangles
+         * @param reduced_costs The reduced cost of each candidate
+         * @return The indices of the candidates of the cover
+         */
+        [[nodiscard]] static std::vector<uint32_t> build_cover(const Incidence &incidence,
+                                                               const std::vector<double> &reduced_costs);
+
+        /**
+         * Runs the task for every chunk of CHUNK_SIZE indices in [0, count) on the pool.
+         */
+        void for_each_chunk(size_t count, const std::function<void(size_t chunk, size_t begin, size_t end)> &task);
+
+        const size_t threads;
+        const size_t max_iterations;
+        // created on first use and reused for all polygons this instance covers
+        std::unique_ptr<Worker_pool> pool;
+    };
+
+} // cover
+
+#endif //LAGRANGIAN_ALGORITHM_H
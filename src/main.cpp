@@ -27,6 +27,7 @@
 #include <iostream>
 #include <iomanip>
 #include <ctime>
+#include <limits>
 
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/utility/setup/file.hpp>
@@ -37,17 +38,29 @@
 #include "CLI/Config.hpp"
 
 #include "instance.h"
+#include "instance_io.h"
 #include "strip_algorithm.h"
 #include "partition_algorithm.h"
 #include "result_writer.h"
 #include "algorithm_runner.h"
+#include "cover_provider_factory.h"
+#include "batch_runner.h"
+#include "cover_server.h"
+#include "polygon_generator.h"
 #include "bbox_cover_splitter.h"
 #include "partition_cover_splitter.h"
 #include "cover_joiner.h"
+#include "cover_joiner_fixpoint.h"
 #include "greedy_set_cover_algorithm.h"
+#include "lagrangian_algorithm.h"
+#include "branch_and_bound_algorithm.h"
 #include "ILP_algorithm.h"
 #include "cover_trimmer.h"
+#include "incremental_cover_provider.h"
+#include "portfolio_algorithm.h"
+#include "tiled_cover_provider.h"
 #include "cover_pruner.h"
+#include "cover_prune_trimmer.h"
 #include "cover_joiner_full.h"
 #include "bbox_cover_splitter.h"
 #include "partition_cover_splitter.h"
@@ -62,107 +75,218 @@ std::ostream &operator<<(std::ostream &s, const std::chrono::time_point<std::chr
     return s;
 }
 
-std::vector<std::string> split(const std::string &str) {
-    std::size_t pos, startPos = 0;
-    std::vector<std::string> tokens;
-    while ((pos = str.find("+", startPos, 1)) != std::string::npos) {
-        tokens.emplace_back(str.substr(startPos, pos - startPos));
-        startPos = pos + 1;
-    }
-    tokens.emplace_back(str.substr(startPos));
-    return tokens;
-}
-
-std::unique_ptr<Algorithm> string_to_algorithm(const std::string &str, double timeout) {
-    if (str == "greedy") {
-        return std::make_unique<Greedy_set_cover_algorithm>();
-    } else if (str == "strip") {
-        return std::make_unique<Strip_algorithm>();
-    } else if (str == "partition") {
-        return std::make_unique<Partition_algorithm>();
-    }
-#ifdef GUROBI_AVAILABLE
-        else if (str == "ilp") {
-            return std::make_unique<ILP_algorithm>(false, timeout);
-        } else if (str == "ilp-pixel") {
-            return std::make_unique<ILP_algorithm>(true, timeout);
-        }
-#else
-    else if (str == "ilp" || str == "ilp-pixel") {
-        throw std::runtime_error("Cannot use ilp formulation as Gurobi was unavailable at compile time");
-    }
-#endif
-    else {
-        throw std::runtime_error("Unknown algorithm name specified");
-    }
-}
-
-template<class T>
-std::unique_ptr<Cover_postprocessor> string_to_postprocessor(const std::string &str,
-                                                             std::unique_ptr<T> previous_provider) {
-    if (str == "prune") {
-        return std::make_unique<Cover_pruner>(std::move(previous_provider));
-    } else if (str == "trim") {
-        return std::make_unique<Cover_trimmer>(std::move(previous_provider));
-    } else if (str == "join") {
-        return std::make_unique<Cover_joiner>(std::move(previous_provider));
-    } else if (str == "join-full") {
-        return std::make_unique<Cover_joiner_full>(std::move(previous_provider));
-    } else if (str == "bbox-split") {
-        return std::make_unique<Bounding_box_cover_splitter>(std::move(previous_provider));
-    } else if (str == "partition-split") {
-        return std::make_unique<Partition_cover_splitter>(std::move(previous_provider));
-    } else {
-        throw std::runtime_error("Unknown postprocessor name specified: " + str);
-    }
-}
-
-
-
 int main(int argc, char **argv) {
 
     CLI::App app{"App description"};
 
     std::string polygon_wkt_path{};
-    app.add_option("-i,--input,input", polygon_wkt_path, "path to this problem instance's polygon's WKT file")
-            ->required()
+    auto *input_option = app.add_option("-i,--input,input", polygon_wkt_path, "path to this problem instance's "
+                                                                              "polygon's WKT (.wkt) or binary "
+                                                                              "instance (.wrci) file, required unless "
+                                                                              "--batch or --generate is used")
             ->check(CLI::ExistingFile);
 
+    std::string generator_specification{};
+    app.add_option("--generate", generator_specification, "generate this problem instance's polygons in memory "
+                                                            "instead of reading them from a WKT file, given as "
+                                                            "shape[:key=value,...] with shape being orthogonal, "
+                                                            "staircase, comb or raster and keys size, holes, aspect, "
+                                                            "density and seed, e.g. raster:size=128,seed=7")
+            ->excludes(input_option);
+
+    bool convert{false};
+    app.add_flag("--convert", convert, "instead of solving the instance given by --input or --generate, write its "
+                                       "polygons to --output in the binary instance format (.wrci), which loads "
+                                       "much faster than WKT, requires integer coordinates");
+
     std::pair<CostType, CostType> costs{};
-    app.add_option("-c,--costs,costs", costs, "(creation cost, area cost) pair for this problem instance")
-            ->required()
+    auto *costs_option = app.add_option("-c,--costs,costs", costs, "(creation cost, area cost) pair for this "
+                                                                   "problem instance, required unless --batch is used")
             ->check(CLI::Range(0, std::numeric_limits<int>::max()));
 
     std::string algorithm_name{};
     app.add_option("-a,--algorithm,algorithm", algorithm_name, "name of the algorithm to use to solve the passed "
-                                                               "problem instance.")
-            ->required()
+                                                               "problem instance, required unless --batch is used")
+            ->ignore_case();
+
+    std::vector<std::string> portfolio_names{};
+    app.add_option("--portfolio", portfolio_names, "full names of the algorithms run concurrently on each polygon by "
+                                                   "the 'portfolio' algorithm, e.g. strip+prune+trim greedy+join, "
+                                                   "the cheapest valid cover is kept")
             ->ignore_case();
 
+    std::string batch_path{};
+    app.add_option("--batch", batch_path, "path to a manifest in JSON lines format, each line specifying an "
+                                          "\"input\" WKT file, \"costs\" as a pair or a list of pairs, an "
+                                          "\"algorithm\" and optionally \"postprocessors\", all entries are run "
+                                          "in one process, reusing instances and their decompositions, and one "
+                                          "result record per run is written to the output")
+            ->check(CLI::ExistingFile);
+
+    bool serve{false};
+    app.add_flag("--serve", serve, "keep running and answer cover requests read from stdin in JSON lines format, "
+                                   "one line each with an optional \"id\", an \"input\" file or inline \"wkt\", "
+                                   "\"costs\", an \"algorithm\" and optionally \"postprocessors\" and a "
+                                   "\"timeout\", one reply per request is written to stdout as soon as it's done");
+
+    std::string socket_path{};
+    app.add_option("--socket", socket_path, "with --serve, listen for clients on a Unix domain socket at this path "
+                                            "instead of reading from stdin, a socket left there is replaced, "
+                                            "any other file is kept and the server does not start");
+
+    size_t serve_workers{1};
+    app.add_option("--serve-workers", serve_workers, "number of requests --serve handles concurrently, default is 1")
+            ->check(CLI::PositiveNumber);
+
+    size_t cache_size{16};
+    app.add_option("--cache-size", cache_size, "number of instances --serve keeps in memory along with the "
+                                               "decompositions of their polygons, the least recently used one is "
+                                               "dropped first, default is 16");
+
     std::vector<std::string> postprocessor_names{};
     app.add_option("-p,--postprocessors,postprocessors", postprocessor_names, "names of the postprocessors to run on "
                                                                               "the cover returned by the algorithm, "
                                                                               "executed in order from left to right")
             ->ignore_case()
-            ->check(CLI::IsMember({"prune", "trim", "trim-reverse", "join", "join-full",
-                                   "bbox-split", "partition-split",
+            ->check(CLI::IsMember({"prune", "trim", "prune-trim", "trim-reverse", "join", "join-fixpoint",
+                                   "join-full", "bbox-split", "partition-split",
                                    "brprune", "brbbox-split", "brpartition-split", "brtrim"}));
 
     std::string output_path{};
     app.add_option("-o,--output,output", output_path, "path where the JSON or CSV file containing the results of "
                                                            "running the algorithm on the input should be created, "
                                                            "non-existing folders will be created, pre-existing JSON files "
-                                                           "will be overwritten")
-            ->required();
+                                                           "will be overwritten, required unless "
+                                                           "--serve is used");
+
+    std::string geometry{"full"};
+    app.add_option("--geometry", geometry, "geometry written to JSON results as WKT, 'full' writes the input "
+                                           "polygon and the cover, 'cover' only the cover and 'none' neither, "
+                                           "which keeps the output of big instances small and fast to write")
+            ->ignore_case()
+            ->check(CLI::IsMember({"full", "cover", "none"}));
+
+    std::string cover_csv_path{};
+    app.add_option("--cover-csv", cover_csv_path, "path of a CSV file the rectangles of the cover are written to, "
+                                                  "one \"polygon,min_x,min_y,max_x,max_y\" line each, e.g. "
+                                                  "together with --geometry none");
+
+    size_t tile_size{0};
+    app.add_option("--tile-size", tile_size, "cut polygons with more base rectangles than this into tiles of about "
+                                             "this many base rectangles, which are covered independently and "
+                                             "stitched together, default is 0 (no tiling)");
+
+    size_t tile_threads{1};
+    app.add_option("--tile-threads", tile_threads, "number of threads covering the tiles of a single polygon, "
+                                                   "multiplies with --threads, default is 1")
+            ->check(CLI::PositiveNumber);
+
+    std::string previous_cover_path{};
+    app.add_option("--previous-cover", previous_cover_path, "path of a cover CSV file written by --cover-csv for a "
+                                                            "previous version of the input, only the parts of the "
+                                                            "polygons it does not cover anymore are re-covered")
+            ->check(CLI::ExistingFile);
+
+    bool stream{false};
+    app.add_flag("--stream", stream, "write the result of each polygon to the output as a JSON line as soon as the "
+                                     "polygon is done and release its cover right after, followed by a line with "
+                                     "the total as polygon 0, instead of a single JSON document at the end");
+
+    bool pipeline{false};
+    app.add_flag("--pipeline", pipeline, "decompose the next polygons and verify and write the finished ones on "
+                                         "separate threads while the algorithm runs, only with --threads 1, the "
+                                         "decomposition is then not part of the measured execution time");
 
     bool verify_cover{true};
     app.add_option("-v,--verify", verify_cover, "whether to verify that the algorithm's result is actually a valid "
                                                 "cover, default is true, the time spent verifying is not counted "
                                                 "towards the algorithm's execution time");
 
+    std::string verification_method{"boolean"};
+    app.add_option("--verification-method", verification_method, "method used to verify covers, 'boolean' uses "
+                                                                 "CGAL boolean operations, 'graph' resolves the "
+                                                                 "cover's rectangles into the polygon's base "
+                                                                 "rectangles, which is much faster on large covers")
+            ->ignore_case()
+            ->check(CLI::IsMember({"boolean", "graph"}));
+
     double timeout {0.0};
     app.add_option("-t,--timeout", timeout, "set a timeout in seconds per polygon");
 
+    size_t threads{1};
+    app.add_option("--threads", threads, "number of threads used to compute covers for the individual polygons of "
+                                         "the instance in parallel, each thread uses its own instance of the "
+                                         "algorithm, default is 1")
+            ->check(CLI::PositiveNumber);
+
+    size_t greedy_threads{1};
+    app.add_option("--greedy-threads", greedy_threads, "number of threads the eager greedy and the lagrangian "
+                                                       "algorithm use to update their candidates within a single "
+                                                       "polygon, the cover is the same for any number of threads, "
+                                                       "multiplies with --threads, default is 1")
+            ->check(CLI::PositiveNumber);
+
+    size_t greedy_candidates{4};
+    app.add_option("--greedy-candidates", greedy_candidates, "number of candidates the greedy-bounded algorithm keeps "
+                                                             "per top right corner besides the maximal rectangles and "
+                                                             "the base rectangle itself, default is 4")
+            ->check(CLI::PositiveNumber);
+
+    size_t exact_below{0};
+    app.add_option("--exact-below", exact_below, "cover polygons with at most this many base rectangles optimally by "
+                                                 "branch-and-bound instead of the chosen algorithm, which only runs on "
+                                                 "the larger polygons, at most 256, default is 0 (off)")
+            ->check(CLI::Range(0, static_cast<int>(Branch_and_bound_algorithm::MAX_BASE_RECTANGLES)));
+
+    size_t memory_budget_mib{0};
+    app.add_option("--memory-budget", memory_budget_mib, "memory budget per polygon in MiB, polygons whose "
+                                                         "decomposition and estimated candidates or model exceed it "
+                                                         "are covered by greedy-bounded, or by strip if that does "
+                                                         "not fit either, followed by the postprocessors, and are "
+                                                         "marked as degraded in the result, default is 0 (off)")
+            ->check(CLI::Range(size_t{0}, std::numeric_limits<size_t>::max() >> 20));
+
+    std::string decomposition_engine{"arrangement"};
+    app.add_option("--decomposition", decomposition_engine, "engine used to decompose polygons into rectangles, "
+                                                            "'arrangement' builds a CGAL arrangement, 'sweep' sweeps "
+                                                            "over the polygon's edges without one")
+            ->ignore_case()
+            ->check(CLI::IsMember({"arrangement", "sweep"}));
+
+    size_t decomposition_threads{1};
+    app.add_option("--decomposition-threads", decomposition_threads, "number of threads the ray shooting and the "
+                                                                     "parsing of the faces of a single large polygon "
+                                                                     "are spread over, multiplies with --threads, "
+                                                                     "default is 1")
+            ->check(CLI::PositiveNumber);
+
+    bool profile{false};
+    app.add_flag("--profile", profile, "record wall times and counters of the individual stages, such as the "
+                                       "decomposition, candidate enumeration and each postprocessor, and write "
+                                       "them to the \"profile\" entry of the result");
+
+    size_t repeat{1};
+    app.add_option("--repeat", repeat, "number of measured runs of the algorithm on each polygon, the reported "
+                                       "execution time is their median, their minimum and 95th percentile are "
+                                       "written to the \"timing\" entry of the result, default is 1")
+            ->check(CLI::PositiveNumber);
+
+    size_t warmup{0};
+    app.add_option("--warmup", warmup, "number of unmeasured runs of the algorithm on each polygon before the "
+                                       "measured ones, default is 0");
+
+    bool perf_counters{false};
+    app.add_flag("--perf-counters", perf_counters, "read the cycles, instructions and cache misses of each measured "
+                                                   "run from the hardware counters and write their average to the "
+                                                   "\"hardware_counters\" entry of the result, Linux only, not "
+                                                   "combined with threads within a polygon");
+
+    std::string cache_directory{};
+    app.add_option("--cache-dir", cache_directory, "directory in which the decomposition of each polygon into base "
+                                                   "rectangles is cached across runs, polygons found in the cache "
+                                                   "skip the decomposition, which is then not part of the "
+                                                   "measured execution time");
+
     std::string log_file{};
 #ifdef COVER_MAX_LOG_LEVEL
     app.add_option("-l,--log-file", log_file, "path to write logs to");
@@ -175,6 +299,39 @@ int main(int argc, char **argv) {
 
     CLI11_PARSE(app, argc, argv);
 
+    if (output_path.empty() && !serve) {
+        return app.exit(CLI::RequiredError("--output"));
+    }
+    if (!socket_path.empty() && !serve) {
+        return app.exit(CLI::ValidationError("--socket", "a socket is only used with --serve"));
+    }
+    // the counters only see the thread running a polygon, not the threads it hands work to
+    if (perf_counters && (greedy_threads > 1 || decomposition_threads > 1 || (tile_size > 0 && tile_threads > 1)
+                          || !portfolio_names.empty())) {
+        return app.exit(CLI::ValidationError("--perf-counters", "hardware counters are only read for polygons "
+                                                                "covered on a single thread"));
+    }
+
+    if (convert) {
+        if (polygon_wkt_path.empty() && generator_specification.empty()) {
+            return app.exit(CLI::RequiredError("--input or --generate"));
+        }
+        const auto multi_polygon{polygon_wkt_path.empty()
+                                 ? Polygon_generator::generate(Polygon_generator::parse(generator_specification))
+                                 : Instance_io::read(polygon_wkt_path)};
+        Instance_io::write_binary(multi_polygon, output_path);
+        std::cout << "Wrote " << multi_polygon.size() << " polygon(s) to " << output_path << std::endl;
+        return 0;
+    }
+
+    if (!serve && batch_path.empty() && ((polygon_wkt_path.empty() && generator_specification.empty()) ||
+                                         costs_option->count() == 0 || algorithm_name.empty())) {
+        return app.exit(CLI::RequiredError("--input or --generate, --costs and --algorithm"));
+    }
+    if (algorithm_name == "portfolio" && portfolio_names.empty()) {
+        return app.exit(CLI::RequiredError("--portfolio"));
+    }
+
 #ifdef COVER_MAX_LOG_LEVEL
     logging::add_common_attributes();
     if (!log_file.empty()) {
@@ -184,9 +341,10 @@ int main(int argc, char **argv) {
                 keywords::auto_flush = true,
                 keywords::format = "[%TimeStamp%] - [%Severity%]: %Message%"
         );
-        std::cout << "\nLog file: " << log_file << std::endl;
+        // with --serve, stdout carries the replies
+        (serve ? std::cerr : std::cout) << "\nLog file: " << log_file << std::endl;
     } else {
-        std::cout << "\nLog file: -\n";
+        (serve ? std::cerr : std::cout) << "\nLog file: -\n";
     }
 #else
     if (!log_file.empty()) {
@@ -195,39 +353,139 @@ int main(int argc, char **argv) {
     }
 #endif
 
-    std::cout << "Problem instance:\n\tInput WKT: " << polygon_wkt_path << "\n\tCreation cost: "
-              << costs.first << "\n\tArea cost: " << costs.second << std::endl;
+    Run_options run_options{};
+    run_options.timeout = timeout;
+    run_options.profiling = profile;
+    run_options.repetitions = repeat;
+    run_options.warmup_runs = warmup;
+    run_options.hardware_counters = perf_counters;
+    run_options.decomposition_threads = decomposition_threads;
+    run_options.decomposition_engine = decomposition_engine == "sweep" ? Decomposition_engine::SWEEP
+                                                                       : Decomposition_engine::ARRANGEMENT;
+    if (!cache_directory.empty()) {
+        run_options.decomposition_cache = std::make_shared<const Decomposition_cache>(cache_directory);
+    }
+
+    const size_t memory_budget{memory_budget_mib << 20};
+
+    const auto verification{verification_method == "graph"
+                            ? Algorithm_runner::Verification_method::BASE_RECTANGLE_GRAPH
+                            : Algorithm_runner::Verification_method::BOOLEAN_OPERATIONS};
+
+    if (serve) {
+        Cover_server server{[greedy_threads, greedy_candidates, exact_below, memory_budget](
+                const std::string &name, const std::vector<std::string> &postprocessors, double request_timeout) {
+            auto tokens = split(name);
+            std::vector<std::string> names(tokens.begin() + 1, tokens.end());
+            names.insert(names.end(), postprocessors.begin(), postprocessors.end());
+            return create_cover_provider(tokens[0], names, request_timeout, greedy_threads, greedy_candidates,
+                                         exact_below, memory_budget);
+        }, verify_cover, verification, serve_workers, cache_size, run_options,
+                Result_writer::Output_options::for_run(run_options, memory_budget)};
+        if (!socket_path.empty()) {
+            std::cerr << "Listening on " << socket_path << std::endl;
+            try {
+                server.serve_socket(socket_path);
+            } catch (const std::runtime_error &e) {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+        // the exit code only tells whether any request failed, the replies say which
+        return server.serve(std::cin, std::cout) > 0 ? 1 : 0;
+    }
+
+    if (!batch_path.empty()) {
+        std::cout << "Batch manifest: " << batch_path << "\nOutput path: " << output_path << std::endl;
+        const auto entries{Batch_runner::read_manifest(batch_path)};
+        Batch_runner batch_runner{[timeout, greedy_threads, greedy_candidates, exact_below, memory_budget](
+                const std::string &name, const std::vector<std::string> &postprocessors) {
+            auto tokens = split(name);
+            std::vector<std::string> names(tokens.begin() + 1, tokens.end());
+            names.insert(names.end(), postprocessors.begin(), postprocessors.end());
+            return create_cover_provider(tokens[0], names, timeout, greedy_threads, greedy_candidates,
+                                         exact_below, memory_budget);
+        }, verify_cover, verification, threads, run_options,
+                Result_writer::Output_options::for_run(run_options, memory_budget)};
+        try {
+            return batch_runner.run(entries, output_path);
+        } catch (const std::runtime_error &e) {
+            std::cerr << "ERROR: " << e.what() << std::endl;
+            return 1;
+        }
+    }
 
-    Problem_instance instance{polygon_wkt_path, costs.first, costs.second};
+    std::cout << "Problem instance:\n\t"
+              << (generator_specification.empty() ? "Input WKT: " + polygon_wkt_path
+                                                  : "Generated: " + generator_specification)
+              << "\n\tCreation cost: " << costs.first << "\n\tArea cost: " << costs.second << std::endl;
+
+    const auto instance{[&] {
+        if (generator_specification.empty()) {
+            return Problem_instance{polygon_wkt_path, costs.first, costs.second};
+        }
+        const auto parameters{Polygon_generator::parse(generator_specification)};
+        return Problem_instance{Polygon_generator::to_name(parameters), Polygon_generator::generate(parameters),
+                                costs.first, costs.second};
+    }()};
 
     auto  algorithm_tokens = split(algorithm_name);
     const auto &base_algorithm_name = algorithm_tokens[0];
 
-    std::unique_ptr<Algorithm> algorithm{string_to_algorithm(base_algorithm_name, timeout)};
     postprocessor_names.insert(postprocessor_names.begin(), algorithm_tokens.begin()+1, algorithm_tokens.end());
 
-    std::unique_ptr<Cover_postprocessor> current_postprocessor{nullptr};
     bool prune_used{false};
     for (const auto &postprocessor_name: postprocessor_names) {
         if (postprocessor_name == "trim"  && !prune_used) {
             std::cerr << "WARNING: 'trim' assumes there are no fully redundant rectangles in the cover, "
                          "if you are certain that there are no redundant rectangles, ignore this warning, "
                          "otherwise you may want to prune first";
-        } else if (postprocessor_name == "prune") {
+        } else if (postprocessor_name == "prune" || postprocessor_name == "prune-trim") {
             prune_used = true;
         }
-        if (current_postprocessor == nullptr) {
-            current_postprocessor = string_to_postprocessor(postprocessor_name, std::move(algorithm));
+    }
+
+    std::shared_ptr<const Incremental_cover_provider::Previous_cover> previous_cover{};
+    if (!previous_cover_path.empty()) {
+        previous_cover = std::make_shared<const Incremental_cover_provider::Previous_cover>(
+                Incremental_cover_provider::Previous_cover::read_csv(previous_cover_path));
+    }
+
+    const Algorithm_runner::Provider_factory provider_factory{[&]() -> std::unique_ptr<Cover_provider> {
+        const Algorithm_runner::Provider_factory tile_provider_factory{[&]() {
+            if (base_algorithm_name == "portfolio") {
+                return create_portfolio_provider(portfolio_names, postprocessor_names, timeout, greedy_threads,
+                                                 greedy_candidates, exact_below, memory_budget);
+            }
+            return create_cover_provider(base_algorithm_name, postprocessor_names, timeout, greedy_threads,
+                                         greedy_candidates, exact_below, memory_budget);
+        }};
+        std::unique_ptr<Cover_provider> provider{};
+        if (tile_size > 0) {
+            provider = std::make_unique<Tiled_cover_provider>(tile_provider_factory, tile_size, tile_threads);
         } else {
-            current_postprocessor = string_to_postprocessor(postprocessor_name, std::move(current_postprocessor));
+            provider = tile_provider_factory();
         }
-    }
+        if (previous_cover != nullptr) {
+            return std::make_unique<Incremental_cover_provider>(std::move(provider), previous_cover);
+        }
+        return provider;
+    }};
+    // created once up front, so invalid names are reported before any work starts
+    std::unique_ptr<Cover_provider> cover_provider{provider_factory()};
 
     std::cout << "\nUsing:\n\tAlgorithm: " << base_algorithm_name
         << "\n\tPostprocessors: ";
 
     std::stringstream ss;
     ss << base_algorithm_name;
+    if (base_algorithm_name == "portfolio") {
+        for (size_t i = 0; i < portfolio_names.size(); i++) {
+            ss << (i == 0 ? "(" : ",") << portfolio_names[i];
+        }
+        ss << ")";
+    }
     if (postprocessor_names.empty()) {
         std::cout << '-' << std::endl;
     } else {
@@ -241,21 +499,79 @@ int main(int argc, char **argv) {
     std::cout
         << "\n\tFull algorithm name: " << algorithm_full_name;
 
-    std::unique_ptr<Cover_provider> cover_provider{};
+    std::cout << "\nOutput path: " << output_path;
+    std::cout << "\nCover verification: " << (verify_cover ? "on (" + verification_method + ")" : "off");
+    std::cout << "\nThreads: " << threads;
+    std::cout << "\nGreedy threads: " << greedy_threads;
+    if (base_algorithm_name == "greedy-bounded") {
+        std::cout << "\nGreedy candidates: " << greedy_candidates;
+    }
+    if (exact_below > 0) {
+        std::cout << "\nExact below: " << exact_below << " base rectangles";
+    }
+    if (memory_budget > 0) {
+        std::cout << "\nMemory budget: " << memory_budget_mib << " MiB per polygon";
+    }
+    if (repeat > 1 || warmup > 0) {
+        std::cout << "\nRepetitions: " << repeat << " (" << warmup << " warmup)";
+    }
 
-    if (current_postprocessor != nullptr) {
-        cover_provider = std::move(current_postprocessor);
-    } else {
-        cover_provider = std::move(algorithm);
+    auto output_options{Result_writer::Output_options::for_run(run_options, memory_budget)};
+    output_options.input_polygon = geometry == "full";
+    output_options.cover = geometry != "none";
+    if (pipeline && threads > 1) {
+        return app.exit(CLI::ValidationError("--pipeline", "pipelining is only used with a single solver thread"));
+    }
+    if (stream && fs::path{output_path}.extension() == ".csv") {
+        return app.exit(CLI::ValidationError("--stream", "streamed results are written as JSON lines, not CSV"));
+    }
+    try {
+        Result_writer::check_csv_header(output_path, output_options);
+    } catch (const std::runtime_error &e) {
+        return app.exit(CLI::ValidationError("--output", e.what()));
     }
 
-    std::cout << "\nOutput path: " << output_path;
-    std::cout << "\nCover verification: " << (verify_cover ? "on" : "off");
+    std::ofstream stream_file{};
+    if (stream) {
+        Result_writer::create_parent_directories(output_path);
+        stream_file.open(output_path);
+    }
+    std::ofstream cover_csv_file{};
+    if (!cover_csv_path.empty()) {
+        Result_writer::create_parent_directories(cover_csv_path);
+        cover_csv_file.open(cover_csv_path);
+        Result_writer::write_cover_csv_header(cover_csv_file);
+    }
 
     const auto &exp_start = std::chrono::system_clock::now();
+    std::stringstream start;
+    start << exp_start;
+
+    // with --stream, every polygon is written and its cover released as soon as it's done
+    Algorithm_runner::Result_listener listener{};
+    if (stream) {
+        listener = [&](size_t polygon, Algorithm_runner::Result &result) {
+            std::stringstream now;
+            now << std::chrono::system_clock::now();
+            Result_writer::write_polygon_record(stream_file, instance, algorithm_full_name, polygon, result,
+                                                start.str(), now.str(), output_options);
+            if (cover_csv_file.is_open()) {
+                Result_writer::write_cover_csv(cover_csv_file, polygon, result.cover);
+            }
+            Algorithm_runner::Cover{}.swap(result.cover);
+        };
+    }
+
     std::cout << "\n\nStart creating cover at " << exp_start
         << "..." << std::endl;
-    const auto results{Algorithm_runner::run_algorithm(*cover_provider, instance, verify_cover)};
+    const auto results{threads > 1
+                       ? Algorithm_runner::run_algorithm(provider_factory, instance, verify_cover, threads, verification,
+                                                         run_options, nullptr, listener)
+                       : pipeline
+                       ? Algorithm_runner::run_pipelined(*cover_provider, instance, verify_cover, verification,
+                                                         run_options, listener)
+                       : Algorithm_runner::run_algorithm(*cover_provider, instance, verify_cover, verification,
+                                                         run_options, nullptr, listener)};
     const auto &exp_end = std::chrono::system_clock::now();
     std::cout << "Finished at " << exp_end << ".\n\nResults:" ;
 
@@ -271,7 +587,13 @@ int main(int argc, char **argv) {
             << (result.is_valid == Algorithm_runner::Result::Validity::VALID
                 ? "yes" : (result.is_valid == Algorithm_runner::Result::Validity::INVALID
                 ? "NO" : (result.is_valid == Algorithm_runner::Result::Validity::TIMEOUT
-                ? "TIMEOUT" : "not checked (specify -v to enable verification)")));
+                ? "TIMEOUT" : "not checked (specify -v to enable verification)")))
+            << "\n\tPeak memory: " << result.peak_memory_bytes / 1024 << " KiB";
+        if (!result.degraded_to.empty()) {
+            std::cout << "\n\tDegraded to: " << result.degraded_to << " (memory budget)";
+        } else if (result.degraded_polygons > 0) {
+            std::cout << "\n\tDegraded polygons: " << result.degraded_polygons << " (memory budget)";
+        }
     };
     int retval = 0;
     std::ostringstream warning_string{};
@@ -311,11 +633,22 @@ int main(int argc, char **argv) {
     std::cout << "\n\nTotal for all polygons in this instance:";
     printResult(results[0]);
 
-    std::cout << "\n\nWriting result to: " << output_path << std::endl;
-    std::stringstream start, end;
-    start << exp_start;
+    std::stringstream end;
     end << exp_end;
-    Result_writer::write_result(instance, results, algorithm_full_name, output_path, start.str(), end.str());
+    if (stream) {
+        Result_writer::write_polygon_record(stream_file, instance, algorithm_full_name, 0, results[0],
+                                            start.str(), end.str(), output_options);
+        std::cout << "\n\nResults were streamed to: " << output_path << std::endl;
+    } else {
+        std::cout << "\n\nWriting result to: " << output_path << std::endl;
+        Result_writer::write_result(instance, results, algorithm_full_name, output_path, start.str(), end.str(),
+                                    output_options);
+        if (cover_csv_file.is_open()) {
+            for (size_t i = 1; i < results.size(); i++) {
+                Result_writer::write_cover_csv(cover_csv_file, i, results[i].cover);
+            }
+        }
+    }
 
     return retval;
 }
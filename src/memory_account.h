@@ -0,0 +1,94 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MEMORY_ACCOUNT_H
+#define MEMORY_ACCOUNT_H
+
+#include <algorithm>
+#include <cstddef>
+
+namespace cover {
+    /**
+     * @brief Bytes held by the scratch structures of a single run which do not live in the Arena
+     *
+     * Algorithms add the size of the large structures they build, e.g. an ILP model or an incidence matrix, through
+     * a Charge, which gives the bytes back once the structure is gone. The peak over the run is reported together
+     * with the decomposition and the arena, see Algorithm_runner::Result::peak_memory_bytes. Sizes are those of the
+     * containers' buffers or estimates for memory held by external solvers, not the exact heap usage.
+     */
+    class Memory_account {
+    public:
+        /**
+         * @brief Bytes added to an account for the lifetime of a structure
+         */
+        class Charge {
+        public:
+            explicit Charge(Memory_account &account) : account(account) {}
+
+            ~Charge() { account.release(bytes); }
+
+            Charge(const Charge &) = delete;
+
+            Charge &operator=(const Charge &) = delete;
+
+            /**
+             * @param amount The bytes to add to the charge
+             */
+            void add(size_t amount) {
+                bytes += amount;
+                account.add(amount);
+            }
+
+        private:
+            Memory_account &account;
+            size_t bytes{0};
+        };
+
+        void add(size_t bytes) {
+            current += bytes;
+            peak = std::max(peak, current);
+        }
+
+        void release(size_t bytes) {
+            current -= std::min(current, bytes);
+        }
+
+        /**
+         * @return The largest number of bytes held at once since the last clear()
+         */
+        [[nodiscard]] size_t get_peak() const { return peak; }
+
+        void clear() {
+            current = 0;
+            peak = 0;
+        }
+
+    private:
+        size_t current{0};
+        size_t peak{0};
+    };
+}
+
+#endif //MEMORY_ACCOUNT_H
@@ -0,0 +1,73 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "memory_budget_algorithm.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "logging.h"
+#include "profile.h"
+
+namespace cover {
+    Memory_budget_algorithm::Memory_budget_algorithm(std::unique_ptr<Algorithm> algorithm, size_t budget,
+                                                     size_t greedy_candidates)
+            : algorithm(std::move(algorithm)),
+              bounded_greedy(true, 1, std::max<size_t>(1, greedy_candidates)),
+              budget(budget),
+              last(this->algorithm.get()) {
+        if (this->algorithm == nullptr) {
+            throw std::invalid_argument("The memory budget needs the algorithm it applies to");
+        }
+    }
+
+    std::vector<Rectangle> Memory_budget_algorithm::calculate_cover(
+            const Polygon_with_holes &polygon, const Problem_instance::Costs &costs,
+            Runtime_environment *env) {
+        env->ensure_decomposition(polygon);
+
+        last = algorithm.get();
+        {
+            PROFILE_SCOPE("memory_estimate");
+            const auto decomposition{env->decomposition_memory()};
+            if (decomposition + algorithm->estimate_memory(env->graph) > budget) {
+                if (decomposition + bounded_greedy.estimate_memory(env->graph) <= budget) {
+                    last = &bounded_greedy;
+                    env->degraded_to = "greedy-bounded";
+                } else {
+                    last = &strip;
+                    env->degraded_to = "strip";
+                }
+            }
+        }
+
+        if (last != algorithm.get()) {
+            LOG(warning) << "Polygon with " << env->graph.getNodes().size() << " base rectangles exceeds the "
+                         << "memory budget of " << budget << " bytes, covering it by " << env->degraded_to;
+            PROFILE_COUNT("degraded_polygons", 1);
+        }
+        return last->get_cover_for(polygon, costs, env);
+    }
+} // cover
@@ -0,0 +1,84 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MEMORY_BUDGET_ALGORITHM_H
+#define MEMORY_BUDGET_ALGORITHM_H
+
+#include <cstddef>
+#include <memory>
+
+#include "algorithm.h"
+#include "greedy_set_cover_algorithm.h"
+#include "strip_algorithm.h"
+
+namespace cover {
+
+    /**
+     * @brief Algorithm which falls back to cheaper algorithms on polygons whose estimated memory exceeds a budget
+     *
+     * Before the chosen algorithm runs on a polygon, the polygon is decomposed and the bytes of the decomposition
+     * plus the estimate of the algorithm, see Algorithm::estimate_memory(), are compared to the budget. If they
+     * exceed it, the polygon is covered by the greedy algorithm with a bounded number of candidates instead, whose
+     * memory is linear in the number of base rectangles, or by the strip algorithm if even that does not fit. The
+     * postprocessors still run on the cover. The replacement is recorded in the runtime environment, so results show
+     * which polygons were degraded, and a batch completes instead of running out of memory on its largest polygon.
+     */
+    class Memory_budget_algorithm : public Algorithm {
+    public:
+        /**
+         * @param algorithm The chosen algorithm, used on every polygon which fits into the budget
+         * @param budget The memory budget per polygon in bytes
+         * @param greedy_candidates The candidates per corner of the bounded greedy fallback, at least 1
+         */
+        Memory_budget_algorithm(std::unique_ptr<Algorithm> algorithm, size_t budget, size_t greedy_candidates);
+
+        [[nodiscard]] bool timeouted() const override { return last->timeouted(); }
+
+    protected:
+        /**
+         * Covers the polygon with the chosen algorithm if its estimate fits into the budget, otherwise with the
+         * first fallback which fits, or with the strip algorithm.
+         *
+         * @param polygon The polygon to cover
+         * @param costs The costs associated with the problem instance
+         * @return A cover of the polygon
+         */
+        [[nodiscard]] std::vector<Rectangle>
+        calculate_cover(const Polygon_with_holes &polygon,
+                        const Problem_instance::Costs &costs,
+                        Runtime_environment *env) override;
+
+    private:
+        std::unique_ptr<Algorithm> algorithm;
+        Greedy_set_cover_algorithm bounded_greedy;
+        Strip_algorithm strip{};
+        const size_t budget;
+        // the algorithm which covered the last polygon
+        Algorithm *last;
+    };
+
+} // cover
+
+#endif //MEMORY_BUDGET_ALGORITHM_H
@@ -24,6 +24,8 @@
  */
 
 #include "partition_algorithm.h"
+#include "bipartite_matching.h"
+#include "profile.h"
 
 namespace cover {
     const Direction Partition_algorithm::UP_DIRECTION = {0, 1};
@@ -164,101 +166,71 @@ namespace cover {
         return true;
     }
 
-    // SOURCE BEGIN
-    // Code was based on https://stackoverflow.com/q/23293992/6875882
-    // Retrieved on 27.11.2022
     std::vector<Segment>
     Partition_algorithm::determine_ideal_good_diagonal_set(
             const std::vector<std::pair<Segment, Segment>> &intersecting_good_diagonals,
             Set<Point> &handled_concave_vertices) {
-        LOG(debug) << "Determining ideal good diagonal set via bipartite intersection flow graph";
+        LOG(debug) << "Determining ideal good diagonal set via bipartite matching of intersecting diagonals";
 
         if (intersecting_good_diagonals.empty()) {
             LOG(debug) << "There are no intersecting good diagonals, all good diagonals can be used";
             return {};
         }
 
-        LOG(debug) << "Constructing flow graph";
+        LOG(debug) << "Numbering intersecting good diagonals";
 
-        FlowGraph flow_graph{};
-
-        const auto source{add_vertex(flow_graph)};
-        const auto sink{add_vertex(flow_graph)};
-
-        LOG(trace) << "Source node: " << source << ", sink node: " << sink;
-
-        Map<Segment, GraphVertex> segment_vertex_map{};
-        Map<GraphVertex, Segment> vertex_segment_map{};
-        std::vector<GraphEdge> reverse_edges{};
-        std::vector<float> capacities{};
+        using VertexId = Bipartite_matching::VertexId;
+        Map<Segment, VertexId> vertical_ids{};
+        Map<Segment, VertexId> horizontal_ids{};
+        std::vector<Segment> verticals{};
+        std::vector<Segment> horizontals{};
+        std::vector<std::pair<VertexId, VertexId>> edges{};
+        edges.reserve(intersecting_good_diagonals.size());
 
         for (const auto &[vertical, horizontal]: intersecting_good_diagonals) {
-            const auto vertical_vertex{get_or_create_vertex(flow_graph, vertical,
-                                                            segment_vertex_map, vertex_segment_map)};
-            const auto horizontal_vertex{get_or_create_vertex(flow_graph, horizontal,
-                                                              segment_vertex_map, vertex_segment_map)};
-
-            if (vertical_vertex.second) {
-                add_edge(flow_graph, source, vertical_vertex.first, 1, reverse_edges, capacities);
+            const auto [vertical_it, new_vertical]{
+                    vertical_ids.emplace(vertical, static_cast<VertexId>(verticals.size()))};
+            if (new_vertical) {
+                verticals.push_back(vertical);
             }
-
-            add_edge(flow_graph, vertical_vertex.first, horizontal_vertex.first, std::numeric_limits<float>::infinity(),
-                     reverse_edges, capacities);
-
-            if (horizontal_vertex.second) {
-                add_edge(flow_graph, horizontal_vertex.first, sink, 1, reverse_edges, capacities);
+            const auto [horizontal_it, new_horizontal]{
+                    horizontal_ids.emplace(horizontal, static_cast<VertexId>(horizontals.size()))};
+            if (new_horizontal) {
+                horizontals.push_back(horizontal);
             }
+            edges.emplace_back(vertical_it->second, horizontal_it->second);
         }
 
-        std::vector<float> residual_capacities(num_edges(flow_graph), 0);
+        LOG(debug) << "Calculating maximum matching";
+        Bipartite_matching matching{verticals.size(), horizontals.size(), edges};
+        const auto matching_size{matching.compute()};
+        LOG(debug) << "Matched " << matching_size << " pair(s) of intersecting good diagonals";
 
-        LOG(debug) << "Calculating maximum flow";
-        boykov_kolmogorov_max_flow(flow_graph,
-                                   make_iterator_property_map(&capacities[0], get(edge_index, flow_graph)),
-                                   make_iterator_property_map(&residual_capacities[0], get(edge_index, flow_graph)),
-                                   make_iterator_property_map(&reverse_edges[0], get(edge_index, flow_graph)),
-                                   get(boost::vertex_color, flow_graph),
-                                   get(boost::vertex_index, flow_graph),
-                                   source,
-                                   sink
-        );
+        std::vector<bool> vertical_picked{};
+        std::vector<bool> horizontal_picked{};
+        matching.maximum_independent_set(vertical_picked, horizontal_picked);
 
         LOG(debug) << "Determining ideal cuts";
         std::vector<Segment> ideal_cuts{};
 
-        auto source_out_edges{out_edges(source, flow_graph)};
-
-        for (auto it{source_out_edges.first}; it != source_out_edges.second; ++it) {
-            const auto target{boost::target(*it, flow_graph)};
-            const auto color{get(vertex_color, flow_graph, target)};
+        const auto pick = [&](const Segment &cut) {
+            ideal_cuts.push_back(cut);
 
-            // color indicates source/sink partition, see boost docs for details
-            if (color == boost::black_color) {
-                const auto cut{vertex_segment_map[target]};
-                LOG(trace) << "Cut " << cut << " is ideal vertical cut, adding to cut set";
-                ideal_cuts.push_back(cut);
+            LOG(trace) << "Adding " << cut.source() << " and " << cut.target()
+                       << " to set of handled concave vertices";
+            handled_concave_vertices.insert({cut.source(), cut.target()});
+        };
 
-                LOG(trace) << "Adding " << cut.source() << " and " << cut.target()
-                           << " to set of handled concave vertices";
-                handled_concave_vertices.insert({cut.source(), cut.target()});
+        for (size_t i = 0; i < verticals.size(); i++) {
+            if (vertical_picked[i]) {
+                LOG(trace) << "Cut " << verticals[i] << " is ideal vertical cut, adding to cut set";
+                pick(verticals[i]);
             }
         }
-
-        auto sink_in_edges{out_edges(sink, flow_graph)};
-
-        for (auto it{sink_in_edges.first}; it != sink_in_edges.second; ++it) {
-            const auto target{boost::target(*it, flow_graph)};
-            const auto color{get(vertex_color, flow_graph, target)};
-
-            // color indicates source/sink partition, see boost docs for details
-            if (color != boost::black_color) {
-                const auto cut{vertex_segment_map[target]};
-                LOG(trace) << "Cut " << cut << " is ideal horizontal cut, adding to cut set";
-                ideal_cuts.push_back(cut);
-
-                LOG(trace) << "Adding " << cut.source() << " and " << cut.target()
-                           << " to set of handled concave vertices";
-                handled_concave_vertices.insert({cut.source(), cut.target()});
+        for (size_t i = 0; i < horizontals.size(); i++) {
+            if (horizontal_picked[i]) {
+                LOG(trace) << "Cut " << horizontals[i] << " is ideal horizontal cut, adding to cut set";
+                pick(horizontals[i]);
             }
         }
 
@@ -267,46 +239,6 @@ namespace cover {
         return ideal_cuts;
     }
 
-    void Partition_algorithm::add_edge(FlowGraph &flow_graph, GraphVertex source, GraphVertex target, float capacity,
-                                       std::vector<GraphEdge> &reverse_edges,
-                                       std::vector<float> &capacities) {
-        const auto next_edge_id{num_edges(flow_graph)};
-
-        const auto edge{boost::add_edge(source, target, next_edge_id, flow_graph).first};
-        const auto reverse_edge{boost::add_edge(target, source, next_edge_id + 1, flow_graph).first};
-
-        LOG(trace) << "Adding edge " << edge << " from " << source << " to " << target
-                   << " with capacity " << capacity;
-
-        reverse_edges.push_back(reverse_edge);
-        reverse_edges.push_back(edge);
-        capacities.push_back(capacity);
-        capacities.push_back(0);
-    }
-    // SOURCE END
-
-    std::pair<Partition_algorithm::GraphVertex, bool> Partition_algorithm::get_or_create_vertex(
-            FlowGraph &flow_graph, const Segment &segment,
-            Map<Segment, GraphVertex> &segment_vertex_map,
-            Map<GraphVertex, Segment> &vertex_segment_map) {
-        const auto potential_existing{segment_vertex_map.find(segment)};
-
-        if (potential_existing != segment_vertex_map.end()) {
-            return {potential_existing->second, false};
-        }
-
-        const auto newly_created{boost::add_vertex(flow_graph)};
-        segment_vertex_map.insert({segment, newly_created});
-        vertex_segment_map.insert({newly_created, segment});
-
-        LOG(trace) << "Added new node: " << newly_created;
-
-        put(vertex_index, flow_graph, newly_created, num_vertices(flow_graph) - 1);
-        put(vertex_color, flow_graph, newly_created, boost::white_color);
-
-        return {newly_created, true};
-    }
-
     std::vector<std::pair<Segment, Segment>>
     Partition_algorithm::find_intersecting_good_diagonals(const std::vector<Segment> &good_diagonals) {
         LOG(debug) << "Determining intersecting good diagonals";
@@ -325,16 +257,20 @@ namespace cover {
         }
 
         LOG(trace) << "Intersecting horizontals and verticals";
-        std::vector<std::pair<Segment, Segment>> intersections{};
+        std::vector<std::pair<size_t, size_t>> intersecting_indices{};
+        Util::for_each_orthogonal_intersection(verticals, horizontals, [&](size_t vertical, size_t horizontal) {
+            intersecting_indices.emplace_back(vertical, horizontal);
+        });
 
-        for (const auto &vertical: verticals) {
-            for (const auto &horizontal: horizontals) {
-                if (CGAL::do_intersect(vertical, horizontal)) {
-                    LOG(trace) << "Vertical " << vertical << " and horizontal " << horizontal
-                               << "intersect, adding to intersection list";
-                    intersections.emplace_back(vertical, horizontal);
-                }
-            }
+        // reporting the pairs in the same order as testing every vertical against every horizontal
+        std::sort(intersecting_indices.begin(), intersecting_indices.end());
+
+        std::vector<std::pair<Segment, Segment>> intersections{};
+        intersections.reserve(intersecting_indices.size());
+        for (const auto &[vertical, horizontal]: intersecting_indices) {
+            LOG(trace) << "Vertical " << verticals[vertical] << " and horizontal " << horizontals[horizontal]
+                       << "intersect, adding to intersection list";
+            intersections.emplace_back(verticals[vertical], horizontals[horizontal]);
         }
 
         LOG(debug) << "Determined intersecting good diagonals";
@@ -342,7 +278,7 @@ namespace cover {
         return intersections;
     }
 
-    Segment Partition_algorithm::pick_cut(const Polygon_with_holes &polygon,
+    Segment Partition_algorithm::pick_cut(const Util::Edge_index &edge_index,
                                           const Util::ConcaveMapEntry &concave_entry,
                                           const std::vector<Segment> &previous_cuts,
                                           Set<Point> &handled_concave_vertices) {
@@ -358,22 +294,10 @@ namespace cover {
 
 				OrderedSet<Point> point_intersections{};
 
-        // intersecting ray with polygon's boundary
-        for (const auto &edge: polygon.outer_boundary().edges()) {
-            const auto result{Util::get_point_intersection(ray, edge)};
-            if (result.has_value()) {
-                point_intersections.insert(result.value());
-            }
-        }
-
-        // intersecting ray with holes
-        for (const auto &hole: polygon.holes()) {
-            for (const auto &edge: hole.edges()) {
-                const auto result{Util::get_point_intersection(ray, edge)};
-                if (result.has_value()) {
-                    point_intersections.insert(result.value());
-                }
-            }
+        // intersecting ray with the polygon's boundary and holes
+        const auto closest_edge_intersection{edge_index.get_closest_point_intersection(ray)};
+        if (closest_edge_intersection.has_value()) {
+            point_intersections.insert(closest_edge_intersection.value());
         }
 
         // intersecting ray with previous cuts
@@ -399,14 +323,16 @@ namespace cover {
     }
 
     std::vector<Rectangle> Partition_algorithm::determine_resulting_rectangles(const Polygon_with_holes &polygon,
-                                                                               const std::vector<Segment> &cuts) {
-        return Util::parse_rectangles(Util::create_arrangement(polygon, cuts), polygon);
+                                                                               const std::vector<Segment> &cuts,
+                                                                               Decomposition_engine engine) {
+        return Util::decompose(polygon, cuts, engine);
     }
 
     std::vector<Rectangle>
     Partition_algorithm::calculate_cover(const Polygon_with_holes &polygon,
                                          const Problem_instance::Costs &costs,
                                          Runtime_environment *env) {
+      PROFILE_SCOPE("partition");
       LOG(info) << "Partition_algorithm running";
 
       LOG(debug) << "Gathering concave vertices";
@@ -446,19 +372,20 @@ namespace cover {
       }
 
       LOG(debug) << "Picking arbitrary cuts for remaining concave vertices";
+      const Util::Edge_index edge_index{polygon};
       for (const auto &entry : concave_map) {
         const auto is_handled{handled_concave_vertices.count(entry.first) != 0};
 
         if (!is_handled) {
           const auto chosen_cut{
-              pick_cut(polygon, entry, cuts, handled_concave_vertices)};
+              pick_cut(edge_index, entry, cuts, handled_concave_vertices)};
           cuts.push_back(chosen_cut);
         }
       }
 
       LOG(debug) << "Used " << cuts.size() << " cuts";
 
-      auto partition{determine_resulting_rectangles(polygon, cuts)};
+      auto partition{determine_resulting_rectangles(polygon, cuts, env->options.decomposition_engine)};
 
       LOG(info) << "Partition_algorithm finished";
 
@@ -28,15 +28,6 @@
 
 #include <limits>
 
-#include <boost/graph/boykov_kolmogorov_max_flow.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/graph/adjacency_list.hpp>
-
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/graph_traits.hpp>
-#include <boost/property_map/property_map.hpp>
-#include <boost/graph/boykov_kolmogorov_max_flow.hpp>
-
 #include "logging.h"
 
 #include "CGAL_classes.h"
@@ -53,13 +44,6 @@ namespace cover {
      */
     class Partition_algorithm : public Algorithm {
     protected:
-        using FlowGraph = adjacency_list <vecS, hash_setS, directedS,
-        property<vertex_index_t, size_t, property<vertex_color_t, boost::default_color_type>>,
-        property <edge_index_t, size_t>>;
-
-        using GraphVertex = FlowGraph::vertex_descriptor;
-        using GraphEdge = FlowGraph::edge_descriptor;
-
         static const Direction UP_DIRECTION, RIGHT_DIRECTION, DOWN_DIRECTION, LEFT_DIRECTION;
 
         /**
@@ -126,6 +110,8 @@ namespace cover {
          * Finds good diagonals in the input vector which intersect at any point. Returns a vector containing pairs of
          * intersecting diagonals where the first element is a vertical diagonal and the second is horizontal.
          *
+         * The pairs are found by Util::for_each_orthogonal_intersection in O((V + H) log(V + H) + k).
+         *
          * @param good_diagonals The vector of good diagonals in the polygon
          * @return The vector of intersecting diagonals
          */
@@ -136,8 +122,8 @@ namespace cover {
          * Finds the set of good diagonals among a vector of intersecting good diagonals which contains the largest
          * number of good diagonals which do not intersect.
          *
-         * Uses a max-flow graph algorithm to find a maximum independent set in a bipartite graph formed by the
-         * intersecting good diagonals.
+         * The intersecting good diagonals form a bipartite graph between vertical and horizontal diagonals, a
+         * maximum independent set of it is derived from a maximum matching found by Hopcroft-Karp.
          *
          * @param intersecting_good_diagonals The vector of intersecting good diagonals
          * @param handled_concave_vertices The set of concave vertices which are the endpoint of a cut made by the
@@ -149,46 +135,19 @@ namespace cover {
         determine_ideal_good_diagonal_set(const std::vector<std::pair<Segment, Segment>> &intersecting_good_diagonals,
                                           Set<Point> &handled_concave_vertices);
 
-        /**
-         * Adds an edge to the flow graph used by determine_ideal_good_diagonal_set.
-         *
-         * @param flow_graph The flow graph to add the edge to
-         * @param source The source vertex of the edge
-         * @param target The target vertex of the edge
-         * @param capacity The capacity of the edge
-         * @param reverse_edges The vector of reverse edges of the flow graph (needed by the underlying graph algorithm)
-         * @param capacities The vector of capacities of the edges of the flow graph
-         */
-        static void add_edge(FlowGraph &flow_graph, GraphVertex source, GraphVertex target, float capacity,
-                             std::vector<FlowGraph::edge_descriptor> &reverse_edges, std::vector<float> &capacities);
-
-        /**
-         * First creates a vertex in the flow graph, if it does not exist yet, then returns it and indicates whether
-         * it was newly created or not.
-         *
-         * @param flow_graph The flow graph to add the vertex to
-         * @param segment The good diagonal the vertex represents
-         * @param segment_vertex_map A map mapping good diagonals in the polygon to vertices in the flow graph
-         * @param vertex_segment_map A map mapping vertices in the flow graph to good diagonals in the polygon
-         * @return A pair containing the vertex and a bool indicating whether it was newly created or not
-         */
-        static std::pair<GraphVertex, bool> get_or_create_vertex(FlowGraph &flow_graph, const Segment &segment,
-                                                Map<Segment, GraphVertex> &segment_vertex_map,
-                                                Map<GraphVertex, Segment> &vertex_segment_map);
-
         /**
          * Creates a segment with the concave vertex passed as one endpoint and the closest intersection with
          * a segment from the previous_cuts vector or any of the polygon's edges. Used to pick cuts for concave
          * vertices which are not yet handled by any good diagonal.
          *
-         * @param polygon The polygon associated with the problem instance
+         * @param edge_index The index over the edges of the polygon associated with the problem instance
          * @param concave_entry The concave vertex and the two directions opposite of the two edges it is a part of
          * @param previous_cuts The segments to check for intersection in addition to the polygon's edges
          * @param handled_concave_vertices The set of concave vertices which are the endpoint of some cut made by
          * the partition algorithm, this function adds the vertex it processed to this set
          * @return The picked segment
          */
-        static Segment pick_cut(const Polygon_with_holes &polygon, const Util::ConcaveMapEntry &concave_entry,
+        static Segment pick_cut(const Util::Edge_index &edge_index, const Util::ConcaveMapEntry &concave_entry,
                                 const std::vector<Segment> &previous_cuts,
                                 Set<Point> &handled_concave_vertices);
 
@@ -197,10 +156,12 @@ namespace cover {
          *
          * @param polygon The polygon containing the rectangles/cuts
          * @param cuts The cuts which form the rectangles
+         * @param engine The engine to decompose the polygon with
          * @return The set of rectangles implied by the cuts
          */
         static std::vector<Rectangle> determine_resulting_rectangles(const Polygon_with_holes &polygon,
-                                                                     const std::vector<Segment> &cuts);
+                                                                     const std::vector<Segment> &cuts,
+                                                                     Decomposition_engine engine);
 
         /**
          * Calculates an optimal (meaning it contains the fewest rectangles possible) partition of the polygon into
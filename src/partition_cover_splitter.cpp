@@ -36,6 +36,14 @@ std::vector<Rectangle> Partition_cover_splitter::split_rectangle(
   Partition_algorithm partition_algorithm{};
 
   for (const auto &polygon : polygon_split) {
+    // a rectangular region is its own minimal partition
+    if (polygon.outer_boundary().size() == 4 && !polygon.has_holes()) {
+      const auto bbox{polygon.bbox()};
+      partition_rectangles.emplace_back(bbox.xmin(), bbox.ymin(), bbox.xmax(),
+                                        bbox.ymax());
+      continue;
+    }
+
     const auto partitioned{
         partition_algorithm.get_cover_for(polygon, costs, env)};
     partition_rectangles.insert(partition_rectangles.end(), partitioned.begin(),
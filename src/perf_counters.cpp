@@ -0,0 +1,132 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "perf_counters.h"
+
+#include <mutex>
+
+#ifdef __linux__
+
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+#include "logging.h"
+
+namespace cover {
+    namespace {
+        // the counters are opened per polygon, so the reason they are unavailable is only logged once
+        std::once_flag unavailable_logged{};
+    }
+
+#ifdef __linux__
+    namespace {
+        int open_counter(uint64_t config, int group) {
+            perf_event_attr attr{};
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config;
+            attr.disabled = group < 0 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+    }
+
+    Perf_counters::Perf_counters(bool enabled) {
+        if (!enabled) {
+            return;
+        }
+        const std::array<uint64_t, 3> configs{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                              PERF_COUNT_HW_CACHE_MISSES};
+        for (size_t i = 0; i < configs.size(); i++) {
+            descriptors[i] = open_counter(configs[i], descriptors[0]);
+            if (descriptors[i] < 0) {
+                const auto error{errno};
+                std::call_once(unavailable_logged, [error]() {
+                    LOG(warning) << "Hardware counters are unavailable: " << std::strerror(error);
+                });
+                for (auto &descriptor: descriptors) {
+                    if (descriptor >= 0) {
+                        close(descriptor);
+                    }
+                    descriptor = -1;
+                }
+                return;
+            }
+        }
+    }
+
+    Perf_counters::~Perf_counters() {
+        for (const auto descriptor: descriptors) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+    }
+
+    void Perf_counters::start() {
+        if (available()) {
+            ioctl(descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    Perf_counters::Values Perf_counters::stop() {
+        if (!available()) {
+            return {};
+        }
+        ioctl(descriptors[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // the group is read as its number of counters followed by their values
+        std::array<uint64_t, 4> buffer{};
+        if (read(descriptors[0], buffer.data(), sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer))) {
+            return {};
+        }
+        return {buffer[1], buffer[2], buffer[3]};
+    }
+#else
+    Perf_counters::Perf_counters(bool enabled) {
+        if (enabled) {
+            std::call_once(unavailable_logged, []() {
+                LOG(warning) << "Hardware counters are only available on Linux";
+            });
+        }
+    }
+
+    Perf_counters::~Perf_counters() = default;
+
+    void Perf_counters::start() {}
+
+    Perf_counters::Values Perf_counters::stop() { return {}; }
+#endif
+}
@@ -0,0 +1,88 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+
+namespace cover {
+    /**
+     * @brief Hardware performance counters of the calling thread, read through perf_event_open
+     *
+     * Counts the cycles, instructions and cache misses between start() and stop(). The counters are only available
+     * on Linux and only if the kernel allows it, see /proc/sys/kernel/perf_event_paranoid, otherwise available()
+     * returns false and stop() returns zeros. The counters belong to the thread which created the object, so it has
+     * to be used on that thread only, and don't include other threads, such as those of a Worker_pool the
+     * algorithm hands work to.
+     */
+    class Perf_counters {
+    public:
+        struct Values {
+            uint64_t cycles{0};
+            uint64_t instructions{0};
+            uint64_t cache_misses{0};
+
+            Values &operator+=(const Values &other) {
+                cycles += other.cycles;
+                instructions += other.instructions;
+                cache_misses += other.cache_misses;
+                return *this;
+            }
+        };
+
+        /**
+         * @param enabled Whether to open the counters, if false the object does nothing
+         */
+        explicit Perf_counters(bool enabled);
+
+        ~Perf_counters();
+
+        Perf_counters(const Perf_counters &) = delete;
+
+        Perf_counters &operator=(const Perf_counters &) = delete;
+
+        [[nodiscard]] bool available() const { return descriptors[0] >= 0; }
+
+        /**
+         * Resets and starts the counters.
+         */
+        void start();
+
+        /**
+         * Stops the counters.
+         *
+         * @return The counts since the last start()
+         */
+        Values stop();
+
+    private:
+        // cycles, instructions and cache misses, the first one leads the group, -1 if not open
+        std::array<int, 3> descriptors{-1, -1, -1};
+    };
+}
+
+#endif //PERF_COUNTERS_H
@@ -0,0 +1,461 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "polygon_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace cover {
+
+    Polygon_generator::Parameters Polygon_generator::parse(const std::string &specification) {
+        Parameters parameters{};
+        const auto colon{specification.find(':')};
+        const auto shape{specification.substr(0, colon)};
+        if (shape == "orthogonal") {
+            parameters.shape = Shape::ORTHOGONAL;
+        } else if (shape == "staircase") {
+            parameters.shape = Shape::STAIRCASE;
+        } else if (shape == "comb") {
+            parameters.shape = Shape::COMB;
+        } else if (shape == "raster") {
+            parameters.shape = Shape::RASTER;
+        } else {
+            throw std::runtime_error("Unknown shape '" + shape + "' in generator specification '" + specification +
+                                     "', expected orthogonal, staircase, comb or raster");
+        }
+
+        if (colon == std::string::npos) {
+            return parameters;
+        }
+
+        std::stringstream assignments{specification.substr(colon + 1)};
+        std::string assignment{};
+        while (std::getline(assignments, assignment, ',')) {
+            const auto equals{assignment.find('=')};
+            if (equals == std::string::npos) {
+                throw std::runtime_error("Expected key=value in generator specification '" + specification +
+                                         "', got '" + assignment + "'");
+            }
+            const auto key{assignment.substr(0, equals)};
+            const auto value{assignment.substr(equals + 1)};
+            try {
+                if (key == "size") {
+                    parameters.size = std::stoul(value);
+                } else if (key == "holes") {
+                    parameters.holes = std::stoul(value);
+                } else if (key == "aspect") {
+                    parameters.aspect_ratio = std::stod(value);
+                } else if (key == "density") {
+                    parameters.density = std::stod(value);
+                } else if (key == "seed") {
+                    parameters.seed = static_cast<uint_fast32_t>(std::stoul(value));
+                } else {
+                    throw std::runtime_error("Unknown key '" + key + "' in generator specification '" +
+                                             specification + "', expected size, holes, aspect, density or seed");
+                }
+            } catch (const std::logic_error &) {
+                throw std::runtime_error("Invalid value '" + value + "' for key '" + key +
+                                         "' in generator specification '" + specification + "'");
+            }
+        }
+
+        if (parameters.size == 0) {
+            throw std::runtime_error("The size of a generated polygon must be positive");
+        }
+        if (!(parameters.aspect_ratio > 0)) {
+            throw std::runtime_error("The aspect ratio of a generated polygon must be positive");
+        }
+        if (!(parameters.density > 0 && parameters.density <= 1)) {
+            throw std::runtime_error("The density of a generated polygon must lie in (0, 1]");
+        }
+        return parameters;
+    }
+
+    std::string Polygon_generator::to_name(const Parameters &parameters) {
+        std::stringstream name{};
+        name << "generated_";
+        switch (parameters.shape) {
+            case Shape::ORTHOGONAL:
+                name << "orthogonal";
+                break;
+            case Shape::STAIRCASE:
+                name << "staircase";
+                break;
+            case Shape::COMB:
+                name << "comb";
+                break;
+            case Shape::RASTER:
+                name << "raster";
+                break;
+        }
+        name << "_size" << parameters.size << "_holes" << parameters.holes << "_aspect" << parameters.aspect_ratio
+             << "_density" << parameters.density << "_seed" << parameters.seed;
+        return name.str();
+    }
+
+    MultiPolygon Polygon_generator::generate(const Parameters &parameters) {
+        switch (parameters.shape) {
+            case Shape::ORTHOGONAL:
+                return {create_orthogonal_polygon(parameters.size, parameters.holes, parameters.aspect_ratio,
+                                                  parameters.seed)};
+            case Shape::STAIRCASE:
+                return {create_staircase_polygon(parameters.size, parameters.aspect_ratio)};
+            case Shape::COMB:
+                return {create_comb_polygon(parameters.size, parameters.holes, parameters.aspect_ratio,
+                                            parameters.seed)};
+            case Shape::RASTER:
+                return create_raster_polygons(parameters.size, parameters.size, parameters.density,
+                                              parameters.aspect_ratio, parameters.seed);
+        }
+        throw std::runtime_error("Unknown shape of generated polygon");
+    }
+
+    Polygon_with_holes Polygon_generator::create_orthogonal_polygon(size_t cells, size_t holes, double aspect_ratio,
+                                                                    uint_fast32_t seed) {
+        std::mt19937 generator{seed};
+        // random growth stays well within a circle of radius sqrt(cells), keeping one empty cell as a margin
+        const auto side{2 * static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(cells)))) + 3};
+        Raster raster{side, side};
+
+        std::vector<std::pair<size_t, size_t>> frontier{{side / 2, side / 2}};
+        size_t filled{0};
+        while (filled < cells && !frontier.empty()) {
+            const auto index{random_below(generator, frontier.size())};
+            const auto [x, y]{frontier[index]};
+            frontier[index] = frontier.back();
+            frontier.pop_back();
+            if (raster.at(x, y)) {
+                continue;
+            }
+            raster.set(x, y, true);
+            filled++;
+            for (const auto &[next_x, next_y]: {std::pair{x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}}) {
+                if (next_x > 0 && next_y > 0 && next_x < side - 1 && next_y < side - 1 && !raster.at(next_x, next_y)) {
+                    frontier.emplace_back(next_x, next_y);
+                }
+            }
+        }
+
+        // filling enclosed cells may create new pinches and removing pinches may enclose cells, so alternate both
+        bool changed{true};
+        while (changed) {
+            changed = false;
+            std::vector<bool> outside(side * side, false);
+            std::deque<std::pair<size_t, size_t>> queue{{0, 0}};
+            outside[0] = true;
+            while (!queue.empty()) {
+                const auto [x, y]{queue.front()};
+                queue.pop_front();
+                for (const auto &[next_x, next_y]: {std::pair{x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}}) {
+                    // unsigned wrap around makes coordinates left of or below the grid fail the bounds check
+                    if (next_x < side && next_y < side && !outside[next_y * side + next_x] &&
+                        !raster.at(next_x, next_y)) {
+                        outside[next_y * side + next_x] = true;
+                        queue.emplace_back(next_x, next_y);
+                    }
+                }
+            }
+            for (size_t y = 0; y < side; y++) {
+                for (size_t x = 0; x < side; x++) {
+                    if (!outside[y * side + x] && !raster.at(x, y)) {
+                        raster.set(x, y, true);
+                        changed = true;
+                    }
+                }
+            }
+            Raster before{raster};
+            remove_pinches(raster);
+            for (size_t y = 0; y < side && !changed; y++) {
+                for (size_t x = 0; x < side && !changed; x++) {
+                    changed = before.at(x, y) != raster.at(x, y);
+                }
+            }
+        }
+
+        // single cell holes whose 3x3 neighborhoods are filled neither touch each other nor the outer boundary
+        std::vector<std::pair<size_t, size_t>> hole_candidates{};
+        for (size_t y = 1; y + 1 < side; y++) {
+            for (size_t x = 1; x + 1 < side; x++) {
+                hole_candidates.emplace_back(x, y);
+            }
+        }
+        size_t punched{0};
+        while (punched < holes && !hole_candidates.empty()) {
+            const auto index{random_below(generator, hole_candidates.size())};
+            const auto [x, y]{hole_candidates[index]};
+            hole_candidates[index] = hole_candidates.back();
+            hole_candidates.pop_back();
+
+            bool surrounded{true};
+            for (size_t neighbor_y = y - 1; neighbor_y <= y + 1; neighbor_y++) {
+                for (size_t neighbor_x = x - 1; neighbor_x <= x + 1; neighbor_x++) {
+                    surrounded = surrounded && raster.at(neighbor_x, neighbor_y);
+                }
+            }
+            if (surrounded) {
+                raster.set(x, y, false);
+                punched++;
+            }
+        }
+
+        const auto [cell_width, cell_height]{cell_dimensions(aspect_ratio)};
+        auto polygons{trace(raster, cell_width, cell_height)};
+        if (polygons.size() != 1) {
+            throw std::runtime_error("Random growth produced " + std::to_string(polygons.size()) +
+                                     " polygons instead of one");
+        }
+        return polygons.front();
+    }
+
+    Polygon_with_holes Polygon_generator::create_staircase_polygon(size_t steps, double aspect_ratio) {
+        const auto [width, height]{cell_dimensions(aspect_ratio)};
+        const auto count{static_cast<NumType>(steps)};
+        Polygon outer{};
+        outer.push_back(Point(0, 0));
+        for (size_t step = 0; step < steps; step++) {
+            const auto x{(count - static_cast<NumType>(step)) * width};
+            outer.push_back(Point(x, static_cast<NumType>(step) * height));
+            outer.push_back(Point(x, static_cast<NumType>(step + 1) * height));
+        }
+        outer.push_back(Point(0, count * height));
+        return Polygon_with_holes{outer};
+    }
+
+    Polygon_with_holes Polygon_generator::create_comb_polygon(size_t teeth, size_t holes, double aspect_ratio,
+                                                              uint_fast32_t seed) {
+        std::mt19937 generator{seed};
+        const auto [width, height]{cell_dimensions(aspect_ratio)};
+        const auto point{[width = width, height = height](size_t x, size_t y) {
+            return Point(static_cast<NumType>(x) * width, static_cast<NumType>(y) * height);
+        }};
+
+        Polygon outer{};
+        outer.push_back(point(0, 0));
+        outer.push_back(point(2 * teeth + 1, 0));
+        outer.push_back(point(2 * teeth + 1, 4));
+        // walk the top side from right to left, going up and down every tooth
+        for (size_t tooth = teeth; tooth-- > 0;) {
+            const auto left{2 * tooth + 1};
+            const auto top{4 + 1 + random_below(generator, 8)};
+            outer.push_back(point(left + 1, 4));
+            outer.push_back(point(left + 1, top));
+            outer.push_back(point(left, top));
+            outer.push_back(point(left, 4));
+        }
+        outer.push_back(point(0, 4));
+
+        Polygon_with_holes polygon{outer};
+        const auto hole_count{std::min(holes, teeth / 2)};
+        for (size_t hole = 0; hole < hole_count; hole++) {
+            const auto left{4 * hole + 1};
+            Polygon square{};
+            square.push_back(point(left, 1));
+            square.push_back(point(left, 3));
+            square.push_back(point(left + 2, 3));
+            square.push_back(point(left + 2, 1));
+            polygon.add_hole(square);
+        }
+        return polygon;
+    }
+
+    MultiPolygon Polygon_generator::create_raster_polygons(size_t width, size_t height, double density,
+                                                           double aspect_ratio, uint_fast32_t seed) {
+        std::mt19937 generator{seed};
+        const auto threshold{static_cast<uint_fast64_t>(density * (static_cast<double>(std::mt19937::max()) + 1))};
+        Raster raster{width, height};
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                raster.set(x, y, generator() < threshold);
+            }
+        }
+
+        for (size_t round = 0; round < 2; round++) {
+            Raster smoothed{width, height};
+            for (size_t y = 0; y < height; y++) {
+                for (size_t x = 0; x < width; x++) {
+                    size_t neighbors{0};
+                    for (int_fast64_t dy = -1; dy <= 1; dy++) {
+                        for (int_fast64_t dx = -1; dx <= 1; dx++) {
+                            neighbors += raster.at(static_cast<int_fast64_t>(x) + dx,
+                                                   static_cast<int_fast64_t>(y) + dy);
+                        }
+                    }
+                    smoothed.set(x, y, neighbors >= 5);
+                }
+            }
+            raster = smoothed;
+        }
+        remove_pinches(raster);
+
+        const auto [cell_width, cell_height]{cell_dimensions(aspect_ratio)};
+        return trace(raster, cell_width, cell_height);
+    }
+
+    void Polygon_generator::remove_pinches(Raster &raster) {
+        bool changed{true};
+        while (changed) {
+            changed = false;
+            for (size_t y = 0; y + 1 < raster.height; y++) {
+                for (size_t x = 0; x + 1 < raster.width; x++) {
+                    const auto bottom_left{raster.at(x, y)};
+                    const auto bottom_right{raster.at(x + 1, y)};
+                    const auto top_left{raster.at(x, y + 1)};
+                    const auto top_right{raster.at(x + 1, y + 1)};
+                    if (bottom_left && top_right && !bottom_right && !top_left) {
+                        raster.set(x + 1, y, true);
+                        changed = true;
+                    } else if (bottom_right && top_left && !bottom_left && !top_right) {
+                        raster.set(x, y, true);
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+
+    MultiPolygon Polygon_generator::trace(const Raster &raster, NumType cell_width, NumType cell_height) {
+        constexpr auto NONE{std::numeric_limits<size_t>::max()};
+        const auto width{raster.width};
+        const auto height{raster.height};
+
+        // labeling the 4-connected components of filled cells, each of them becomes one polygon
+        std::vector<size_t> components(width * height, NONE);
+        size_t component_count{0};
+        for (size_t start = 0; start < width * height; start++) {
+            if (components[start] != NONE || !raster.at(start % width, start / width)) {
+                continue;
+            }
+            std::deque<size_t> queue{start};
+            components[start] = component_count;
+            while (!queue.empty()) {
+                const auto cell{queue.front()};
+                queue.pop_front();
+                const auto x{cell % width};
+                const auto y{cell / width};
+                for (const auto &[next_x, next_y]: {std::pair{x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}}) {
+                    // unsigned wrap around makes coordinates left of or below the grid fail the bounds check
+                    if (next_x < width && next_y < height && raster.at(next_x, next_y) &&
+                        components[next_y * width + next_x] == NONE) {
+                        components[next_y * width + next_x] = component_count;
+                        queue.push_back(next_y * width + next_x);
+                    }
+                }
+            }
+            component_count++;
+        }
+
+        // directed boundary edges with the filled cell on their left, without pinches every grid vertex has at most
+        // one outgoing edge
+        const auto vertex{[width](size_t x, size_t y) { return y * (width + 1) + x; }};
+        std::vector<size_t> next((width + 1) * (height + 1), NONE);
+        std::vector<size_t> edge_component((width + 1) * (height + 1), NONE);
+        const auto add_edge{[&](size_t from, size_t to, size_t component) {
+            next[from] = to;
+            edge_component[from] = component;
+        }};
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                if (!raster.at(x, y)) {
+                    continue;
+                }
+                const auto component{components[y * width + x]};
+                const auto signed_x{static_cast<int_fast64_t>(x)};
+                const auto signed_y{static_cast<int_fast64_t>(y)};
+                if (!raster.at(signed_x, signed_y - 1)) {
+                    add_edge(vertex(x, y), vertex(x + 1, y), component);
+                }
+                if (!raster.at(signed_x + 1, signed_y)) {
+                    add_edge(vertex(x + 1, y), vertex(x + 1, y + 1), component);
+                }
+                if (!raster.at(signed_x, signed_y + 1)) {
+                    add_edge(vertex(x + 1, y + 1), vertex(x, y + 1), component);
+                }
+                if (!raster.at(signed_x - 1, signed_y)) {
+                    add_edge(vertex(x, y + 1), vertex(x, y), component);
+                }
+            }
+        }
+
+        std::vector<std::optional<Polygon>> outer_boundaries(component_count);
+        std::vector<std::vector<Polygon>> holes(component_count);
+        for (size_t start = 0; start < next.size(); start++) {
+            if (next[start] == NONE) {
+                continue;
+            }
+            const auto component{edge_component[start]};
+            std::vector<size_t> ring{};
+            auto current{start};
+            do {
+                ring.push_back(current);
+                const auto following{next[current]};
+                next[current] = NONE;
+                current = following;
+            } while (current != start);
+
+            // only keeping the corners of the ring
+            Polygon polygon{};
+            for (size_t i = 0; i < ring.size(); i++) {
+                const auto previous{ring[(i + ring.size() - 1) % ring.size()]};
+                const auto following{ring[(i + 1) % ring.size()]};
+                const auto same_column{previous % (width + 1) == following % (width + 1)};
+                const auto same_row{previous / (width + 1) == following / (width + 1)};
+                if (!same_column && !same_row) {
+                    polygon.push_back(Point(static_cast<NumType>(ring[i] % (width + 1)) * cell_width,
+                                            static_cast<NumType>(ring[i] / (width + 1)) * cell_height));
+                }
+            }
+
+            if (polygon.is_counterclockwise_oriented()) {
+                outer_boundaries[component] = polygon;
+            } else {
+                holes[component].push_back(polygon);
+            }
+        }
+
+        MultiPolygon polygons{};
+        for (size_t component = 0; component < component_count; component++) {
+            polygons.emplace_back(*outer_boundaries[component], holes[component].begin(), holes[component].end());
+        }
+        return polygons;
+    }
+
+    size_t Polygon_generator::random_below(std::mt19937 &generator, size_t bound) {
+        return static_cast<size_t>((static_cast<uint_fast64_t>(generator()) * bound) >> 32);
+    }
+
+    std::pair<NumType, NumType> Polygon_generator::cell_dimensions(double aspect_ratio) {
+        if (aspect_ratio >= 1) {
+            return {std::round(aspect_ratio), 1};
+        }
+        return {1, std::round(1 / aspect_ratio)};
+    }
+
+} // cover
@@ -0,0 +1,204 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef POLYGON_GENERATOR_H
+#define POLYGON_GENERATOR_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CGAL_classes.h"
+
+namespace cover {
+
+    /**
+     * @brief Creates synthetic rectilinear polygons in memory for scaling studies
+     *
+     * All shapes are built on an integer grid, every grid cell being cell_width x cell_height units large, which
+     * allows stretching the shapes to a given aspect ratio while keeping integer coordinates. Outer boundaries are
+     * counterclockwise and holes clockwise, like the polygons read from WKT files. Random shapes only use the raw
+     * output of a seeded std::mt19937, so the same seed yields the same polygon with every standard library.
+     */
+    class Polygon_generator {
+    public:
+        enum class Shape {
+            ORTHOGONAL,
+            STAIRCASE,
+            COMB,
+            RASTER
+        };
+
+        /**
+         * The parameters describing a generated instance, the meaning of size and holes depends on the shape.
+         */
+        struct Parameters {
+            Shape shape{Shape::ORTHOGONAL};
+            // number of cells for ORTHOGONAL, steps for STAIRCASE, teeth for COMB, grid width and height for RASTER
+            size_t size{64};
+            // holes punched into ORTHOGONAL and COMB, ignored by STAIRCASE and RASTER
+            size_t holes{0};
+            // ratio of the width to the height of a grid cell, rounded to integer cell dimensions
+            double aspect_ratio{1.0};
+            // share of filled cells for RASTER
+            double density{0.6};
+            uint_fast32_t seed{42};
+        };
+
+        /**
+         * Parses a specification of the form shape[:key=value[,key=value]...] into parameters, shape being one of
+         * orthogonal, staircase, comb and raster and key being one of size, holes, aspect, density and seed, e.g.
+         * "raster:size=128,density=0.55,seed=7". Keys which are not given keep their default values.
+         *
+         * @param specification The specification to parse
+         * @return The parameters described by the specification
+         */
+        static Parameters parse(const std::string &specification);
+
+        /**
+         * Returns a name for the generated instance which identifies it uniquely, used in place of the name derived
+         * from a WKT file's path.
+         *
+         * @param parameters The parameters of the generated instance
+         * @return The name of the generated instance
+         */
+        static std::string to_name(const Parameters &parameters);
+
+        /**
+         * Generates the polygons described by the parameters.
+         *
+         * @param parameters The parameters of the instance to generate
+         * @return The generated polygons
+         */
+        static MultiPolygon generate(const Parameters &parameters);
+
+        /**
+         * Creates a simply connected polygon by growing a random set of cells from a single cell, every step adding
+         * a random empty cell next to the set, and then punching the given number of single cell holes into its
+         * interior where there is room for them. Empty cells enclosed by the growth are filled before that.
+         *
+         * @param cells The number of cells to grow
+         * @param holes The number of holes to punch
+         * @param aspect_ratio The ratio of a cell's width to its height
+         * @param seed The seed for growing the polygon and picking the holes
+         * @return The random orthogonal polygon
+         */
+        static Polygon_with_holes create_orthogonal_polygon(size_t cells, size_t holes, double aspect_ratio = 1.0,
+                                                            uint_fast32_t seed = 42);
+
+        /**
+         * Creates a staircase with the given number of steps descending from the top left to the bottom right. Each
+         * step adds a concave vertex and the number of maximal rectangles grows with every step, so this is a worst
+         * case for the algorithms enumerating rectangles.
+         *
+         * @param steps The number of steps
+         * @param aspect_ratio The ratio of a step's width to its height
+         * @return The staircase polygon
+         */
+        static Polygon_with_holes create_staircase_polygon(size_t steps, double aspect_ratio = 1.0);
+
+        /**
+         * Creates a comb shaped polygon: a base strip of height 4 with the given number of teeth of random height
+         * between 1 and 8 on top and up to teeth / 2 square holes punched into the base strip.
+         *
+         * The number of concave vertices and thereby base rectangles grows linearly with the number of teeth, the cuts
+         * split the base strip into columns, so the number of rectangles in the base rectangle graph grows with the
+         * square of the number of teeth.
+         *
+         * @param teeth The number of teeth on top of the base strip
+         * @param holes The number of holes in the base strip, capped at teeth / 2
+         * @param aspect_ratio The ratio of a cell's width to its height
+         * @param seed The seed for the tooth heights
+         * @return The comb polygon
+         */
+        static Polygon_with_holes create_comb_polygon(size_t teeth, size_t holes, double aspect_ratio = 1.0,
+                                                      uint_fast32_t seed = 42);
+
+        /**
+         * Creates blobs by filling the cells of a grid at random, smoothing the result with a few rounds of a
+         * majority vote between each cell and its neighbors and tracing the boundaries of the filled cells. The blobs
+         * have holes wherever empty cells are enclosed, and blobs may lie in the holes of other blobs.
+         *
+         * @param width The number of cells in x direction
+         * @param height The number of cells in y direction
+         * @param density The share of cells filled before smoothing
+         * @param aspect_ratio The ratio of a cell's width to its height
+         * @param seed The seed for filling the grid
+         * @return One polygon per blob
+         */
+        static MultiPolygon create_raster_polygons(size_t width, size_t height, double density,
+                                                   double aspect_ratio = 1.0, uint_fast32_t seed = 42);
+
+    private:
+        /**
+         * Grid of cells which are either filled or empty, cells outside the grid count as empty.
+         */
+        class Raster {
+        public:
+            Raster(size_t width, size_t height) : width(width), height(height), cells(width * height, false) {}
+
+            [[nodiscard]] bool at(int_fast64_t x, int_fast64_t y) const {
+                return x >= 0 && y >= 0 && x < static_cast<int_fast64_t>(width) &&
+                       y < static_cast<int_fast64_t>(height) && cells[y * width + x];
+            }
+
+            void set(size_t x, size_t y, bool filled) {
+                cells[y * width + x] = filled;
+            }
+
+            size_t width;
+            size_t height;
+
+        private:
+            std::vector<bool> cells;
+        };
+
+        /**
+         * Fills cells until no two filled cells touch only at a corner, which would make the traced boundaries
+         * non-simple.
+         */
+        static void remove_pinches(Raster &raster);
+
+        /**
+         * Traces the boundaries of the filled cells of the raster, which must not contain any pinches, returning one
+         * polygon per 4-connected component of filled cells, scaled by the cell dimensions.
+         */
+        static MultiPolygon trace(const Raster &raster, NumType cell_width, NumType cell_height);
+
+        /**
+         * Returns a uniformly distributed random number in [0, bound).
+         */
+        static size_t random_below(std::mt19937 &generator, size_t bound);
+
+        /**
+         * Returns the integer width and height of a cell for the given aspect ratio.
+         */
+        static std::pair<NumType, NumType> cell_dimensions(double aspect_ratio);
+    };
+
+} // cover
+
+#endif //POLYGON_GENERATOR_H
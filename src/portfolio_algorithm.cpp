@@ -0,0 +1,117 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "portfolio_algorithm.h"
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+#include "algorithm_runner.h"
+#include "profile.h"
+
+namespace cover {
+    Portfolio_algorithm::Portfolio_algorithm(std::vector<std::unique_ptr<Cover_provider>> members)
+            : members(std::move(members)) {
+        if (this->members.empty()) {
+            throw std::invalid_argument("A portfolio needs at least one member");
+        }
+    }
+
+    Cover_provider::Cover
+    Portfolio_algorithm::calculate_cover(const Polygon_with_holes &polygon,
+                                         const Problem_instance::Costs &costs,
+                                         Runtime_environment *env) {
+        if (pool == nullptr) {
+            pool = std::make_unique<Worker_pool>(members.size());
+        }
+        {
+            PROFILE_SCOPE("decomposition");
+            env->ensure_decomposition(polygon);
+        }
+
+        std::vector<Cover> covers(members.size());
+        std::vector<Runtime_environment> member_environments(members.size());
+        std::vector<Profile> member_profiles(members.size());
+        auto *profile{Profile::current()};
+        pool->run(members.size(), [&](size_t member, size_t worker) {
+            const Profile::Activation activation{profile != nullptr ? &member_profiles[member] : nullptr};
+            auto &member_environment{member_environments[member]};
+            member_environment.base_rectangles = env->base_rectangles;
+            member_environment.graph = env->graph;
+            member_environment.deadline = env->deadline;
+            member_environment.options = env->options;
+            covers[member] = members[member]->get_cover_for(polygon, costs, &member_environment);
+        });
+        if (profile != nullptr) {
+            for (const auto &member_profile: member_profiles) {
+                profile->merge(member_profile);
+            }
+        }
+        {
+            // the members ran at the same time, each holding a copy of the decomposition next to its own structures
+            size_t member_memory{0};
+            for (const auto &member_environment: member_environments) {
+                member_memory += member_environment.decomposition_memory() + member_environment.index_memory()
+                                 + member_environment.arena.used() + member_environment.memory.get_peak();
+            }
+            Memory_account::Charge charge{env->memory};
+            charge.add(member_memory);
+        }
+
+        // checked one after another, the checks share the graph of env
+        std::optional<size_t> best_valid{};
+        size_t best{0};
+        CostType best_valid_cost{std::numeric_limits<CostType>::max()};
+        CostType best_cost{std::numeric_limits<CostType>::max()};
+        for (size_t member = 0; member < members.size(); member++) {
+            const auto cost{Problem_instance::calculate_total_cost_of_cover(covers[member], costs)};
+            LOG(info) << "Portfolio member " << member << " found a cover of " << covers[member].size()
+                      << " rectangle(s) and cost " << cost;
+            if (cost < best_cost) {
+                best = member;
+                best_cost = cost;
+            }
+            if (cost < best_valid_cost && Algorithm_runner::is_valid_cover_graph(covers[member], polygon, *env)) {
+                best_valid = member;
+                best_valid_cost = cost;
+            }
+        }
+        if (!best_valid.has_value()) {
+            LOG(warning) << "No portfolio member found a valid cover, returning the cheapest one";
+        }
+        winner = best_valid.value_or(best);
+        LOG(info) << "Portfolio member " << winner << " wins";
+        if (member_environments[winner].deadline.reached()) {
+            env->deadline.report();
+        }
+        env->degraded_to = member_environments[winner].degraded_to;
+        return std::move(covers[winner]);
+    }
+
+    bool Portfolio_algorithm::timeouted() const {
+        return members[winner]->timeouted();
+    }
+} // cover
@@ -0,0 +1,80 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PORTFOLIO_ALGORITHM_H
+#define PORTFOLIO_ALGORITHM_H
+
+#include <memory>
+#include <vector>
+
+#include "algorithm.h"
+#include "worker_pool.h"
+
+namespace cover {
+
+    /**
+     * @brief Algorithm which runs several cover providers on the same polygon concurrently and keeps the cheapest
+     * valid cover
+     *
+     * The polygon is decomposed into base rectangles once, every member starts from a copy of the base rectangles and
+     * the base rectangle graph instead of decomposing the polygon again, and runs on its own thread. A deadline of the
+     * polygon applies to every member, so all of them stop by then with the valid cover they have. The memory the
+     * members held at the same time counts towards the peak of the polygon, and the result names the replacement the
+     * winner degraded to, if any.
+     */
+    class Portfolio_algorithm : public Algorithm {
+    public:
+        /**
+         * @param members The providers to run, ties in cost are won by the earlier one
+         */
+        explicit Portfolio_algorithm(std::vector<std::unique_ptr<Cover_provider>> members);
+
+        [[nodiscard]] bool timeouted() const override;
+
+    protected:
+        /**
+         * Runs all members on the polygon and returns the cheapest of their covers which passes
+         * Algorithm_runner::is_valid_cover_graph(), or the cheapest one if none is valid.
+         *
+         * @param polygon The polygon to cover
+         * @param costs The costs associated with the problem instance
+         * @param env The runtime environment, holds the shared decomposition afterwards
+         * @return The cheapest cover of the members
+         */
+        [[nodiscard]] Cover
+        calculate_cover(const Polygon_with_holes &polygon,
+                        const Problem_instance::Costs &costs,
+                        Runtime_environment *env) override;
+
+    private:
+        std::vector<std::unique_ptr<Cover_provider>> members;
+        // created on first use and reused for all polygons this instance covers, one worker per member
+        std::unique_ptr<Worker_pool> pool;
+        size_t winner{0};
+    };
+
+} // cover
+
+#endif //PORTFOLIO_ALGORITHM_H
@@ -0,0 +1,74 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "profile.h"
+
+namespace cover {
+    thread_local Profile *Profile::active{nullptr};
+
+    void Profile::add_time(const char *stage, nanos time) {
+        auto &entry{stages[stage]};
+        entry.time += time;
+        entry.calls++;
+    }
+
+    void Profile::add_count(const char *counter, uint64_t amount) {
+        counters[counter] += amount;
+    }
+
+    void Profile::merge(const Profile &other) {
+        for (const auto &[name, stage]: other.stages) {
+            auto &entry{stages[name]};
+            entry.time += stage.time;
+            entry.calls += stage.calls;
+        }
+        for (const auto &[name, amount]: other.counters) {
+            counters[name] += amount;
+        }
+    }
+
+    std::map<std::string, Profile::Stage> Profile::get_stages() const {
+        std::map<std::string, Stage> result{};
+        for (const auto &[name, stage]: stages) {
+            auto &entry{result[name]};
+            entry.time += stage.time;
+            entry.calls += stage.calls;
+        }
+        return result;
+    }
+
+    std::map<std::string, uint64_t> Profile::get_counters() const {
+        std::map<std::string, uint64_t> result{};
+        for (const auto &[name, amount]: counters) {
+            result[name] += amount;
+        }
+        return result;
+    }
+
+    void Profile::clear() {
+        stages.clear();
+        counters.clear();
+    }
+}
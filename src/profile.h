@@ -0,0 +1,178 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "datastructures.h"
+
+namespace cover {
+    /**
+     * @brief Registry of per-stage wall times, call counts and counters of a single run
+     *
+     * Profiling is scoped to a thread: a Profile is activated for the current thread via Profile::Activation and the
+     * PROFILE_SCOPE and PROFILE_COUNT macros record into the active profile. If no profile is active, both macros
+     * reduce to a check of a thread-local pointer, so instrumentation can stay in place when profiling is disabled.
+     * Nested scopes of the same stage are accounted for independently, so their times add up.
+     *
+     * Stages and counters are keyed by the address of their name, so recording doesn't allocate or compare strings,
+     * the names must therefore be string literals or otherwise outlive the profile. Names are only compared as
+     * strings by get_stages() and get_counters().
+     */
+    class Profile {
+    public:
+        using nanos = std::chrono::nanoseconds;
+
+        /**
+         * @brief Accumulated wall time and number of calls of a stage
+         */
+        struct Stage {
+            nanos time{0};
+            uint64_t calls{0};
+        };
+
+        /**
+         * Adds a call of the given stage which took the given time.
+         *
+         * @param stage The name of the stage
+         * @param time The wall time spent in the stage
+         */
+        void add_time(const char *stage, nanos time);
+
+        /**
+         * Adds the amount to the given counter.
+         *
+         * @param counter The name of the counter
+         * @param amount The amount to add
+         */
+        void add_count(const char *counter, uint64_t amount);
+
+        /**
+         * Adds all times, calls and counters of the other profile to this one.
+         *
+         * @param other The profile to add
+         */
+        void merge(const Profile &other);
+
+        void clear();
+
+        [[nodiscard]] bool empty() const { return stages.empty() && counters.empty(); }
+
+        /**
+         * @return The stages ordered by name, stages of equal name recorded under different addresses are combined
+         */
+        [[nodiscard]] std::map<std::string, Stage> get_stages() const;
+
+        /**
+         * @return The counters ordered by name, counters of equal name recorded under different addresses are
+         * combined
+         */
+        [[nodiscard]] std::map<std::string, uint64_t> get_counters() const;
+
+        /**
+         * @return The profile active for the current thread or nullptr if profiling is disabled
+         */
+        static Profile *current() { return active; }
+
+        /**
+         * @brief Activates a profile for the current thread during its lifetime
+         */
+        class Activation {
+        public:
+            /**
+             * @param profile The profile to activate, nullptr disables profiling for the lifetime of the activation
+             */
+            explicit Activation(Profile *profile) : previous(active) { active = profile; }
+
+            ~Activation() { active = previous; }
+
+            Activation(const Activation &) = delete;
+
+            Activation &operator=(const Activation &) = delete;
+
+        private:
+            Profile *const previous;
+        };
+
+        /**
+         * @brief Records the wall time between its construction and destruction as a call of a stage
+         */
+        class Scoped_timer {
+        public:
+            explicit Scoped_timer(const char *stage) : profile(active), stage(stage) {
+                if (profile != nullptr) {
+                    start = std::chrono::steady_clock::now();
+                }
+            }
+
+            ~Scoped_timer() {
+                if (profile != nullptr) {
+                    profile->add_time(stage, std::chrono::duration_cast<nanos>(
+                            std::chrono::steady_clock::now() - start));
+                }
+            }
+
+            Scoped_timer(const Scoped_timer &) = delete;
+
+            Scoped_timer &operator=(const Scoped_timer &) = delete;
+
+        private:
+            Profile *const profile;
+            const char *const stage;
+            std::chrono::steady_clock::time_point start{};
+        };
+
+    private:
+        static thread_local Profile *active;
+
+        Map<const char *, Stage> stages{};
+        Map<const char *, uint64_t> counters{};
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+/**
+ * Records the time until the end of the enclosing scope as a call of the given stage.
+ */
+#define PROFILE_SCOPE(stage) const ::cover::Profile::Scoped_timer PROFILE_CONCAT(profile_scope_, __LINE__){stage}
+
+/**
+ * Adds amount to the given counter of the active profile.
+ */
+#define PROFILE_COUNT(counter, amount)                                          \
+    do {                                                                        \
+        if (auto *profile_ = ::cover::Profile::current()) {                     \
+            profile_->add_count(counter, static_cast<uint64_t>(amount));        \
+        }                                                                       \
+    } while (false)
+
+#endif //PROFILE_H
@@ -26,106 +26,79 @@
 #include "rectangle.h"
 
 namespace cover {
-    Rectangle::Rectangle(const NumType &min_x, const NumType &min_y, const NumType &max_x, const NumType &max_y) {
+    Rectangle::Rectangle(const NumType &min_x, const NumType &min_y, const NumType &max_x, const NumType &max_y)
+            : min_x(to_coordinate(min_x)), min_y(to_coordinate(min_y)),
+              max_x(to_coordinate(max_x)), max_y(to_coordinate(max_y)) {
         if (min_x >= max_x || min_y >= max_y) {
             throw std::runtime_error("Rectangle has invalid min/max coordinates: " + std::to_string(min_x) + ' '
                                      + std::to_string(min_y) + ' ' + std::to_string(max_x) + ' ' +
                                      std::to_string(max_y));
         }
-
-        bottom_left = Point(min_x, min_y);
-        top_right = Point(max_x, max_y);
-
-        assert(bottom_left != top_right);
     }
 
-    Rectangle::Rectangle(const cover::Rectangle &other)
-            : Rectangle(other.bottom_left.x(), other.bottom_left.y(), other.top_right.x(), other.top_right.y()) {};
-
     Point Rectangle::get_bottom_right() const {
-        return {top_right.x(), bottom_left.y()};
+        return {get_max_x(), get_min_y()};
     }
 
     NumType Rectangle::width() const {
-        return top_right.x() - bottom_left.x();
+        return static_cast<NumType>(max_x - min_x);
     }
 
     NumType Rectangle::height() const {
-        return top_right.y() - bottom_left.y();
+        return static_cast<NumType>(max_y - min_y);
     }
 
     Point Rectangle::get_top_left() const {
-        return {bottom_left.x(), top_right.y()};
+        return {get_min_x(), get_max_y()};
     }
 
     void Rectangle::extend_down(const NumType &amount) {
-        bottom_left -= {0, amount};
+        min_y -= to_coordinate(amount);
     }
 
     void Rectangle::extend_left(const NumType &amount) {
-        bottom_left -= {amount, 0};
+        min_x -= to_coordinate(amount);
     }
 
     void Rectangle::extend_right(const NumType &amount) {
-        top_right += {amount, 0};
+        max_x += to_coordinate(amount);
     }
 
     void Rectangle::shrink_up(const NumType &amount) {
-        bottom_left += {0, amount};
+        min_y += to_coordinate(amount);
     }
 
     void Rectangle::shrink_down(const NumType &amount) {
-        top_right -= {0, amount};
+        max_y -= to_coordinate(amount);
     }
 
     void Rectangle::shrink_left(const NumType &amount) {
-        bottom_left += {amount, 0};
+        min_x += to_coordinate(amount);
     }
 
     void Rectangle::shrink_right(const NumType &amount) {
-        top_right -= {amount, 0};
+        max_x -= to_coordinate(amount);
     }
 
     Segment Rectangle::get_left_edge() const {
-        return {get_top_left(), bottom_left};
+        return {get_top_left(), get_bottom_left()};
     }
 
     Segment Rectangle::get_bottom_edge() const {
-        return {bottom_left, get_bottom_right()};
+        return {get_bottom_left(), get_bottom_right()};
     }
 
     Segment Rectangle::get_right_edge() const {
-        return {get_bottom_right(), top_right};
+        return {get_bottom_right(), get_top_right()};
     }
 
     Segment Rectangle::get_top_edge() const {
-        return {top_right, get_top_left()};
-    }
-
-    NumType Rectangle::get_min_x() const {
-        return bottom_left.x();
-    }
-
-    NumType Rectangle::get_min_y() const {
-        return bottom_left.y();
+        return {get_top_right(), get_top_left()};
     }
 
-    NumType Rectangle::get_max_x() const {
-        return top_right.x();
-    }
-
-    NumType Rectangle::get_max_y() const {
-        return top_right.y();
-    }
-
-    Rectangle::Rectangle(const Point &top_left) {
-        NumType left_x{top_left.x()}, right_x{left_x + 1};
-        NumType top_y{top_left.y()}, bottom_y{top_y - 1};
-
-        top_right = {right_x, top_y};
-        bottom_left = {left_x, bottom_y};
-
-        assert(top_right != bottom_left);
+    Rectangle::Rectangle(const Point &top_left)
+            : min_x(to_coordinate(top_left.x())), min_y(to_coordinate(top_left.y()) - 1),
+              max_x(to_coordinate(top_left.x()) + 1), max_y(to_coordinate(top_left.y())) {
     }
 
     Set<Point> Rectangle::get_covered_points() const {
@@ -143,23 +116,21 @@ namespace cover {
     Polygon Rectangle::as_polygon() const {
         Polygon polygon{};
 
-        assert(bottom_left != top_right);
-
-        polygon.push_back(bottom_left);
+        polygon.push_back(get_bottom_left());
         polygon.push_back(get_bottom_right());
-        polygon.push_back(top_right);
+        polygon.push_back(get_top_right());
         polygon.push_back(get_top_left());
 
         return polygon;
     }
 
     bool Rectangle::intersects(const Rectangle &other) const {
-        if (other.top_right.x() <= bottom_left.x() || top_right.x() <= other.bottom_left.x()) {
+        if (other.max_x <= min_x || max_x <= other.min_x) {
             // rectangles are horizontally disjoint
             return false;
         }
 
-        if (other.top_right.y() <= bottom_left.y() || top_right.y() <= other.bottom_left.y()) {
+        if (other.max_y <= min_y || max_y <= other.min_y) {
             // rectangles are vertically disjoint
             return false;
         }
@@ -26,6 +26,9 @@
 #ifndef COVERING_RECTANGLE_H
 #define COVERING_RECTANGLE_H
 
+#include <cassert>
+#include <tuple>
+
 #include <boost/functional/hash.hpp>
 
 #include "CGAL_classes.h"
@@ -35,13 +38,13 @@ namespace cover {
     /**
      * @brief A simple rectangle class
      *
-     * A simple rectangle wrapper around CGAL's Polygon_2 class. May look into wrapping/using CGAL::Iso_rectangle
-     * instead later.
+     * A simple axis-parallel rectangle storing its coordinates as Coordinate, so comparisons, hashing and area
+     * calculations don't go through CGAL. CGAL points and segments are only created when requested.
      */
     class Rectangle {
 
     protected:
-        Point bottom_left, top_right;
+        Coordinate min_x, min_y, max_x, max_y;
 
     public:
         /**
@@ -59,7 +62,9 @@ namespace cover {
          *
          * @param other The rectangle to copy
          */
-        Rectangle(const Rectangle &other);
+        Rectangle(const Rectangle &other) = default;
+
+        Rectangle &operator=(const Rectangle &other) = default;
 
         /**
          * Create a unit rectangle with the passed point as its top left corner.
@@ -76,7 +81,8 @@ namespace cover {
          * @param top_right The top right corner of the rectangle
          */
         Rectangle(const Point &bottom_left, const Point &top_right)
-            : bottom_left(bottom_left), top_right(top_right) { }
+            : min_x(to_coordinate(bottom_left.x())), min_y(to_coordinate(bottom_left.y())),
+              max_x(to_coordinate(top_right.x())), max_y(to_coordinate(top_right.y())) { }
 
         [[nodiscard]]
         NumType width() const;
@@ -136,12 +142,12 @@ namespace cover {
         /**
          * @return The bottom left vertex of the rectangle
          */
-        [[nodiscard]] Point get_bottom_left() const { return bottom_left; }
+        [[nodiscard]] Point get_bottom_left() const { return {get_min_x(), get_min_y()}; }
 
         /**
          * @return The top right vertex of the rectangle
          */
-        [[nodiscard]] Point get_top_right() const { return top_right; }
+        [[nodiscard]] Point get_top_right() const { return {get_max_x(), get_max_y()}; }
 
         /**
          * @return The bottom right vertex of the rectangle
@@ -176,28 +182,28 @@ namespace cover {
         /**
          * @return The y coordinate of the bottom edge of the rectangle
          */
-        [[nodiscard]] NumType get_min_y() const;
+        [[nodiscard]] NumType get_min_y() const { return static_cast<NumType>(min_y); }
 
         /**
          * @return The x coordinate of the left edge of the rectangle
          */
-        [[nodiscard]] NumType get_min_x() const;
+        [[nodiscard]] NumType get_min_x() const { return static_cast<NumType>(min_x); }
 
         /**
          * @return The y coordinate of the top edge of the rectangle
          */
-        [[nodiscard]] NumType get_max_y() const;
+        [[nodiscard]] NumType get_max_y() const { return static_cast<NumType>(max_y); }
 
         /**
          * @return The x coordinate of the right edge of the rectangle
          */
-        [[nodiscard]] NumType get_max_x() const;
+        [[nodiscard]] NumType get_max_x() const { return static_cast<NumType>(max_x); }
 
         /**
          * @return The area of the rectangle
          */
         [[nodiscard]] inline size_t area() const {
-            return (top_right.x() - bottom_left.x()) * (top_right.y() - bottom_left.y());
+            return static_cast<size_t>((max_x - min_x) * (max_y - min_y));
         }
 
         /**
@@ -217,8 +223,7 @@ namespace cover {
          * @return Whether this rectangle fully contains the other rectangle
          */
         [[nodiscard]] inline bool fully_contains(const Rectangle &other) const {
-            return bottom_left.x() <= other.bottom_left.x() && bottom_left.y() <= other.bottom_left.y() &&
-                   top_right.x() >= other.top_right.x() && top_right.y() >= other.top_right.y();
+            return min_x <= other.min_x && min_y <= other.min_y && max_x >= other.max_x && max_y >= other.max_y;
         }
 
         /**
@@ -245,22 +250,47 @@ namespace cover {
          * @return The combined rectangle
          */
         [[nodiscard]] Rectangle join(const Rectangle &other) const {
-          const auto min_x{std::min(get_min_x(), other.get_min_x())};
-          const auto min_y{std::min(get_min_y(), other.get_min_y())};
-          const auto max_x{std::max(get_max_x(), other.get_max_x())};
-          const auto max_y{std::max(get_max_y(), other.get_max_y())};
+          Rectangle joined{*this};
+          joined.min_x = std::min(min_x, other.min_x);
+          joined.min_y = std::min(min_y, other.min_y);
+          joined.max_x = std::max(max_x, other.max_x);
+          joined.max_y = std::max(max_y, other.max_y);
 
-          return {min_x, min_y, max_x, max_y};
+          return joined;
         }
 
         bool operator==(const Rectangle &other) const {
-            return top_right == other.top_right && bottom_left == other.bottom_left;
+            return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y;
         }
 
         bool operator<(const Rectangle &other) const {
-          return get_bottom_left() < other.get_bottom_left() ||
-                 get_bottom_left() == other.get_bottom_left() &&
-                     get_top_right() < other.get_top_right();
+          return std::tie(min_x, min_y, max_x, max_y) < std::tie(other.min_x, other.min_y, other.max_x, other.max_y);
+        }
+
+        /**
+         * Hashes the coordinates of the rectangle.
+         *
+         * @return The hash of the rectangle
+         */
+        [[nodiscard]] size_t hash() const {
+            size_t seed{0};
+            boost::hash_combine(seed, min_x);
+            boost::hash_combine(seed, min_y);
+            boost::hash_combine(seed, max_x);
+            boost::hash_combine(seed, max_y);
+            return seed;
+        }
+
+        /**
+         * Converts a coordinate of the polygon into the coordinate type of rectangles. The instance readers and the
+         * embedding API reject non-integer input in integer builds, so this only asserts it.
+         *
+         * @param value A coordinate of the polygon, an integer if Coordinate is an integer type
+         * @return The coordinate as Coordinate
+         */
+        static Coordinate to_coordinate(const NumType &value) {
+            assert(static_cast<NumType>(static_cast<Coordinate>(value)) == value);
+            return static_cast<Coordinate>(value);
         }
     };
 
@@ -270,10 +300,7 @@ namespace std {
     template<>
     struct hash<cover::Rectangle> {
         size_t operator()(const cover::Rectangle &rectangle) const {
-            size_t seed{0};
-            boost::hash_combine(seed, rectangle.get_bottom_right());
-            boost::hash_combine(seed, rectangle.get_top_left());
-            return seed;
+            return rectangle.hash();
         }
     };
 
@@ -24,10 +24,12 @@
  */
 
 #include "rectangle_enumerator.h"
+#include "profile.h"
 #include <algorithm>
 
 namespace cover {
-    void Rectangle_enumerator::pick_cuts(const Polygon_with_holes &polygon, const Util::ConcaveMapEntry &concave_entry,
+    void Rectangle_enumerator::pick_cuts(const Util::Edge_index &edge_index,
+                                         const Util::ConcaveMapEntry &concave_entry,
                                          std::vector<Segment> &cuts) {
         LOG(trace) << "Picking cuts for concave vertex " << concave_entry.first;
 
@@ -35,7 +37,7 @@ namespace cover {
         for (const auto &direction: concave_entry.second) {
             LOG(trace) << "Picking cut in direction " << direction;
             const Ray ray{concave_entry.first, direction};
-            const auto closest_intersection{Util::get_closest_intersection(ray, polygon)};
+            const auto closest_intersection{edge_index.get_closest_intersection(ray)};
 
             assert(closest_intersection.has_value());
 
@@ -45,7 +47,9 @@ namespace cover {
         }
     }
 
-    std::vector<Rectangle> Rectangle_enumerator::get_base_rectangles(const Polygon_with_holes &polygon) {
+    std::vector<Rectangle> Rectangle_enumerator::get_base_rectangles(const Polygon_with_holes &polygon,
+                                                                     Decomposition_engine engine, size_t threads) {
+        PROFILE_SCOPE("base_rectangles");
         LOG(debug) << "Generating base rectangles";
 
         assert(polygon.outer_boundary().size() > 4 || polygon.has_holes());
@@ -62,17 +66,39 @@ namespace cover {
         // making two cuts from every concave vertex in the polygon
         const auto concave_vertices{Util::find_concave_vertices(polygon)};
 
-        LOG(trace) << "Picking cuts";
         std::vector<Segment> cuts{};
-        for (const auto &entry: concave_vertices) {
-            pick_cuts(polygon, entry, cuts);
-            IF_LOG_LEVEL(debug) {
-                if (cuts.size() % 10000 == 0) {
-                    LOG(debug) << "Picked " << cuts.size() << " cuts";
+        {
+            PROFILE_SCOPE("ray_shooting");
+            LOG(trace) << "Building edge index";
+            const Util::Edge_index edge_index{polygon};
+
+            LOG(trace) << "Picking cuts";
+            // the rays of different vertices are independent, chunks of them are shot on the decomposition threads
+            std::vector<const Util::ConcaveMapEntry *> entries{};
+            entries.reserve(concave_vertices.size());
+            for (const auto &entry: concave_vertices) {
+                entries.push_back(&entry);
+            }
+            const auto chunks{Util::chunk_count(entries.size(), threads)};
+            std::vector<std::vector<Segment>> chunk_cuts(chunks);
+            Util::for_each_chunk(entries.size(), chunks, threads, [&](size_t begin, size_t end, size_t chunk) {
+                for (size_t i = begin; i < end; i++) {
+                    pick_cuts(edge_index, *entries[i], chunk_cuts[chunk]);
                 }
+            });
+
+            cuts.reserve(2 * entries.size());
+            for (const auto &chunk: chunk_cuts) {
+                cuts.insert(cuts.end(), chunk.begin(), chunk.end());
             }
+            LOG(debug) << "Picked " << cuts.size() << " cuts";
         }
-        return Util::parse_rectangles(Util::create_arrangement(polygon, cuts), polygon);
+        PROFILE_COUNT("concave_vertices", concave_vertices.size());
+        PROFILE_COUNT("cuts", cuts.size());
+
+        auto base_rectangles{Util::decompose(polygon, cuts, engine, threads)};
+        PROFILE_COUNT("base_rectangles", base_rectangles.size());
+        return base_rectangles;
     }
 
     Rectangle_enumerator::NeighborSideMap
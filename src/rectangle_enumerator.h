@@ -63,7 +63,7 @@ namespace cover {
          * @param concave_entry The concave to create the cuts from
          * @param cuts The vector to add the cuts to
          */
-        static void pick_cuts(const Polygon_with_holes &polygon, const Util::ConcaveMapEntry &concave_entry,
+        static void pick_cuts(const Util::Edge_index &edge_index, const Util::ConcaveMapEntry &concave_entry,
                               std::vector<Segment> &cuts);
 
         /**
@@ -117,9 +117,13 @@ namespace cover {
          * Returns a vector containing the base rectangles of the polygon.
          *
          * @param polygon The polygon to calculate the base rectangles of
+         * @param engine The engine to decompose the polygon with, see Run_options::decomposition_engine
+         * @param threads The number of threads large polygons are decomposed on, see Run_options::decomposition_threads
          * @return The vector of base rectangles contained in the polygon
          */
-        static std::vector<Rectangle> get_base_rectangles(const Polygon_with_holes &polygon);
+        static std::vector<Rectangle>
+        get_base_rectangles(const Polygon_with_holes &polygon,
+                            Decomposition_engine engine = Decomposition_engine::ARRANGEMENT, size_t threads = 1);
 
         /**
          * Returns a vector of all possible unions of base rectangles which are themselves rectangles.
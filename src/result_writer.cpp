@@ -25,7 +25,10 @@
 
 #include "result_writer.h"
 #include "algorithm_runner.h"
+#include <fstream>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 
 namespace cover {
     std::string Result_writer::multi_polygon_to_wkt_string(const MultiPolygon &multi_polygon) {
@@ -38,41 +41,66 @@ namespace cover {
         return wkt_stream.str();
     }
 
-    json Result_writer::result_to_json(const Problem_instance &instance,
-                                       const std::string &algorithm_full_name,
-                                       const std::vector<Algorithm_runner::Result> &results,
-                                       const std::string &startTime,
-                                       const std::string &endTime) {
-
-        MultiPolygon cover_multi_polygon{};
-
-        for (const auto &result : results) {
-            for (const auto &rectangle: result.cover) {
-                cover_multi_polygon.push_back(Polygon_with_holes(rectangle.as_polygon()));
-            }
+    json Result_writer::profile_to_json(const Profile &profile) {
+        json stages = json::object();
+        for (const auto &[name, stage]: profile.get_stages()) {
+            stages[name] = {
+                    {"time_nanoseconds", stage.time.count()},
+                    {"calls",            stage.calls},
+            };
         }
+        json counters = json::object();
+        for (const auto &[name, amount]: profile.get_counters()) {
+            counters[name] = amount;
+        }
+        return {{"stages", stages}, {"counters", counters}};
+    }
 
+    json Result_writer::costs_to_json(const Algorithm_runner::Result &result, const Output_options &options) {
         json output{
-                {"time_start",                  startTime},
-                {"time_end",                    endTime},
-                {"algorithm",                   algorithm_full_name},
-                {"instance_name",               instance.get_name()},
-                {"input_polygon",               multi_polygon_to_wkt_string(instance.get_multi_polygon())},
-                {"creation_cost",               instance.get_rectangle_creation_cost()},
-                {"area_cost",                   instance.get_rectangle_area_cost()},
-                {"cover",                       multi_polygon_to_wkt_string(cover_multi_polygon)},
-                {"cover_size",                  results[0].cover_size},
-                {"total_cost",                  results[0].cost.area_cost + results[0].cost.creation_cost},
-                {"total_creation_cost",         results[0].cost.creation_cost},
-                {"total_area_cost",             results[0].cost.area_cost},
+                {"cover_size",                  result.cover_size},
+                {"total_cost",                  result.cost.area_cost + result.cost.creation_cost},
+                {"total_creation_cost",         result.cost.creation_cost},
+                {"total_area_cost",             result.cost.area_cost},
                 {"execution_time_seconds",      std::chrono::duration_cast<std::chrono::seconds>(
-                        results[0].execution_time).count()},
+                        result.execution_time).count()},
                 {"execution_time_milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(
-                        results[0].execution_time).count()},
-                {"execution_time_nanoseconds",  results[0].execution_time.count()},
+                        result.execution_time).count()},
+                {"execution_time_nanoseconds",  result.execution_time.count()},
         };
+        if (options.profile) {
+            output["profile"] = profile_to_json(result.profile);
+        }
+        if (options.timing) {
+            output["timing"] = {
+                    {"repetitions",        result.timing.repetitions},
+                    {"median_nanoseconds", result.timing.median.count()},
+            };
+            // the total has no minimum and percentile
+            if (result.timing.min.has_value()) {
+                output["timing"]["min_nanoseconds"] = result.timing.min->count();
+            }
+            if (result.timing.p95.has_value()) {
+                output["timing"]["p95_nanoseconds"] = result.timing.p95->count();
+            }
+        }
+        if (result.counters.has_value()) {
+            output["hardware_counters"] = {
+                    {"cycles",       result.counters->cycles},
+                    {"instructions", result.counters->instructions},
+                    {"cache_misses", result.counters->cache_misses},
+            };
+        }
 
-        switch (results[0].is_valid) {
+        output["peak_memory_bytes"] = result.peak_memory_bytes;
+        if (options.degradation) {
+            output["degraded_polygons"] = result.degraded_polygons;
+        }
+        if (!result.degraded_to.empty()) {
+            output["degraded_to"] = result.degraded_to;
+        }
+
+        switch (result.is_valid) {
             case Algorithm_runner::Result::Validity::VALID:
                 output["is_valid"] = true;
                 break;
@@ -85,33 +113,42 @@ namespace cover {
             default:
                 output["is_valid"] = json::value_t::null;
         }
+
+        return output;
+    }
+
+    json Result_writer::result_to_json(const Problem_instance &instance,
+                                       const std::string &algorithm_full_name,
+                                       const std::vector<Algorithm_runner::Result> &results,
+                                       const std::string &startTime,
+                                       const std::string &endTime,
+                                       const Output_options &options) {
+
+        auto output{costs_to_json(results[0], options)};
+        output["time_start"] = startTime;
+        output["time_end"] = endTime;
+        output["algorithm"] = algorithm_full_name;
+        output["instance_name"] = instance.get_name();
+        output["creation_cost"] = instance.get_rectangle_creation_cost();
+        output["area_cost"] = instance.get_rectangle_area_cost();
+
+        if (options.input_polygon) {
+            output["input_polygon"] = multi_polygon_to_wkt_string(instance.get_multi_polygon());
+        }
+        if (options.cover) {
+            MultiPolygon cover_multi_polygon{};
+            for (const auto &result : results) {
+                for (const auto &rectangle: result.cover) {
+                    cover_multi_polygon.push_back(Polygon_with_holes(rectangle.as_polygon()));
+                }
+            }
+            output["cover"] = multi_polygon_to_wkt_string(cover_multi_polygon);
+        }
+
         output["polygon"] = json::array();
         for (size_t i = 1; i < results.size(); i++) {
-            output["polygon"][i-1] = {
-                {"polygon",                     i},
-                {"cover_size",                  results[i].cover_size},
-                {"total_cost",                  results[i].cost.area_cost + results[i].cost.creation_cost},
-                {"total_creation_cost",         results[i].cost.creation_cost},
-                {"total_area_cost",             results[i].cost.area_cost},
-                {"execution_time_seconds",      std::chrono::duration_cast<std::chrono::seconds>(
-                        results[i].execution_time).count()},
-                {"execution_time_milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(
-                        results[i].execution_time).count()},
-                {"execution_time_nanoseconds",  results[i].execution_time.count()},
-            };
-            switch (results[i].is_valid) {
-                case Algorithm_runner::Result::Validity::VALID:
-                    output["polygon"][i-1]["is_valid"] = true;
-                    break;
-                case Algorithm_runner::Result::Validity::INVALID:
-                    output["polygon"][i-1]["is_valid"] = false;
-                    break;
-                case Algorithm_runner::Result::Validity::TIMEOUT:
-                    output["polygon"][i-1]["is_valid"] = "timeout";
-                    break;
-                default:
-                    output["polygon"][i-1]["is_valid"] = json::value_t::null;
-            }
+            output["polygon"][i-1] = costs_to_json(results[i], options);
+            output["polygon"][i-1]["polygon"] = i;
         }
 
         return output;
@@ -121,7 +158,8 @@ namespace cover {
                                     const std::string &algorithm_full_name,
                                     const std::vector<Algorithm_runner::Result> &results,
                                     const std::string &startTime,
-                                    const std::string &endTime) {
+                                    const std::string &endTime,
+                                    const Output_options &options) {
 
         std::stringstream str;
         for (size_t i = 0; i < results.size(); i++) {
@@ -157,12 +195,49 @@ namespace cover {
                 default:
                     str << "null";
             }
+            if (options.profile) {
+                // the profile is a JSON object, quoted as a single CSV field
+                auto profile{profile_to_json(result.profile).dump()};
+                std::string quoted_profile{};
+                for (const auto c: profile) {
+                    quoted_profile += c;
+                    if (c == '"') {
+                        quoted_profile += '"';
+                    }
+                }
+                str << ",\"" << quoted_profile << "\"";
+            }
+            if (options.timing) {
+                // the minimum and percentile are left empty for the total
+                str << "," << result.timing.repetitions << ",";
+                if (result.timing.min.has_value()) {
+                    str << result.timing.min->count();
+                }
+                str << "," << result.timing.median.count() << ",";
+                if (result.timing.p95.has_value()) {
+                    str << result.timing.p95->count();
+                }
+            }
+            if (options.hardware_counters) {
+                // the counters are left empty if they were unavailable
+                if (result.counters.has_value()) {
+                    str << "," << result.counters->cycles
+                        << "," << result.counters->instructions
+                        << "," << result.counters->cache_misses;
+                } else {
+                    str << ",,,";
+                }
+            }
+            if (options.degradation) {
+                str << "," << result.peak_memory_bytes
+                    << "," << result.degraded_to;
+            }
             str << "\n";
         }
         return str;
     }
 
-    std::stringstream get_csv_header() {
+    std::stringstream get_csv_header(const Result_writer::Output_options &options) {
         std::stringstream str;
         str << "time_start,"
             << "time_end,"
@@ -179,7 +254,26 @@ namespace cover {
             << "execution_time_seconds,"
             << "execution_time_milliseconds,"
             << "execution_time_nanoseconds,"
-            << "valid\n";
+            << "valid";
+        if (options.profile) {
+            str << ",profile";
+        }
+        if (options.timing) {
+            str << ",repetitions"
+                << ",time_min_nanoseconds"
+                << ",time_median_nanoseconds"
+                << ",time_p95_nanoseconds";
+        }
+        if (options.hardware_counters) {
+            str << ",cycles"
+                << ",instructions"
+                << ",cache_misses";
+        }
+        if (options.degradation) {
+            str << ",peak_memory_bytes"
+                << ",degraded_to";
+        }
+        str << "\n";
         return str;
     }
 
@@ -187,29 +281,142 @@ namespace cover {
                                      const std::vector<Algorithm_runner::Result> &results,
                                      const std::string &algorithm_full_name,
                                      const fs::path &output_path,
-                                    const std::string &startTime,
-                                    const std::string &endTime) {
+                                     const std::string &startTime,
+                                     const std::string &endTime,
+                                     const Output_options &options) {
 
-        auto parent_path{output_path.parent_path()};
-        if (!parent_path.empty() && !fs::exists(parent_path)) {
-            fs::create_directories(parent_path);
-        }
+        create_parent_directories(output_path);
         if (output_path.extension() == ".csv") {
             if (!fs::exists(output_path)) {
                 std::ofstream out_file{output_path};
-                out_file << get_csv_header().rdbuf();
+                out_file << get_csv_header(options).rdbuf();
                 out_file << result_to_csv(instance, algorithm_full_name,
-                                        results,startTime, endTime).rdbuf();
+                                        results,startTime, endTime, options).rdbuf();
             } else {
                 std::ofstream out_file{output_path, std::ios_base::app};
                 out_file << result_to_csv(instance, algorithm_full_name,
-                                        results, startTime, endTime).rdbuf();
+                                        results, startTime, endTime, options).rdbuf();
 
             }
         } else {
             std::ofstream out_file{output_path};
             out_file << result_to_json(instance, algorithm_full_name,
-                                        results, startTime, endTime);
+                                        results, startTime, endTime, options);
+        }
+    }
+
+    void Result_writer::write_record(std::ostream &out,
+                                     const Problem_instance &instance,
+                                     const std::vector<Algorithm_runner::Result> &results,
+                                     const std::string &algorithm_full_name,
+                                     const std::string &startTime,
+                                     const std::string &endTime,
+                                     bool csv,
+                                     const Output_options &options) {
+        if (csv) {
+            out << result_to_csv(instance, algorithm_full_name, results, startTime, endTime, options).rdbuf();
+        } else {
+            out << result_to_json(instance, algorithm_full_name, results, startTime, endTime, options).dump() << '\n';
+        }
+        out.flush();
+    }
+
+    void Result_writer::write_polygon_record(std::ostream &out,
+                                             const Problem_instance &instance,
+                                             const std::string &algorithm_full_name,
+                                             size_t polygon,
+                                             const Algorithm_runner::Result &result,
+                                             const std::string &startTime,
+                                             const std::string &endTime,
+                                             const Output_options &options) {
+        auto output{costs_to_json(result, options)};
+        output["polygon"] = polygon;
+        output["time_start"] = startTime;
+        output["time_end"] = endTime;
+        output["algorithm"] = algorithm_full_name;
+        output["instance_name"] = instance.get_name();
+        output["creation_cost"] = instance.get_rectangle_creation_cost();
+        output["area_cost"] = instance.get_rectangle_area_cost();
+
+        if (polygon == 0 && options.input_polygon) {
+            output["input_polygon"] = multi_polygon_to_wkt_string(instance.get_multi_polygon());
+        }
+        if (polygon != 0 && options.cover) {
+            MultiPolygon cover_multi_polygon{};
+            for (const auto &rectangle: result.cover) {
+                cover_multi_polygon.push_back(Polygon_with_holes(rectangle.as_polygon()));
+            }
+            output["cover"] = multi_polygon_to_wkt_string(cover_multi_polygon);
+        }
+
+        out << output.dump() << '\n';
+        out.flush();
+    }
+
+    json Result_writer::reply_to_json(const Problem_instance &instance,
+                                      const std::string &algorithm_full_name,
+                                      const std::vector<Algorithm_runner::Result> &results,
+                                      bool include_cover,
+                                      const Output_options &options) {
+        auto output{costs_to_json(results[0], options)};
+        output["algorithm"] = algorithm_full_name;
+        output["instance_name"] = instance.get_name();
+        output["creation_cost"] = instance.get_rectangle_creation_cost();
+        output["area_cost"] = instance.get_rectangle_area_cost();
+        output["polygon_count"] = results.size() - 1;
+
+        if (include_cover) {
+            output["cover"] = json::array();
+            for (size_t i = 1; i < results.size(); i++) {
+                auto rectangles{json::array()};
+                for (const auto &rectangle: results[i].cover) {
+                    rectangles.push_back({rectangle.get_min_x(), rectangle.get_min_y(),
+                                          rectangle.get_max_x(), rectangle.get_max_y()});
+                }
+                output["cover"].push_back(std::move(rectangles));
+            }
+        }
+
+        return output;
+    }
+
+    void Result_writer::write_cover_csv_header(std::ostream &out) {
+        out << "polygon,min_x,min_y,max_x,max_y\n";
+    }
+
+    void Result_writer::write_cover_csv(std::ostream &out, size_t polygon, const Algorithm_runner::Cover &cover) {
+        // enough digits to read the coordinates back exactly, e.g. as previous cover of an incremental run
+        const auto precision{out.precision(std::numeric_limits<NumType>::max_digits10)};
+        for (const auto &rectangle: cover) {
+            out << polygon << ',' << rectangle.get_min_x() << ',' << rectangle.get_min_y() << ','
+                << rectangle.get_max_x() << ',' << rectangle.get_max_y() << '\n';
+        }
+        out.precision(precision);
+    }
+
+    void Result_writer::create_parent_directories(const fs::path &output_path) {
+        auto parent_path{output_path.parent_path()};
+        if (!parent_path.empty() && !fs::exists(parent_path)) {
+            fs::create_directories(parent_path);
+        }
+    }
+
+    void Result_writer::write_csv_header(std::ostream &out, const Output_options &options) {
+        out << get_csv_header(options).rdbuf();
+    }
+
+    void Result_writer::check_csv_header(const fs::path &output_path, const Output_options &options) {
+        if (output_path.extension() != ".csv" || !fs::exists(output_path)) {
+            return;
+        }
+        std::ifstream in{output_path};
+        std::string header{};
+        std::getline(in, header);
+        auto expected{get_csv_header(options).str()};
+        expected.pop_back();
+        if (header != expected) {
+            throw std::runtime_error("CSV file '" + output_path.string() + "' has other columns than the results of "
+                                     "this run, which can't be appended to it");
         }
     }
 
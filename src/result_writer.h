@@ -50,6 +50,35 @@ namespace cover {
      * @brief Class which writes results of the algorithms to the filesystem in a JSON format
      */
     class Result_writer {
+    public:
+        /**
+         * Which geometry is embedded in JSON results as WKT and which measurements are written. Both geometries are
+         * on by default, for big instances turning them off keeps the output small and fast to write, the cover can
+         * be written to a CSV file instead, see write_cover_csv(). The profile and the timing statistics are only
+         * meaningful if the run profiled or repeated the algorithm, and the number of degraded polygons only if a
+         * memory budget was set, see Memory_budget_algorithm, so they are off by default, in CSV files the profile
+         * and timing columns are left out as well. The same goes for the columns of the hardware counters, which
+         * JSON results only contain if they were read, and for the peak memory and degradation columns.
+         */
+        struct Output_options {
+            bool input_polygon{true};
+            bool cover{true};
+            bool profile{false};
+            bool timing{false};
+            bool degradation{false};
+            bool hardware_counters{false};
+
+            /**
+             * @param run_options The options of the run whose results are written
+             * @param memory_budget The memory budget per polygon of the run in bytes, 0 if there is none
+             * @return Options with both geometries and the measurements the run took
+             */
+            static Output_options for_run(const Run_options &run_options, size_t memory_budget) {
+                return {true, true, run_options.profiling, run_options.repetitions > 1 || run_options.warmup_runs > 0,
+                        memory_budget > 0, run_options.hardware_counters};
+            }
+        };
+
     protected:
         /**
          * Converts the provided deque of polygons into a WKT string.
@@ -59,6 +88,26 @@ namespace cover {
          */
         static std::string multi_polygon_to_wkt_string(const MultiPolygon &multi_polygon);
 
+        /**
+         * Converts the profile of a result into a JSON object with the keys "stages", mapping each stage to its
+         * wall time in nanoseconds and its number of calls, and "counters".
+         *
+         * @param profile The profile to convert
+         * @return The profile as JSON object
+         */
+        static json profile_to_json(const Profile &profile);
+
+        /**
+         * Converts the costs, cover size, execution times and their statistics, validity, profile and hardware
+         * counters of a single result into a JSON object, these fields are shared by the total and the per-polygon
+         * entries.
+         *
+         * @param result The result to convert
+         * @param options Whether to include the profile, the timing statistics and the number of degraded polygons
+         * @return The result as JSON object
+         */
+        static json costs_to_json(const Algorithm_runner::Result &result, const Output_options &options);
+
         /**
          * Combines and converts the problem instance, algorithm name, postprocessor names and algorithm result into
          * a JSON object.
@@ -67,13 +116,15 @@ namespace cover {
          * @param algorithm_name The name of the used algorithm
          * @param postprocessor_names The names of the postprocessors in order of their application
          * @param results The results of running the algorithm on the problem instance, one result per polygon
+         * @param options The geometry to include
          * @return The combined JSON object
          */
         static json result_to_json(const Problem_instance &instance,
                                    const std::string &algorithm_full_name,
                                    const std::vector<Algorithm_runner::Result> &results,
                                    const std::string &startTime,
-                                   const std::string &endTime);
+                                   const std::string &endTime,
+                                   const Output_options &options);
 
         /**
          * Combines and converts the problem instance, algorithm name, postprocessor names and algorithm result into
@@ -83,13 +134,15 @@ namespace cover {
          * @param algorithm_name The name of the used algorithm
          * @param postprocessor_names The names of the postprocessors in order of their application
          * @param results The results of running the algorithm on the problem instance, one result per polygon
+         * @param options Whether to include the profile and the timing statistics
          * @return One line per polygon in CSV format
          */
         static std::stringstream result_to_csv(const Problem_instance &instance,
                                    const std::string &algorithm_full_name,
                                    const std::vector<Algorithm_runner::Result> &results,
                                    const std::string &startTime,
-                                   const std::string &endTime);
+                                   const std::string &endTime,
+                                   const Output_options &options);
 
     public:
         /**
@@ -101,13 +154,118 @@ namespace cover {
          * @param algorithm_name The name of the used algorithm
          * @param postprocessor_names The names of the postprocessors in order of their application
          * @param output_path The path to output the JSON file at
+         * @param options The geometry to include in JSON files and the measurements to include
          */
         static void write_result(const Problem_instance &instance,
                                  const std::vector<Algorithm_runner::Result> &results,
                                  const std::string &algorithm_full_name,
                                  const fs::path &output_path,
                                  const std::string &startTime,
-                                 const std::string &endTime);
+                                 const std::string &endTime,
+                                 const Output_options &options = {});
+
+        /**
+         * Writes the results of a single run as one record to the stream, either as a single line of JSON or as
+         * one CSV line per polygon, this way the results of many runs can be streamed into the same file.
+         *
+         * @param out The stream to write the record to
+         * @param instance The problem instance the algorithm was run on
+         * @param results The results of running the algorithm on the problem instance, one result per polygon
+         * @param algorithm_full_name The name of the used algorithm including its postprocessors
+         * @param csv Whether to write CSV lines instead of a JSON line
+         * @param options The geometry to include in JSON lines and the measurements to include
+         */
+        static void write_record(std::ostream &out,
+                                 const Problem_instance &instance,
+                                 const std::vector<Algorithm_runner::Result> &results,
+                                 const std::string &algorithm_full_name,
+                                 const std::string &startTime,
+                                 const std::string &endTime,
+                                 bool csv,
+                                 const Output_options &options = {});
+
+        /**
+         * Writes the result of a single polygon as one line of JSON, so results can be streamed while the run is
+         * still going and their covers released right after. The record has the per-polygon fields of
+         * write_result() plus the instance, costs and algorithm, index 0 is used for the total over all polygons,
+         * whose record carries the input polygon if enabled.
+         *
+         * @param out The stream to write the record to
+         * @param instance The problem instance the algorithm was run on
+         * @param algorithm_full_name The name of the used algorithm including its postprocessors
+         * @param polygon The index of the polygon in the results, 0 for the total
+         * @param result The result of the polygon
+         * @param startTime The start of the run
+         * @param endTime The time the polygon was finished
+         * @param options The geometry and measurements to include
+         */
+        static void write_polygon_record(std::ostream &out,
+                                         const Problem_instance &instance,
+                                         const std::string &algorithm_full_name,
+                                         size_t polygon,
+                                         const Algorithm_runner::Result &result,
+                                         const std::string &startTime,
+                                         const std::string &endTime,
+                                         const Output_options &options);
+
+        /**
+         * Converts the results of a Cover_server request into its reply: the fields of the total like in
+         * write_result(), the instance, costs and algorithm and, if enabled, the cover of each polygon as a list of
+         * [min_x, min_y, max_x, max_y] arrays, which clients can use without parsing WKT.
+         *
+         * @param instance The problem instance the algorithm was run on
+         * @param algorithm_full_name The name of the used algorithm including its postprocessors
+         * @param results The results of running the algorithm on the problem instance, one result per polygon
+         * @param include_cover Whether to include the covers
+         * @param options The measurements to include, the geometry is controlled by include_cover
+         * @return The reply
+         */
+        static json reply_to_json(const Problem_instance &instance,
+                                  const std::string &algorithm_full_name,
+                                  const std::vector<Algorithm_runner::Result> &results,
+                                  bool include_cover,
+                                  const Output_options &options);
+
+        /**
+         * Writes the header line matching write_cover_csv() to the stream.
+         *
+         * @param out The stream to write the header to
+         */
+        static void write_cover_csv_header(std::ostream &out);
+
+        /**
+         * Writes the rectangles of a cover to the stream, one "polygon,min_x,min_y,max_x,max_y" line each.
+         *
+         * @param out The stream to write the rectangles to
+         * @param polygon The index of the polygon the cover belongs to
+         * @param cover The cover to write
+         */
+        static void write_cover_csv(std::ostream &out, size_t polygon, const Algorithm_runner::Cover &cover);
+
+        /**
+         * Creates the parent directories of an output path if they don't exist yet.
+         *
+         * @param output_path The path of a file about to be written
+         */
+        static void create_parent_directories(const fs::path &output_path);
+
+        /**
+         * Writes the header line matching the CSV records to the stream.
+         *
+         * @param out The stream to write the header to
+         * @param options The measurements the records include
+         */
+        static void write_csv_header(std::ostream &out, const Output_options &options = {});
+
+        /**
+         * Checks that results written with the given options can be appended to an existing CSV file, i.e. that its
+         * header matches, so rows of runs with other options don't end up below it. Other files are not checked.
+         * Throws std::runtime_error if the header differs.
+         *
+         * @param output_path The path the results are going to be written to
+         * @param options The measurements the records include
+         */
+        static void check_csv_header(const fs::path &output_path, const Output_options &options);
     };
 
 } // cover
@@ -0,0 +1,97 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef RUN_OPTIONS_H
+#define RUN_OPTIONS_H
+
+#include <cstddef>
+#include <memory>
+
+namespace cover {
+    class Decomposition_cache;
+
+    /**
+     * The engines available for decomposing a polygon and a set of cuts into rectangles.
+     */
+    enum class Decomposition_engine {
+        ARRANGEMENT,  /**< Builds a CGAL arrangement and parses its faces */
+        SWEEP  /**< Sweeps over the vertical edges and cuts without building an arrangement */
+    };
+
+    /**
+     * @brief How the Algorithm_runner runs a provider on each polygon
+     *
+     * The options are passed to Algorithm_runner::run_algorithm() and stored in the Runtime_environment of every
+     * polygon before the provider runs, so providers handing polygons or parts of them to other threads or
+     * environments pass them on together with the deadline. Runs with different options, e.g. requests with different
+     * timeouts, can happen at the same time.
+     */
+    struct Run_options {
+        /**
+         * Time limit in seconds per polygon, a non-positive limit disables it. The deadline is handed to the provider
+         * through the runtime environment, stages stop early once it passed and return the best valid cover they
+         * have so far. Results of runs which hit the deadline have the TIMEOUT status, but still carry their cover.
+         */
+        double timeout{0};
+        /**
+         * Whether the time spent in each instrumented stage and counters such as the number of base rectangles or
+         * candidates are recorded in the profile of each Result, the total result contains the sum over all polygons.
+         */
+        bool profiling{false};
+        /**
+         * How often the provider is run on each polygon, at least once. The first warmup runs are not measured, the
+         * minimum, median and 95th percentile of the execution times of the remaining ones are reported. Every run
+         * starts from the same environment: a fresh one for polygons which had none, including loading them from the
+         * decomposition cache again, or one that keeps its decomposition if the environments are kept across runs.
+         * The cover, validity and profile are those of the last run.
+         */
+        size_t repetitions{1};
+        size_t warmup_runs{0};
+        /**
+         * Whether the hardware counters (cycles, instructions, cache misses) of each measured run are read, see
+         * Perf_counters for when they are available.
+         */
+        bool hardware_counters{false};
+        /**
+         * Cache used to look up the decomposition of each polygon before running the provider on it, nullptr
+         * disables caching. Polygons which aren't cached yet are stored after the run if the provider computed their
+         * decomposition. Loading happens before the execution time is measured.
+         */
+        std::shared_ptr<const Decomposition_cache> decomposition_cache{};
+        /**
+         * Number of threads the ray shooting and the parsing of the arrangement's faces of a single polygon are
+         * spread over. Only polygons with at least Util::PARALLEL_DECOMPOSITION_THRESHOLD concave vertices or faces
+         * are split up, the result does not depend on the number of threads.
+         */
+        size_t decomposition_threads{1};
+        /**
+         * Engine used to decompose each polygon into its base rectangles. Both engines produce the same rectangles,
+         * cached decompositions are kept apart per engine.
+         */
+        Decomposition_engine decomposition_engine{Decomposition_engine::ARRANGEMENT};
+    };
+}
+
+#endif //RUN_OPTIONS_H
@@ -26,21 +26,84 @@
 #ifndef RUNTIME_ENVIRONMENT_H
 #define RUNTIME_ENVIRONMENT_H
 
+#include <string>
+
+#include "arena.h"
+#include "base_rectangle_coverage.h"
 #include "baserect_graph.h"
+#include "containment_index.h"
+#include "deadline.h"
+#include "memory_account.h"
+#include "profile.h"
+#include "run_options.h"
 
 namespace cover {
 
 struct Runtime_environment {
     std::vector<Rectangle> base_rectangles;
-    std::vector<size_t> base_rectangle_cover_counts;
     BaseRectGraph graph;
-    bool pixel_coverage_invalidated{false};
+    Containment_index containment;
+    Base_rectangle_coverage coverage;
+    Profile profile;
+    Deadline deadline;
+    // the options of the current run, set by the Algorithm_runner together with the deadline
+    Run_options options;
+    // scratch space of the algorithms and postprocessors, reset in bulk between runs
+    Arena arena;
+    // scratch structures outside the arena
+    Memory_account memory;
+    // the algorithm which replaced the chosen one to stay within the memory budget, empty if none did
+    std::string degraded_to;
 
     void clear() {
         base_rectangles.clear();
-        base_rectangle_cover_counts.clear();
         graph.clear();
-        pixel_coverage_invalidated = false;
+        containment.clear();
+        coverage.clear();
+        profile.clear();
+        deadline = {};
+        options = {};
+        arena.reset();
+        memory.clear();
+        degraded_to.clear();
+    }
+
+    /**
+     * Decomposes the polygon into its base rectangles and builds their graph, unless the environment already holds
+     * them, e.g. from the decomposition cache or an earlier stage. Large polygons are decomposed on the decomposition
+     * threads of the options.
+     *
+     * @param polygon The polygon the environment belongs to
+     */
+    void ensure_decomposition(const Polygon_with_holes &polygon);
+
+    /**
+     * @return The bytes held by the decomposition of the polygon, which stays in memory for the whole run
+     */
+    [[nodiscard]] size_t decomposition_memory() const {
+        return base_rectangles.capacity() * sizeof(Rectangle) + graph.memory_usage();
+    }
+
+    /**
+     * @return The bytes held by the containment index and the coverage counts, which stay in memory once built
+     */
+    [[nodiscard]] size_t index_memory() const {
+        return containment.memory_usage() + coverage.memory_usage();
+    }
+
+    /**
+     * Clears everything which depends on a particular cover, but keeps the
+     * decomposition of the polygon, so the environment can be reused for
+     * another run on the same polygon.
+     */
+    void clear_cover_data() {
+        coverage.clear();
+        profile.clear();
+        deadline = {};
+        options = {};
+        arena.reset();
+        memory.clear();
+        degraded_to.clear();
     }
 };
 
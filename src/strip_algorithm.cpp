@@ -24,6 +24,7 @@
  */
 
 #include "strip_algorithm.h"
+#include "profile.h"
 #include "baserect_graph.h"
 #include "datastructures.h"
 #include "rectangle_enumerator.h"
@@ -35,13 +36,9 @@ std::vector<Rectangle> Strip_algorithm::calculate_cover(
     const Polygon_with_holes &polygon,
     const Problem_instance::Costs &costs,
     Runtime_environment *env) {
+        PROFILE_SCOPE("strip");
 
-        if (env->graph.empty()) {
-            if (env->base_rectangles.empty()) {
-                env->base_rectangles = Rectangle_enumerator::get_base_rectangles(polygon);
-            }
-            env->graph.build(env->base_rectangles);
-        }
+        env->ensure_decomposition(polygon);
         const auto &nodes{env->graph.getNodes()};
 
         assert(nodes.size() > 1);
@@ -0,0 +1,233 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tiled_cover_provider.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "algorithm.h"
+#include "base_rectangle_region.h"
+#include "cover_joiner.h"
+#include "cover_pruner.h"
+#include "profile.h"
+
+namespace cover {
+    namespace {
+        /**
+         * Hands a fixed cover to the postprocessors repairing the seams.
+         */
+        class Fixed_cover : public Algorithm {
+        public:
+            explicit Fixed_cover(Cover cover) : cover(std::move(cover)) {}
+
+        protected:
+            [[nodiscard]] Cover calculate_cover(const Polygon_with_holes &polygon,
+                                                const Problem_instance::Costs &costs,
+                                                Runtime_environment *env) override {
+                return std::move(cover);
+            }
+
+        private:
+            Cover cover;
+        };
+
+        /**
+         * Splits the sorted nodes into about part_count consecutive parts of equal size, only splitting between
+         * nodes with different keys.
+         *
+         * @return The end of each part in nodes
+         */
+        template<typename Key>
+        std::vector<size_t> split_sorted(const std::vector<BaseRectNode::PtrType> &nodes, size_t begin, size_t end,
+                                         size_t part_count, Key &&key) {
+            std::vector<size_t> ends{};
+            const auto part_size{std::max<size_t>(1, (end - begin + part_count - 1) / part_count)};
+            auto current{begin};
+            while (current < end) {
+                auto next{std::min(end, current + part_size)};
+                while (next < end && key(nodes[next]) == key(nodes[next - 1])) {
+                    ++next;
+                }
+                ends.push_back(next);
+                current = next;
+            }
+            return ends;
+        }
+    }
+
+    std::vector<size_t> Tiled_cover_provider::assign_tiles(const BaseRectGraph &graph) const {
+        const auto &compact_nodes{graph.getCompactNodes()};
+        const auto node_count{compact_nodes.size()};
+        const auto tile_count{(node_count + tile_size - 1) / tile_size};
+        const auto column_count{static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(tile_count))))};
+        const auto row_count{(tile_count + column_count - 1) / column_count};
+
+        std::vector<BaseRectNode::PtrType> order(node_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&compact_nodes](auto lhs, auto rhs) {
+            return compact_nodes[lhs].min_x < compact_nodes[rhs].min_x;
+        });
+
+        std::vector<size_t> tiles(node_count);
+        size_t tile{0};
+        size_t column_begin{0};
+        for (const auto column_end: split_sorted(order, 0, node_count, column_count,
+                                                 [&compact_nodes](auto node) { return compact_nodes[node].min_x; })) {
+            std::sort(order.begin() + static_cast<std::ptrdiff_t>(column_begin),
+                      order.begin() + static_cast<std::ptrdiff_t>(column_end),
+                      [&compact_nodes](auto lhs, auto rhs) {
+                          return compact_nodes[lhs].min_y < compact_nodes[rhs].min_y;
+                      });
+            size_t row_begin{column_begin};
+            for (const auto row_end: split_sorted(order, column_begin, column_end, row_count,
+                                                  [&compact_nodes](auto node) { return compact_nodes[node].min_y; })) {
+                for (auto i = row_begin; i < row_end; i++) {
+                    tiles[order[i]] = tile;
+                }
+                ++tile;
+                row_begin = row_end;
+            }
+            column_begin = column_end;
+        }
+        LOG(info) << "Cut " << node_count << " base rectangles into " << tile << " tile(s)";
+        PROFILE_COUNT("tiles", tile);
+        return tiles;
+    }
+
+    Cover_provider::Cover
+    Tiled_cover_provider::get_cover_for(const Polygon_with_holes &polygon,
+                                        const Problem_instance::Costs &costs,
+                                        Runtime_environment *env) {
+        if (pool == nullptr) {
+            pool = std::make_unique<Worker_pool>(threads);
+            providers.resize(pool->size());
+            for (auto &provider: providers) {
+                provider = factory();
+            }
+        }
+
+        env->ensure_decomposition(polygon);
+        const auto &graph{env->graph};
+        const auto &nodes{graph.getNodes()};
+        if (nodes.size() <= tile_size) {
+            return providers.front()->get_cover_for(polygon, costs, env);
+        }
+
+        std::vector<Base_rectangle_region> regions{};
+        std::vector<size_t> region_tiles{};
+        const auto tiles{assign_tiles(graph)};
+        {
+            PROFILE_SCOPE("tiling");
+            std::vector<std::vector<BaseRectNode::PtrType>> tile_members(
+                    *std::max_element(tiles.begin(), tiles.end()) + 1);
+            for (BaseRectNode::PtrType node = 0; node < nodes.size(); node++) {
+                tile_members[tiles[node]].push_back(node);
+            }
+            // a tile may consist of several parts, e.g. around a hole, each part is covered on its own
+            for (size_t tile = 0; tile < tile_members.size(); tile++) {
+                for (auto &region: Base_rectangle_region::find_regions(graph, tile_members[tile])) {
+                    regions.push_back(std::move(region));
+                    region_tiles.push_back(tile);
+                }
+            }
+        }
+        PROFILE_COUNT("tile_regions", regions.size());
+
+        std::vector<Cover> region_covers(regions.size());
+        std::vector<Profile> worker_profiles(pool->size());
+        std::vector<uint8_t> deadline_reached(regions.size(), false);
+        auto *profile{Profile::current()};
+        {
+            PROFILE_SCOPE("tile_covers");
+            pool->run(regions.size(), [&](size_t task, size_t worker) {
+                const Profile::Activation activation{profile != nullptr ? &worker_profiles[worker] : nullptr};
+                const auto &region{regions[task]};
+                const auto region_polygon{region.to_polygon(graph)};
+                if (region_polygon.outer_boundary().size() == 4 && !region_polygon.has_holes()) {
+                    region_covers[task].push_back(graph.to_rectangle(region.bounds));
+                    return;
+                }
+
+                Runtime_environment region_environment{};
+                region_environment.deadline = env->deadline;
+                region_environment.options = env->options;
+                region_covers[task] = providers[worker]->get_cover_for(region_polygon, costs, &region_environment);
+                deadline_reached[task] = region_environment.deadline.reached();
+            });
+        }
+        if (profile != nullptr) {
+            for (const auto &worker_profile: worker_profiles) {
+                profile->merge(worker_profile);
+            }
+        }
+        if (std::any_of(deadline_reached.begin(), deadline_reached.end(), [](uint8_t reached) { return reached; })) {
+            env->deadline.report();
+        }
+
+        // the rectangles containing a base rectangle next to one of another tile touch a seam
+        Cover cover{};
+        Cover seam_cover{};
+        for (size_t region = 0; region < regions.size(); region++) {
+            const auto tile{region_tiles[region]};
+            for (const auto &rectangle: region_covers[region]) {
+                bool touches_seam{false};
+                for (auto it = graph.begin(rectangle.get_top_right(), rectangle.get_bottom_left());
+                     it != graph.end() && !touches_seam; ++it) {
+                    for (const auto neighbor: {nodes[*it].left, nodes[*it].right, nodes[*it].top, nodes[*it].bottom}) {
+                        if (neighbor != BaseRectNode::NO_NEIGHBOR && tiles[neighbor] != tile) {
+                            touches_seam = true;
+                            break;
+                        }
+                    }
+                }
+                (touches_seam ? seam_cover : cover).push_back(rectangle);
+            }
+        }
+        LOG(info) << "Repairing " << seam_cover.size() << " of " << cover.size() + seam_cover.size()
+                  << " rectangle(s) touching a seam";
+        PROFILE_COUNT("seam_rectangles", seam_cover.size());
+
+        // only the seam rectangles are pruned, which is safe as they are redundant among themselves already
+        {
+            PROFILE_SCOPE("seam_repair");
+            Cover_pruner seam_repair{std::make_unique<Cover_joiner>(std::make_unique<Fixed_cover>(
+                    std::move(seam_cover)))};
+            const auto repaired{seam_repair.get_cover_for(polygon, costs, env)};
+            cover.insert(cover.end(), repaired.begin(), repaired.end());
+        }
+        // the counts only cover the seam rectangles, the postprocessors following this provider must not use them
+        env->coverage.clear();
+
+        return cover;
+    }
+
+    bool Tiled_cover_provider::timeouted() const {
+        return std::any_of(providers.begin(), providers.end(), [](const auto &provider) {
+            return provider->timeouted();
+        });
+    }
+} // cover
@@ -0,0 +1,88 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TILED_COVER_PROVIDER_H
+#define TILED_COVER_PROVIDER_H
+
+#include <memory>
+#include <vector>
+
+#include "algorithm_runner.h"
+#include "cover_provider.h"
+#include "worker_pool.h"
+
+namespace cover {
+
+    /**
+     * @brief Cover provider which cuts large polygons into tiles and covers the tiles independently
+     *
+     * The base rectangles are split into columns and the columns into rows holding about the same number of base
+     * rectangles each, so the tiles are bounded by sides of base rectangles. Every connected part of a tile is covered
+     * on its own by a provider from the factory, on multiple threads if requested, which keeps the memory and time of
+     * algorithms that grow superlinearly with the size of the polygon bounded by the tile size.
+     *
+     * Rectangles cannot cross the seams between tiles, so the covers of the tiles are stitched together and the
+     * rectangles touching a seam are joined and pruned once more against the whole polygon, which merges the
+     * rectangles the seams cut into pieces.
+     */
+    class Tiled_cover_provider : public Cover_provider {
+    public:
+        /**
+         * @param factory Creates the providers covering the tiles, one per thread
+         * @param tile_size The number of base rectangles per tile, polygons with at most that many are not tiled
+         * @param threads The number of threads covering the tiles of a single polygon
+         */
+        Tiled_cover_provider(Algorithm_runner::Provider_factory factory, size_t tile_size, size_t threads = 1)
+                : factory(std::move(factory)), tile_size(std::max<size_t>(1, tile_size)),
+                  threads(std::max<size_t>(1, threads)) {}
+
+        [[nodiscard]] Cover
+        get_cover_for(const Polygon_with_holes &polygon,
+                      const Problem_instance::Costs &costs,
+                      Runtime_environment *env) override;
+
+        [[nodiscard]] bool timeouted() const override;
+
+    private:
+        /**
+         * Assigns every base rectangle to a tile, splitting at changes of the left and bottom side of the base
+         * rectangles only, so base rectangles starting at the same coordinate end up in the same column and row.
+         *
+         * @param graph The base rectangle graph of the polygon
+         * @return The tile of each base rectangle
+         */
+        [[nodiscard]] std::vector<size_t> assign_tiles(const BaseRectGraph &graph) const;
+
+        Algorithm_runner::Provider_factory factory;
+        const size_t tile_size;
+        const size_t threads;
+        // created on first use and reused for all polygons this instance covers, one provider per worker
+        std::unique_ptr<Worker_pool> pool;
+        std::vector<std::unique_ptr<Cover_provider>> providers;
+    };
+
+} // cover
+
+#endif //TILED_COVER_PROVIDER_H
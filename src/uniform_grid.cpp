@@ -0,0 +1,106 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "uniform_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cover {
+
+    Uniform_grid::Uniform_grid(const CGAL::Bbox_2 &bounds, size_t columns, size_t rows)
+            : min_x(bounds.xmin()), min_y(bounds.ymin()),
+              cell_width(std::max((bounds.xmax() - bounds.xmin()) / static_cast<double>(std::max<size_t>(columns, 1)),
+                                  std::numeric_limits<double>::min())),
+              cell_height(std::max((bounds.ymax() - bounds.ymin()) / static_cast<double>(std::max<size_t>(rows, 1)),
+                                   std::numeric_limits<double>::min())),
+              columns(std::max<size_t>(columns, 1)), rows(std::max<size_t>(rows, 1)),
+              cells(this->columns * this->rows) {
+    }
+
+    void Uniform_grid::insert(size_t id, const CGAL::Bbox_2 &box) {
+        const auto range{cells_of(box)};
+        for (auto row = range.min_row; row <= range.max_row; row++) {
+            for (auto column = range.min_column; column <= range.max_column; column++) {
+                cells[row * columns + column].push_back(id);
+            }
+        }
+        if (id >= stamps.size()) {
+            stamps.resize(id + 1, 0);
+        }
+    }
+
+    void Uniform_grid::erase(size_t id, const CGAL::Bbox_2 &box) {
+        const auto range{cells_of(box)};
+        for (auto row = range.min_row; row <= range.max_row; row++) {
+            for (auto column = range.min_column; column <= range.max_column; column++) {
+                auto &cell{cells[row * columns + column]};
+                const auto position{std::find(cell.begin(), cell.end(), id)};
+                if (position != cell.end()) {
+                    *position = cell.back();
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+
+    const std::vector<size_t> &Uniform_grid::query(const CGAL::Bbox_2 &box) {
+        result.clear();
+        if (++current_stamp == 0) {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            current_stamp = 1;
+        }
+
+        const auto range{cells_of(box)};
+        for (auto row = range.min_row; row <= range.max_row; row++) {
+            for (auto column = range.min_column; column <= range.max_column; column++) {
+                for (const auto id: cells[row * columns + column]) {
+                    if (stamps[id] != current_stamp) {
+                        stamps[id] = current_stamp;
+                        result.push_back(id);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    Uniform_grid::Cell_range Uniform_grid::cells_of(const CGAL::Bbox_2 &box) const {
+        return {clamped_cell(box.xmin(), min_x, cell_width, columns),
+                clamped_cell(box.ymin(), min_y, cell_height, rows),
+                clamped_cell(box.xmax(), min_x, cell_width, columns),
+                clamped_cell(box.ymax(), min_y, cell_height, rows)};
+    }
+
+    size_t Uniform_grid::clamped_cell(double coordinate, double origin, double cell_size, size_t count) {
+        const auto cell{std::floor((coordinate - origin) / cell_size)};
+        if (!(cell > 0)) {
+            return 0;
+        }
+        return std::min(static_cast<size_t>(std::min(cell, static_cast<double>(count - 1))), count - 1);
+    }
+
+} // cover
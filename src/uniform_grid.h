@@ -0,0 +1,106 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef UNIFORM_GRID_H
+#define UNIFORM_GRID_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CGAL_classes.h"
+
+namespace cover {
+
+    /**
+     * @brief Uniform grid over a bounding box storing ids of axis-parallel boxes in every cell they overlap
+     *
+     * Boxes and queries reaching beyond the grid's bounds are clamped to its outermost cells, so a query always
+     * returns every stored box overlapping the queried box (as closed sets) and possibly a few more.
+     */
+    class Uniform_grid {
+    public:
+        /**
+         * Creates an empty grid of columns x rows cells spanning the given bounds.
+         *
+         * @param bounds The area covered by the grid
+         * @param columns The number of cells in x direction, at least 1
+         * @param rows The number of cells in y direction, at least 1
+         */
+        Uniform_grid(const CGAL::Bbox_2 &bounds, size_t columns, size_t rows);
+
+        /**
+         * Stores the id in every cell overlapping the box.
+         *
+         * @param id The id to store
+         * @param box The box the id belongs to
+         */
+        void insert(size_t id, const CGAL::Bbox_2 &box);
+
+        /**
+         * Removes the id from every cell overlapping the box, which must be the same box it was inserted with.
+         *
+         * @param id The id to remove
+         * @param box The box the id was inserted with
+         */
+        void erase(size_t id, const CGAL::Bbox_2 &box);
+
+        /**
+         * Collects the ids of all stored boxes which may overlap the queried box, each id once and in no
+         * particular order.
+         *
+         * @param box The box to query
+         * @return The ids, valid until the next query
+         */
+        const std::vector<size_t> &query(const CGAL::Bbox_2 &box);
+
+    private:
+        struct Cell_range {
+            size_t min_column;
+            size_t min_row;
+            size_t max_column;
+            size_t max_row;
+        };
+
+        double min_x;
+        double min_y;
+        double cell_width;
+        double cell_height;
+        size_t columns;
+        size_t rows;
+        std::vector<std::vector<size_t>> cells;
+
+        // the query in which an id was last reported, to report every id once per query
+        std::vector<uint_fast32_t> stamps;
+        uint_fast32_t current_stamp{0};
+        std::vector<size_t> result;
+
+        [[nodiscard]] Cell_range cells_of(const CGAL::Bbox_2 &box) const;
+
+        [[nodiscard]] static size_t clamped_cell(double coordinate, double origin, double cell_size, size_t count);
+    };
+
+} // cover
+
+#endif //UNIFORM_GRID_H
@@ -24,8 +24,32 @@
  */
 
 #include "util.h"
+#include "profile.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <map>
 
 namespace cover {
+    size_t Util::chunk_count(size_t count, size_t threads) {
+        if (threads <= 1 || count < PARALLEL_DECOMPOSITION_THRESHOLD) {
+            return 1;
+        }
+        return std::min(count, threads * CHUNKS_PER_THREAD);
+    }
+
+    void Util::for_each_chunk(size_t count, size_t chunks, size_t threads,
+                              const std::function<void(size_t, size_t, size_t)> &task) {
+        if (chunks <= 1) {
+            task(0, count, 0);
+            return;
+        }
+        Worker_pool pool{std::min(threads, chunks)};
+        pool.run(chunks, [&](size_t chunk, size_t) {
+            task(chunk * count / chunks, (chunk + 1) * count / chunks, chunk);
+        });
+    }
+
     Direction Util::normalize(const Direction &direction) {
         auto x = direction.dx() == 0 ? 0 : (direction.dx() < 0 ? -1 : 1);
         auto y = direction.dy() == 0 ? 0 : (direction.dy() < 0 ? -1 : 1);
@@ -71,6 +95,18 @@ namespace cover {
         return {};
     }
 
+    void Util::normalize_orientation(Polygon_with_holes &polygon) {
+        // the signed area does not require the rings to be simple, unlike CGAL's orientation()
+        if (polygon.outer_boundary().area() < 0) {
+            polygon.outer_boundary().reverse_orientation();
+        }
+        for (auto hole{polygon.holes_begin()}; hole != polygon.holes_end(); ++hole) {
+            if (hole->area() > 0) {
+                hole->reverse_orientation();
+            }
+        }
+    }
+
     Util::ConcaveMap Util::find_concave_vertices(const Polygon_with_holes &polygon) {
         LOG(trace) << "Finding concave vertices of polygon with holes";
 
@@ -198,6 +234,196 @@ namespace cover {
         }
     }
 
+    void Util::Edge_index::Stabbing_index::build(std::vector<Entry> entries) {
+        coordinates.clear();
+        for (const auto &entry: entries) {
+            coordinates.push_back(entry.min);
+            coordinates.push_back(entry.max);
+        }
+        std::sort(coordinates.begin(), coordinates.end());
+        coordinates.erase(std::unique(coordinates.begin(), coordinates.end()), coordinates.end());
+
+        // elementary slots: 2i is the open gap below coordinates[i], 2i + 1 is coordinates[i] itself
+        leaf_count = 1;
+        while (leaf_count < 2 * coordinates.size() + 1) {
+            leaf_count *= 2;
+        }
+        tree.assign(2 * leaf_count, {});
+
+        for (const auto &entry: entries) {
+            auto left{slot_of(entry.min) + leaf_count};
+            auto right{slot_of(entry.max) + leaf_count + 1};
+            for (; left < right; left /= 2, right /= 2) {
+                if (left & 1) {
+                    tree[left++].push_back(entry);
+                }
+                if (right & 1) {
+                    tree[--right].push_back(entry);
+                }
+            }
+        }
+
+        for (auto &node: tree) {
+            std::sort(node.begin(), node.end(), [](const auto &first, const auto &second) {
+                return first.position < second.position;
+            });
+        }
+    }
+
+    size_t Util::Edge_index::Stabbing_index::slot_of(const NumType &coordinate) const {
+        const auto it{std::lower_bound(coordinates.begin(), coordinates.end(), coordinate)};
+        const auto index{static_cast<size_t>(it - coordinates.begin())};
+        return (it != coordinates.end() && *it == coordinate) ? 2 * index + 1 : 2 * index;
+    }
+
+    template<class Skip>
+    std::optional<NumType> Util::Edge_index::Stabbing_index::closest(const NumType &coordinate,
+                                                                     const NumType &start,
+                                                                     bool positive, Skip &&skip) const {
+        std::optional<NumType> closest{};
+        if (tree.empty()) {
+            return closest;
+        }
+
+        const auto by_position = [](const Entry &entry, const NumType &position) {
+            return entry.position < position;
+        };
+
+        // every node on the path from the leaf to the root contains exactly the segments stabbing its slots
+        for (auto node{slot_of(coordinate) + leaf_count}; node > 0; node /= 2) {
+            const auto &entries{tree[node]};
+            if (positive) {
+                auto it{std::lower_bound(entries.begin(), entries.end(), start, by_position)};
+                for (; it != entries.end() && (!closest || it->position < *closest); ++it) {
+                    if (!skip(*it)) {
+                        closest = it->position;
+                        break;
+                    }
+                }
+            } else {
+                auto it{std::upper_bound(entries.begin(), entries.end(), start,
+                                         [](const NumType &position, const Entry &entry) {
+                                             return position < entry.position;
+                                         })};
+                while (it != entries.begin() && (!closest || std::prev(it)->position > *closest)) {
+                    --it;
+                    if (!skip(*it)) {
+                        closest = it->position;
+                        break;
+                    }
+                }
+            }
+        }
+        return closest;
+    }
+
+    Util::Edge_index::Edge_index(const Polygon_with_holes &polygon) {
+        std::vector<Stabbing_index::Entry> vertical_entries{}, horizontal_entries{};
+
+        const auto add_edges = [&](const Polygon &ring) {
+            for (const auto &edge: ring.edges()) {
+                const auto &source{edge.source()};
+                const auto &target{edge.target()};
+                if (source.x() == target.x()) {
+                    const auto min_y{std::min(source.y(), target.y())}, max_y{std::max(source.y(), target.y())};
+                    vertical_entries.push_back({source.x(), min_y, max_y});
+                    vertical_lines[source.x()].emplace_back(min_y, max_y);
+                } else {
+                    assert(source.y() == target.y());
+                    const auto min_x{std::min(source.x(), target.x())}, max_x{std::max(source.x(), target.x())};
+                    horizontal_entries.push_back({source.y(), min_x, max_x});
+                    horizontal_lines[source.y()].emplace_back(min_x, max_x);
+                }
+            }
+        };
+
+        add_edges(polygon.outer_boundary());
+        for (const auto &hole: polygon.holes()) {
+            add_edges(hole);
+        }
+
+        verticals.build(std::move(vertical_entries));
+        horizontals.build(std::move(horizontal_entries));
+
+        for (auto *lines: {&vertical_lines, &horizontal_lines}) {
+            for (auto &[_, intervals]: *lines) {
+                std::sort(intervals.begin(), intervals.end());
+            }
+        }
+    }
+
+    std::optional<Point> Util::Edge_index::get_closest_intersection(const Ray &ray) const {
+        return query(ray, false);
+    }
+
+    std::optional<Point> Util::Edge_index::get_closest_point_intersection(const Ray &ray) const {
+        return query(ray, true);
+    }
+
+    std::optional<Point> Util::Edge_index::query(const Ray &ray, bool point_intersections_only) const {
+        const auto direction{Util::normalize(ray.direction())};
+        assert((direction.dx() == 0) != (direction.dy() == 0));
+
+        const bool is_horizontal{direction.dy() == 0};
+        const bool positive{direction.dx() > 0 || direction.dy() > 0};
+        // start is the source's coordinate along the ray, coordinate the one across it
+        const auto start{is_horizontal ? ray.source().x() : ray.source().y()};
+        const auto coordinate{is_horizontal ? ray.source().y() : ray.source().x()};
+
+        const auto &perpendicular{is_horizontal ? verticals : horizontals};
+        std::optional<NumType> closest{};
+        if (point_intersections_only) {
+            closest = perpendicular.closest(coordinate, start, positive, [&](const auto &entry) {
+                return entry.position == start;
+            });
+        } else {
+            closest = perpendicular.closest(coordinate, start, positive, [&](const auto &entry) {
+                return entry.position == start && (entry.min == coordinate || entry.max == coordinate);
+            });
+
+            // edges on the ray's line intersect it in a segment, whose closest endpoint counts as intersection
+            const auto &lines{is_horizontal ? horizontal_lines : vertical_lines};
+            const auto line{lines.find(coordinate)};
+            if (line != lines.end()) {
+                const auto &intervals{line->second};
+                const auto is_incident = [&](const auto &interval) {
+                    return interval.first == start || interval.second == start;
+                };
+                std::optional<NumType> collinear{};
+                if (positive) {
+                    auto it{std::lower_bound(intervals.begin(), intervals.end(), start,
+                                             [](const auto &interval, const NumType &value) {
+                                                 return interval.second < value;
+                                             })};
+                    for (; it != intervals.end() && !collinear; ++it) {
+                        if (!is_incident(*it)) {
+                            collinear = std::max(start, it->first);
+                        }
+                    }
+                } else {
+                    auto it{std::upper_bound(intervals.begin(), intervals.end(), start,
+                                             [](const NumType &value, const auto &interval) {
+                                                 return value < interval.first;
+                                             })};
+                    while (it != intervals.begin() && !collinear) {
+                        --it;
+                        if (!is_incident(*it)) {
+                            collinear = std::min(start, it->second);
+                        }
+                    }
+                }
+                if (collinear && (!closest || (positive ? *collinear < *closest : *collinear > *closest))) {
+                    closest = collinear;
+                }
+            }
+        }
+
+        if (!closest) {
+            return {};
+        }
+        return is_horizontal ? Point{*closest, coordinate} : Point{coordinate, *closest};
+    }
+
     Arrangement
     Util::create_arrangement(const Polygon_with_holes &polygon, const std::vector<Segment> &cuts) {
         LOG(debug) << "Creating arrangement";
@@ -221,19 +447,11 @@ namespace cover {
         return arrangement;
     }
 
-    std::vector<Rectangle>
-    Util::parse_rectangles(const Arrangement &arrangement, const Polygon_with_holes &polygon) {
-        std::vector<Rectangle> rectangles{};
-
-        for (auto face{arrangement.faces_begin()}; face != arrangement.faces_end(); ++face) {
-            if (!face->has_outer_ccb()) {
-                continue;
-            }
-
-            assert(!face->is_unbounded());
-            assert(!face->is_fictitious());
-            assert(face->has_outer_ccb());
-
+    namespace {
+        /**
+         * @return The bounding box of the face if its boundary is a rectangle, nullopt otherwise
+         */
+        std::optional<Rectangle> parse_face(const Arrangement::Face_const_handle &face) {
             auto half_edge_it{face->outer_ccb()};
 
             const auto first_vertex{half_edge_it->source()->point()};
@@ -279,30 +497,220 @@ namespace cover {
                 current_direction = new_direction;
             } while (++half_edge_it != face->outer_ccb());
 
-            if (is_rectangle) {
-                Rectangle rectangle{min_x, min_y, max_x, max_y};
-                bool is_hole{false};
+            if (!is_rectangle) {
+                return std::nullopt;
+            }
+            return Rectangle{min_x, min_y, max_x, max_y};
+        }
+    }
+
+    std::vector<Rectangle>
+    Util::parse_rectangles(const Arrangement &arrangement, const Polygon_with_holes &polygon, size_t threads) {
+        std::vector<Arrangement::Face_const_handle> faces{};
+        for (auto face{arrangement.faces_begin()}; face != arrangement.faces_end(); ++face) {
+            if (face->has_outer_ccb()) {
+                assert(!face->is_unbounded());
+                assert(!face->is_fictitious());
+                faces.push_back(face);
+            }
+        }
 
-                // checking if the rectangle was a hole in the polygon
-                for (const auto &hole: polygon.holes()) {
-                    if (rectangle.as_polygon().bbox() == hole.bbox()) {
-                        is_hole = true;
-                        break;
-                    }
+        // the holes are faces of the arrangement as well, they are recognized by their bounding box
+        Map<Point, std::vector<Point>> hole_corners{};
+        for (const auto &hole: polygon.holes()) {
+            const auto bbox{hole.bbox()};
+            hole_corners[{bbox.xmin(), bbox.ymin()}].emplace_back(bbox.xmax(), bbox.ymax());
+        }
+        const auto is_hole{[&hole_corners](const Rectangle &rectangle) {
+            const auto corners{hole_corners.find(rectangle.get_bottom_left())};
+            return corners != hole_corners.end()
+                   && std::find(corners->second.begin(), corners->second.end(), rectangle.get_top_right())
+                      != corners->second.end();
+        }};
+
+        // the faces are parsed independently, chunks of them on the decomposition threads
+        const auto chunks{chunk_count(faces.size(), threads)};
+        std::vector<std::vector<Rectangle>> chunk_rectangles(chunks);
+        for_each_chunk(faces.size(), chunks, threads, [&](size_t begin, size_t end, size_t chunk) {
+            for (size_t i = begin; i < end; i++) {
+                const auto rectangle{parse_face(faces[i])};
+                if (rectangle.has_value() && !is_hole(*rectangle)) {
+                    chunk_rectangles[chunk].push_back(*rectangle);
                 }
+            }
+        });
 
-                if (!is_hole) {
-                    rectangles.push_back(rectangle);
-                    IF_LOG_LEVEL(debug) {
-                        if (rectangles.size() % 1000 == 0) {
-                            LOG(debug) << "Seen " << rectangles.size() << " rectangles";
-                        }
-                    }
+        std::vector<Rectangle> rectangles{};
+        rectangles.reserve(faces.size());
+        for (const auto &chunk: chunk_rectangles) {
+            rectangles.insert(rectangles.end(), chunk.begin(), chunk.end());
+        }
+        LOG(debug) << "Parsed " << rectangles.size() << " rectangles from " << faces.size() << " faces";
+
+        return rectangles;
+    }
+
+    namespace {
+        struct Vertical_segment {
+            NumType x;
+            NumType min_y;
+            NumType max_y;
+            bool closes;  // whether the polygon's interior lies left of the segment
+            bool opens;  // whether the polygon's interior lies right of the segment
+        };
+
+        struct Horizontal_segment {
+            NumType y;
+            NumType min_x;
+            NumType max_x;
+        };
+
+        using Interval = std::pair<NumType, NumType>;
+
+        void merge_intervals(std::vector<Interval> &intervals) {
+            std::sort(intervals.begin(), intervals.end());
+            size_t merged{0};
+            for (size_t i = 1; i < intervals.size(); i++) {
+                if (intervals[i].first <= intervals[merged].second) {
+                    intervals[merged].second = std::max(intervals[merged].second, intervals[i].second);
+                } else {
+                    intervals[++merged] = intervals[i];
+                }
+            }
+            if (!intervals.empty()) {
+                intervals.resize(merged + 1);
+            }
+        }
+    }
+
+    std::vector<Rectangle>
+    Util::sweep_rectangles(const Polygon_with_holes &polygon, const std::vector<Segment> &cuts) {
+        LOG(debug) << "Sweeping polygon with " << cuts.size() << " cuts";
+
+        std::vector<Vertical_segment> verticals{};
+        std::vector<Horizontal_segment> horizontals{};
+
+        const auto add_segment = [&](const Segment &segment, bool is_cut) {
+            const auto &source{segment.source()};
+            const auto &target{segment.target()};
+            if (source == target) {
+                return;
+            }
+            if (source.x() == target.x()) {
+                // the interior of the polygon lies left of its edges in the direction of traversal
+                const bool upwards{source.y() < target.y()};
+                verticals.push_back({source.x(), std::min(source.y(), target.y()), std::max(source.y(), target.y()),
+                                     is_cut || upwards, is_cut || !upwards});
+            } else {
+                assert(source.y() == target.y());
+                horizontals.push_back({source.y(), std::min(source.x(), target.x()),
+                                       std::max(source.x(), target.x())});
+            }
+        };
+
+        for (const auto &edge: polygon.outer_boundary().edges()) {
+            add_segment(edge, false);
+        }
+        for (const auto &hole: polygon.holes()) {
+            for (const auto &edge: hole.edges()) {
+                add_segment(edge, false);
+            }
+        }
+        for (const auto &cut: cuts) {
+            add_segment(cut, true);
+        }
+
+        std::sort(verticals.begin(), verticals.end(), [](const auto &first, const auto &second) {
+            return first.x < second.x;
+        });
+
+        std::vector<const Horizontal_segment *> starts{}, ends{};
+        starts.reserve(horizontals.size());
+        ends.reserve(horizontals.size());
+        for (const auto &horizontal: horizontals) {
+            starts.push_back(&horizontal);
+            ends.push_back(&horizontal);
+        }
+        std::sort(starts.begin(), starts.end(), [](const auto *first, const auto *second) {
+            return first->min_x < second->min_x;
+        });
+        std::sort(ends.begin(), ends.end(), [](const auto *first, const auto *second) {
+            return first->max_x < second->max_x;
+        });
+
+        // open rectangles by their lower y coordinate, mapped to their upper y coordinate and their left x coordinate
+        std::map<NumType, std::pair<NumType, NumType>> open_rectangles{};
+        // y coordinates of the horizontal segments continuing right of the sweep line and how many there are
+        std::map<NumType, size_t> active_horizontals{};
+
+        std::vector<Rectangle> rectangles{};
+        std::vector<Interval> closing{}, opening{};
+        size_t next_start{0}, next_end{0};
+
+        for (size_t i = 0; i < verticals.size();) {
+            const auto x{verticals[i].x};
+
+            closing.clear();
+            opening.clear();
+            for (; i < verticals.size() && verticals[i].x == x; i++) {
+                const auto &vertical{verticals[i]};
+                if (vertical.closes) {
+                    closing.emplace_back(vertical.min_y, vertical.max_y);
+                }
+                if (vertical.opens) {
+                    opening.emplace_back(vertical.min_y, vertical.max_y);
+                }
+            }
+            merge_intervals(closing);
+            merge_intervals(opening);
+
+            for (const auto &[min_y, max_y]: closing) {
+                auto it{open_rectangles.lower_bound(min_y)};
+                while (it != open_rectangles.end() && it->first < max_y) {
+                    const auto &[upper_y, left_x]{it->second};
+                    assert(upper_y <= max_y);
+                    rectangles.emplace_back(left_x, it->first, x, upper_y);
+                    it = open_rectangles.erase(it);
+                }
+            }
+
+            for (; next_start < starts.size() && starts[next_start]->min_x <= x; next_start++) {
+                ++active_horizontals[starts[next_start]->y];
+            }
+            for (; next_end < ends.size() && ends[next_end]->max_x <= x; next_end++) {
+                const auto it{active_horizontals.find(ends[next_end]->y)};
+                assert(it != active_horizontals.end());
+                if (--it->second == 0) {
+                    active_horizontals.erase(it);
                 }
             }
+
+            for (const auto &[min_y, max_y]: opening) {
+                auto lower_y{min_y};
+                for (auto it{active_horizontals.upper_bound(min_y)};
+                     it != active_horizontals.end() && it->first < max_y; ++it) {
+                    open_rectangles[lower_y] = {it->first, x};
+                    lower_y = it->first;
+                }
+                open_rectangles[lower_y] = {max_y, x};
+            }
         }
 
+        assert(open_rectangles.empty());
+        LOG(debug) << "Sweep found " << rectangles.size() << " rectangles";
+
         return rectangles;
     }
 
+    std::vector<Rectangle>
+    Util::decompose(const Polygon_with_holes &polygon, const std::vector<Segment> &cuts, Decomposition_engine engine,
+                    size_t threads) {
+        if (engine == Decomposition_engine::SWEEP) {
+            PROFILE_SCOPE("sweep");
+            return sweep_rectangles(polygon, cuts);
+        }
+        PROFILE_SCOPE("arrangement");
+        return parse_rectangles(create_arrangement(polygon, cuts), polygon, threads);
+    }
+
 } // cover
@@ -26,11 +26,19 @@
 #ifndef COVERING_UTIL_H
 #define COVERING_UTIL_H
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
 #include "logging.h"
 
 #include "CGAL_classes.h"
 #include "rectangle.h"
 #include "datastructures.h"
+#include "run_options.h"
 
 namespace cover {
 
@@ -39,6 +47,102 @@ namespace cover {
         using ConcaveMap = Map<Point, std::array<Direction, 2>>;
         using ConcaveMapEntry = ConcaveMap::value_type;
 
+        /**
+         * @brief Index over the edges of a rectilinear polygon answering axis-parallel ray shooting queries
+         *
+         * Vertical edges are stored by their x coordinate with an interval lookup over their y range and horizontal
+         * edges are stored by their y coordinate with an interval lookup over their x range, each in a segment tree
+         * whose nodes keep their edges sorted by position. Edges lying on the ray's line are looked up per line.
+         * A query takes O(log^2 n) time instead of intersecting the ray with every edge.
+         */
+        class Edge_index {
+        public:
+            /**
+             * Builds the index over all edges of the polygon's outer boundary and its holes.
+             *
+             * @param polygon The rectilinear polygon to index
+             */
+            explicit Edge_index(const Polygon_with_holes &polygon);
+
+            /**
+             * Returns the closest intersection of the axis-parallel ray and any edge of the polygon which does not
+             * have the ray's source as an endpoint, the same as Util::get_closest_intersection does.
+             *
+             * @param ray The axis-parallel ray to intersect
+             * @return The closest intersection of the ray and the polygon if they do intersect, nullopt otherwise
+             */
+            [[nodiscard]] std::optional<Point> get_closest_intersection(const Ray &ray) const;
+
+            /**
+             * Returns the closest point in which the axis-parallel ray crosses or touches an edge of the polygon
+             * perpendicular to it, apart from the ray's source itself.
+             *
+             * @param ray The axis-parallel ray to intersect
+             * @return The closest such point if there is any, nullopt otherwise
+             */
+            [[nodiscard]] std::optional<Point> get_closest_point_intersection(const Ray &ray) const;
+
+        private:
+            /**
+             * Axis-parallel segments lying at some position and spanning a closed interval along the other axis.
+             */
+            class Stabbing_index {
+            public:
+                struct Entry {
+                    NumType position;
+                    NumType min;
+                    NumType max;
+                };
+
+                void build(std::vector<Entry> entries);
+
+                /**
+                 * Finds the closest position from start in the given direction among all segments whose interval
+                 * contains coordinate and which are not rejected by skip.
+                 */
+                template<class Skip>
+                [[nodiscard]] std::optional<NumType> closest(const NumType &coordinate, const NumType &start,
+                                                             bool positive, Skip &&skip) const;
+
+            private:
+                std::vector<NumType> coordinates;
+                size_t leaf_count{0};
+                std::vector<std::vector<Entry>> tree;
+
+                [[nodiscard]] size_t slot_of(const NumType &coordinate) const;
+            };
+
+            Stabbing_index verticals;
+            Stabbing_index horizontals;
+            // edges lying on the same line, ordered along it
+            Map<NumType, std::vector<std::pair<NumType, NumType>>> vertical_lines;
+            Map<NumType, std::vector<std::pair<NumType, NumType>>> horizontal_lines;
+
+            [[nodiscard]] std::optional<Point> query(const Ray &ray, bool point_intersections_only) const;
+        };
+
+        /**
+         * @param count The number of independent items to process
+         * @param threads The number of threads the items may be spread over
+         * @return The number of chunks to split them into, 1 for a single thread or fewer than
+         *         PARALLEL_DECOMPOSITION_THRESHOLD items
+         */
+        static size_t chunk_count(size_t count, size_t threads);
+
+        /**
+         * Splits [0, count) into the given number of consecutive chunks and calls task(begin, end, chunk) for each of
+         * them, on the given number of threads if there is more than one chunk. Tasks write to per-chunk outputs,
+         * which are concatenated in chunk order afterwards, so the result is the same as processing all items in
+         * order. The number of chunks is taken by the caller from chunk_count(), who sizes the outputs with it.
+         *
+         * @param count The number of independent items to process
+         * @param chunks The number of chunks, at least 1
+         * @param threads The number of threads to use
+         * @param task The function processing the items in [begin, end) of the given chunk
+         */
+        static void for_each_chunk(size_t count, size_t chunks, size_t threads,
+                                   const std::function<void(size_t, size_t, size_t)> &task);
+
         /**
          * @param direction The direction object to normalize
          * @return The normalized direction object
@@ -66,11 +170,19 @@ namespace cover {
          */
         static std::optional<Point> get_point_intersection(const Ray &ray, const Segment &segment);
 
+        /**
+         * Reverses the rings of the polygon which are not oriented like the decomposition expects: a counterclockwise
+         * outer boundary and clockwise holes.
+         *
+         * @param polygon The polygon to orient
+         */
+        static void normalize_orientation(Polygon_with_holes &polygon);
+
         /**
          * Returns the concave vertices in the polygon and the directions opposite of the two edges that the vertex is
          * an endpoint of.
          *
-         * @param polygon The polygon containing the concave vertices
+         * @param polygon The polygon containing the concave vertices, oriented like normalize_orientation does
          * @return A map mapping each concave vertex to the two directions opposite of its two edges
          */
         static ConcaveMap find_concave_vertices(const Polygon_with_holes &polygon);
@@ -156,10 +268,108 @@ namespace cover {
          *
          * @param arrangement The arrangement containing the rectangles
          * @param polygon The polygon the arrangement was created from
+         * @param threads The number of threads the faces of large arrangements are parsed on
          * @return The rectangles contained in the arrangement which are not holes
          */
         static std::vector<Rectangle> parse_rectangles(const Arrangement &arrangement,
-                                                       const Polygon_with_holes &polygon);
+                                                       const Polygon_with_holes &polygon, size_t threads = 1);
+
+        /**
+         * Decomposes the polygon into the rectangles formed by its edges and the cuts by sweeping a vertical line
+         * from left to right over the vertical edges and cuts, without constructing an arrangement.
+         *
+         * The sweep maintains the rectangles which are currently open, ordered by their lower y coordinate. A
+         * rectangle is closed at the first vertical segment covering its right side, new rectangles are opened to the
+         * right of cuts and of edges with the polygon's interior on their right, split at the horizontal edges and
+         * cuts continuing to the right. This requires every face formed by the edges and cuts to be a rectangle, which
+         * is the case once the cuts eliminate all concave vertices.
+         *
+         * @param polygon The polygon to decompose, oriented like normalize_orientation does
+         * @param cuts The axis-parallel cuts inside the polygon
+         * @return The rectangles formed by the polygon's edges and the cuts, in the same order as they were closed
+         */
+        static std::vector<Rectangle> sweep_rectangles(const Polygon_with_holes &polygon,
+                                                       const std::vector<Segment> &cuts);
+
+        /**
+         * Decomposes the polygon into the rectangles formed by its edges and the cuts using the given engine.
+         *
+         * @param polygon The polygon to decompose
+         * @param cuts The cuts to decompose the polygon with
+         * @param engine The engine to decompose with, see Run_options::decomposition_engine
+         * @param threads The number of threads the arrangement engine may use, see Run_options::decomposition_threads
+         * @return The rectangles formed by the polygon's edges and the cuts
+         */
+        static std::vector<Rectangle> decompose(const Polygon_with_holes &polygon, const std::vector<Segment> &cuts,
+                                                Decomposition_engine engine = Decomposition_engine::ARRANGEMENT,
+                                                size_t threads = 1);
+
+        /**
+         * Calls report(vertical, horizontal) with the indices of every pair of a vertical and a horizontal segment
+         * which intersect, including pairs only touching at an endpoint, just like CGAL::do_intersect.
+         *
+         * Sweeps a vertical line from left to right, keeping the horizontal segments it currently intersects ordered
+         * by y, and looks up every vertical segment's y range among them. Reporting the k intersecting pairs takes
+         * O((V + H) log(V + H) + k) time instead of testing all V * H pairs. The pairs are reported in the order of
+         * the sweep.
+         *
+         * @param verticals The vertical segments
+         * @param horizontals The horizontal segments
+         * @param report A callable which receives the indices of each intersecting vertical and horizontal segment
+         */
+        template<class Report>
+        static void for_each_orthogonal_intersection(const std::vector<Segment> &verticals,
+                                                     const std::vector<Segment> &horizontals,
+                                                     Report &&report) {
+            // at the same x, horizontal segments are inserted before and removed after the verticals are looked up,
+            // which keeps touching endpoints
+            enum Event_type : uint8_t { INSERT, QUERY, REMOVE };
+            struct Event {
+                NumType x;
+                Event_type type;
+                size_t segment;
+            };
+
+            std::vector<Event> events{};
+            events.reserve(verticals.size() + 2 * horizontals.size());
+            for (size_t i = 0; i < horizontals.size(); i++) {
+                assert(horizontals[i].is_horizontal());
+                events.push_back({horizontals[i].min().x(), INSERT, i});
+                events.push_back({horizontals[i].max().x(), REMOVE, i});
+            }
+            for (size_t i = 0; i < verticals.size(); i++) {
+                assert(verticals[i].is_vertical());
+                events.push_back({verticals[i].min().x(), QUERY, i});
+            }
+            std::sort(events.begin(), events.end(), [](const Event &lhs, const Event &rhs) {
+                return lhs.x < rhs.x || lhs.x == rhs.x && lhs.type < rhs.type;
+            });
+
+            std::multimap<NumType, size_t> active{};
+            std::vector<std::multimap<NumType, size_t>::iterator> positions(horizontals.size());
+            for (const auto &event: events) {
+                switch (event.type) {
+                    case INSERT:
+                        positions[event.segment] = active.emplace(horizontals[event.segment].min().y(), event.segment);
+                        break;
+                    case REMOVE:
+                        active.erase(positions[event.segment]);
+                        break;
+                    case QUERY: {
+                        const auto &vertical{verticals[event.segment]};
+                        const auto end{active.upper_bound(vertical.max().y())};
+                        for (auto it{active.lower_bound(vertical.min().y())}; it != end; ++it) {
+                            report(event.segment, it->second);
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        // smaller polygons are decomposed on the calling thread only, as starting threads would outweigh the gain
+        static constexpr size_t PARALLEL_DECOMPOSITION_THRESHOLD{4096};
+        static constexpr size_t CHUNKS_PER_THREAD{4};
     };
 
 } // cover
@@ -0,0 +1,112 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "worker_pool.h"
+
+namespace cover {
+    Worker_pool::Worker_pool(size_t worker_count) {
+        const size_t thread_count{worker_count > 1 ? worker_count - 1 : 0};
+        threads.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++) {
+            threads.emplace_back([this, i] { work(i + 1); });
+        }
+    }
+
+    Worker_pool::~Worker_pool() {
+        {
+            boost::lock_guard<boost::mutex> lock{mutex};
+            stopping = true;
+        }
+        batch_started.notify_all();
+        for (auto &thread: threads) {
+            thread.join();
+        }
+    }
+
+    size_t Worker_pool::size() const {
+        return threads.size() + 1;
+    }
+
+    void Worker_pool::run(size_t count, const Task &task) {
+        {
+            boost::lock_guard<boost::mutex> lock{mutex};
+            current_task = &task;
+            task_count = count;
+            next_task = 0;
+            finished_threads = 0;
+            failure = nullptr;
+            generation++;
+        }
+        batch_started.notify_all();
+
+        process(task, 0);
+
+        boost::unique_lock<boost::mutex> lock{mutex};
+        // every thread has to acknowledge the batch, otherwise a late one could still access the task afterwards
+        batch_finished.wait(lock, [this] { return finished_threads == threads.size(); });
+        current_task = nullptr;
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    void Worker_pool::work(size_t worker) {
+        size_t seen_generation{0};
+        while (true) {
+            const Task *task;
+            {
+                boost::unique_lock<boost::mutex> lock{mutex};
+                batch_started.wait(lock, [&] { return stopping || generation != seen_generation; });
+                if (stopping) {
+                    return;
+                }
+                seen_generation = generation;
+                task = current_task;
+            }
+
+            process(*task, worker);
+
+            {
+                boost::lock_guard<boost::mutex> lock{mutex};
+                finished_threads++;
+            }
+            batch_finished.notify_one();
+        }
+    }
+
+    void Worker_pool::process(const Task &task, size_t worker) {
+        for (size_t i = next_task++; i < task_count; i = next_task++) {
+            try {
+                task(i, worker);
+            } catch (...) {
+                boost::lock_guard<boost::mutex> lock{mutex};
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next_task = task_count;
+            }
+        }
+    }
+}
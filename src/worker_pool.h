@@ -0,0 +1,102 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2023 Julian Unterweger, Kathrin Hanauer, Martin Seybold
+ *                    Faculty of Computer Science, University of Vienna, Austria
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace cover {
+    /**
+     * @brief A fixed set of worker threads executing batches of independent tasks
+     *
+     * The pool is created once and can then run any number of batches. A batch consists of task_count tasks which are
+     * handed out dynamically, i.e. a worker fetches the next unprocessed task as soon as it finished its previous one,
+     * so callers control the schedule by the order of their task indices. The calling thread participates as worker 0,
+     * so a pool of size 1 runs everything sequentially without spawning any threads.
+     */
+    class Worker_pool {
+    public:
+        /**
+         * Task function, called with the index of the task and the index of the worker executing it. Worker indices
+         * are in [0, size()) and can be used to address per-worker state without any synchronization.
+         */
+        using Task = std::function<void(size_t task, size_t worker)>;
+
+        /**
+         * Constructs a pool with the given number of workers, including the calling thread.
+         *
+         * @param worker_count The number of workers, values smaller than 1 are treated as 1
+         */
+        explicit Worker_pool(size_t worker_count);
+
+        ~Worker_pool();
+
+        Worker_pool(const Worker_pool &) = delete;
+
+        Worker_pool &operator=(const Worker_pool &) = delete;
+
+        /**
+         * @return The number of workers of this pool, including the calling thread
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * Executes task for every index in [0, task_count) and blocks until all of them finished. If a task throws,
+         * no further tasks are started and the first exception is rethrown once the running tasks finished.
+         *
+         * @param task_count The number of tasks in this batch
+         * @param task The function to execute for every task index
+         */
+        void run(size_t task_count, const Task &task);
+
+    private:
+        void work(size_t worker);
+
+        void process(const Task &task, size_t worker);
+
+        std::vector<boost::thread> threads;
+        boost::mutex mutex;
+        boost::condition_variable batch_started;
+        boost::condition_variable batch_finished;
+
+        const Task *current_task{nullptr};
+        size_t task_count{0};
+        std::atomic<size_t> next_task{0};
+        size_t finished_threads{0};
+        size_t generation{0};
+        bool stopping{false};
+        std::exception_ptr failure{nullptr};
+    };
+}
+
+#endif //WORKER_POOL_H